@@ -7,6 +7,7 @@
 
 #include "kernel/graphics/Graphics.h"
 #include "kernel/interrupts/Interupts.h"
+#include "kernel/memory/MemoryObject.h"
 #include "kernel/node/Node.h"
 #include "kernel/scheduling/Scheduler.h"
 
@@ -17,6 +18,9 @@ static int _framebuffer_height = 0;
 static int _framebuffer_pitch = 0;
 static int _framebuffer_bpp = 0;
 
+// Created the first time someone asks to map the framebuffer.
+static MemoryObject *_framebuffer_memory = nullptr;
+
 class Framebuffer : public FsNode
 {
 private:
@@ -65,6 +69,27 @@ public:
 
             return SUCCESS;
         }
+        else if (iocall == IOCALL_DISPLAY_MAP)
+        {
+            IOCallDisplayMapArgs *map = (IOCallDisplayMapArgs *)args;
+
+            InterruptsRetainer retainer;
+
+            if (_framebuffer_memory == nullptr)
+            {
+                _framebuffer_memory = memory_object_create_device((MemoryRange){
+                    _framebuffer_physical,
+                    PAGE_ALIGN_UP((size_t)_framebuffer_height * (size_t)_framebuffer_pitch),
+                });
+            }
+
+            map->handle = _framebuffer_memory->id;
+            map->width = _framebuffer_width;
+            map->height = _framebuffer_height;
+            map->pitch = _framebuffer_pitch;
+
+            return SUCCESS;
+        }
         else
         {
             return ERR_INAPPROPRIATE_CALL_FOR_DEVICE;
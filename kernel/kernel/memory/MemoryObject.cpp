@@ -24,6 +24,23 @@ MemoryObject *memory_object_create(size_t size)
     memory_object->id = _memory_object_id++;
     memory_object->refcount = 1;
     memory_object->_range = physical_alloc(size);
+    memory_object->device = false;
+
+    list_pushback(_memory_objects, memory_object);
+
+    return memory_object;
+}
+
+MemoryObject *memory_object_create_device(MemoryRange physical_range)
+{
+    InterruptsRetainer retainer;
+
+    MemoryObject *memory_object = CREATE(MemoryObject);
+
+    memory_object->id = _memory_object_id++;
+    memory_object->refcount = 1;
+    memory_object->_range = physical_range;
+    memory_object->device = true;
 
     list_pushback(_memory_objects, memory_object);
 
@@ -34,7 +51,11 @@ void memory_object_destroy(MemoryObject *memory_object)
 {
     list_remove(_memory_objects, memory_object);
 
-    physical_free(memory_object->range());
+    if (!memory_object->device)
+    {
+        physical_free(memory_object->range());
+    }
+
     free(memory_object);
 }
 
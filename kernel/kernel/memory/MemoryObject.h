@@ -9,6 +9,10 @@ struct MemoryObject
 
     int refcount;
 
+    // Memory of a device, it didn't come from the physical allocator and
+    // doesn't go back to it.
+    bool device;
+
     auto range() { return _range; }
 };
 
@@ -16,6 +20,8 @@ void memory_object_initialize();
 
 MemoryObject *memory_object_create(size_t size);
 
+MemoryObject *memory_object_create_device(MemoryRange physical_range);
+
 void memory_object_destroy(MemoryObject *memory_object);
 
 MemoryObject *memory_object_ref(MemoryObject *memory_object);
@@ -4,8 +4,6 @@
 #include "kernel/node/Connection.h"
 #include "kernel/node/Handle.h"
 
-#define CONNECTION_BUFFER_SIZE 4096
-
 FsConnection::FsConnection() : FsNode(FILE_TYPE_CONNECTION) {}
 
 void FsConnection::accepted()
@@ -93,3 +91,37 @@ ResultOr<size_t> FsConnection::write(FsHandle &handle, const void *buffer, size_
         }
     }
 }
+
+Result FsConnection::call(FsHandle &handle, IOCall request, void *args)
+{
+    UNUSED(handle);
+
+    auto capacity_args = (IOCallPipeCapacityArgs *)args;
+
+    switch (request)
+    {
+    case IOCALL_PIPE_GET_CAPACITY:
+        capacity_args->capacity = _data_to_server.capacity();
+        return SUCCESS;
+
+    case IOCALL_PIPE_SET_CAPACITY:
+    {
+        // Both directions are resized together, a failure leaves them untouched.
+        auto capacity = capacity_args->capacity;
+
+        if (capacity > PIPE_CAPACITY_MAX ||
+            capacity < _data_to_server.used() ||
+            capacity < _data_to_client.used() ||
+            !_data_to_server.resize(capacity) ||
+            !_data_to_client.resize(capacity))
+        {
+            return ERR_INVALID_ARGUMENT;
+        }
+
+        return SUCCESS;
+    }
+
+    default:
+        return ERR_INAPPROPRIATE_CALL_FOR_DEVICE;
+    }
+}
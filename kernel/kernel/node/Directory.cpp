@@ -11,105 +11,149 @@ FsDirectory::FsDirectory() : FsNode(FILE_TYPE_DIRECTORY)
 
 Result FsDirectory::open(FsHandle &handle)
 {
-    FileListing *listing = (FileListing *)malloc(sizeof(FileListing) + sizeof(DirectoryEntry) * _childs.count());
-
-    listing->count = _childs.count();
-
-    int current_index = 0;
-
-    _childs.foreach ([&](auto &entry) {
-        auto record = &listing->entries[current_index];
-        auto node = entry.node;
-
-        strcpy(record->name, entry.name.cstring());
-
-        record->stat.type = node->type();
-        record->stat.size = node->size();
-
-        current_index++;
-
-        return Iteration::CONTINUE;
-    });
-
-    handle.attached = listing;
+    // The listing is produced incrementally from the live entries, the
+    // handle only remembers the name of the last entry it returned.
+    handle.attached = nullptr;
 
     return SUCCESS;
 }
 
 void FsDirectory::close(FsHandle &handle)
 {
-    free(handle.attached);
+    delete reinterpret_cast<String *>(handle.attached);
+    handle.attached = nullptr;
 }
 
 ResultOr<size_t> FsDirectory::read(FsHandle &handle, void *buffer, size_t size)
 {
-    if (size == sizeof(DirectoryEntry))
-    {
-        size_t index = handle.offset() / sizeof(DirectoryEntry);
+    size_t listed = TRY(list(handle, reinterpret_cast<DirectoryEntry *>(buffer), size / sizeof(DirectoryEntry)));
 
-        FileListing *listing = (FileListing *)handle.attached;
+    return listed * sizeof(DirectoryEntry);
+}
 
-        if (index < listing->count)
-        {
-            *((DirectoryEntry *)buffer) = listing->entries[index];
+ResultOr<size_t> FsDirectory::list(FsHandle &handle, DirectoryEntry *entries, size_t count)
+{
+    auto *cursor = reinterpret_cast<String *>(handle.attached);
 
-            return sizeof(DirectoryEntry);
-        }
-        else
+    size_t index = 0;
+
+    if (handle.offset() == 0)
+    {
+        // The handle was rewound.
+        index = 0;
+    }
+    else if (cursor)
+    {
+        // Resume right after the last returned name, entries linked or
+        // unlinked since then don't shift the position.
+        if (lookup(*cursor, &index))
         {
-            return 0;
+            index++;
         }
     }
     else
     {
-        return 0;
+        // A reopened handle inherits the offset but not the cursor.
+        index = handle.offset() / sizeof(DirectoryEntry);
     }
+
+    size_t listed = 0;
+
+    while (listed < count && index < _childs.count())
+    {
+        auto &child = _childs[index];
+        auto &record = entries[listed];
+
+        strlcpy(record.name, child.name.cstring(), FILE_NAME_LENGTH);
+        record.stat.type = child.node->type();
+        record.stat.size = child.node->size();
+
+        listed++;
+        index++;
+    }
+
+    if (listed > 0)
+    {
+        auto &last = _childs[index - 1].name;
+
+        if (cursor)
+        {
+            *cursor = last;
+        }
+        else
+        {
+            handle.attached = new String(last);
+        }
+    }
+
+    return listed;
 }
 
-RefPtr<FsNode> FsDirectory::find(String name)
+bool FsDirectory::lookup(const String &name, size_t *index)
 {
-    RefPtr<FsNode> result;
+    size_t low = 0;
+    size_t high = _childs.count();
 
-    _childs.foreach ([&](auto &entry) {
-        if (entry.name == name)
-        {
-            result = entry.node;
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        int comparison = strcmp(_childs[middle].name.cstring(), name.cstring());
 
-            return Iteration::STOP;
+        if (comparison == 0)
+        {
+            *index = middle;
+            return true;
         }
+        else if (comparison < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
 
-        return Iteration::CONTINUE;
-    });
+    *index = low;
+    return false;
+}
 
-    return result;
+RefPtr<FsNode> FsDirectory::find(String name)
+{
+    size_t index = 0;
+
+    if (lookup(name, &index))
+    {
+        return _childs[index].node;
+    }
+
+    return nullptr;
 }
 
 Result FsDirectory::link(String name, RefPtr<FsNode> child)
 {
-    if (find(name))
+    size_t index = 0;
+
+    if (lookup(name, &index))
     {
         return ERR_FILE_EXISTS;
     }
 
-    _childs.push_back({name, child});
+    _childs.insert(index, {name, child});
 
     return SUCCESS;
 }
 
 Result FsDirectory::unlink(String name)
 {
+    size_t index = 0;
 
-    bool has_removed_an_entry = _childs.remove_all_match(
-        [&](auto &e) {
-            return e.name == name;
-        });
-
-    if (has_removed_an_entry)
-    {
-        return SUCCESS;
-    }
-    else
+    if (!lookup(name, &index))
     {
         return ERR_NO_SUCH_FILE_OR_DIRECTORY;
     }
+
+    _childs.remove_index(index);
+
+    return SUCCESS;
 }
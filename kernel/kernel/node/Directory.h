@@ -4,12 +4,6 @@
 
 #include "kernel/node/Node.h"
 
-struct FileListing
-{
-    size_t count;
-    DirectoryEntry entries[];
-};
-
 struct FsDirectoryEntry
 {
     String name;
@@ -19,8 +13,11 @@ struct FsDirectoryEntry
 class FsDirectory : public FsNode
 {
 private:
+    // Kept sorted by name so lookups can bisect instead of scanning.
     Vector<FsDirectoryEntry> _childs{};
 
+    bool lookup(const String &name, size_t *index);
+
 public:
     FsDirectory();
 
@@ -30,6 +27,8 @@ public:
 
     ResultOr<size_t> read(FsHandle &handle, void *buffer, size_t size) override;
 
+    ResultOr<size_t> list(FsHandle &handle, DirectoryEntry *entries, size_t count) override;
+
     RefPtr<FsNode> find(String name) override;
 
     Result link(String name, RefPtr<FsNode> child) override;
@@ -2,29 +2,57 @@
 #include <libsystem/Result.h>
 #include <string.h>
 
+#include "archs/Arch.h"
+
+#include "kernel/memory/Memory.h"
 #include "kernel/node/File.h"
 #include "kernel/node/Handle.h"
 
 FsFile::FsFile() : FsNode(FILE_TYPE_REGULAR)
 {
-    _buffer = (char *)malloc(512);
-    _buffer_allocated = 512;
-    _buffer_size = 0;
 }
 
 FsFile::~FsFile()
 {
-    free(_buffer);
+    truncate();
+}
+
+ResultOr<uint8_t *> FsFile::page_or_allocate(size_t index)
+{
+    if (index >= _pages.count())
+    {
+        _pages.resize(index + 1);
+    }
+
+    if (_pages[index] == nullptr)
+    {
+        uintptr_t address = 0;
+        TRY(memory_alloc(arch_kernel_address_space(), ARCH_PAGE_SIZE, MEMORY_CLEAR, &address));
+        _pages[index] = reinterpret_cast<uint8_t *>(address);
+    }
+
+    return _pages[index];
+}
+
+void FsFile::truncate()
+{
+    for (size_t i = 0; i < _pages.count(); i++)
+    {
+        if (_pages[i] != nullptr)
+        {
+            memory_free(arch_kernel_address_space(), MemoryRange{reinterpret_cast<uintptr_t>(_pages[i]), ARCH_PAGE_SIZE});
+        }
+    }
+
+    _pages.clear();
+    _size = 0;
 }
 
 Result FsFile::open(FsHandle &handle)
 {
     if (handle.has_flag(OPEN_TRUNC))
     {
-        free(_buffer);
-        _buffer = (char *)malloc(512);
-        _buffer_allocated = 512;
-        _buffer_size = 0;
+        truncate();
     }
 
     return SUCCESS;
@@ -32,17 +60,39 @@ Result FsFile::open(FsHandle &handle)
 
 size_t FsFile::size()
 {
-    return _buffer_size;
+    return _size;
 }
 
 ResultOr<size_t> FsFile::read(FsHandle &handle, void *buffer, size_t size)
 {
-    size_t read = 0;
+    if (handle.offset() >= _size)
+    {
+        return 0;
+    }
 
-    if (handle.offset() <= _buffer_size)
+    // Below the size of the file, so it fits.
+    size_t offset = handle.offset();
+    size_t read = MIN(_size - offset, size);
+    size_t done = 0;
+
+    while (done < read)
     {
-        read = MIN(_buffer_size - handle.offset(), size);
-        memcpy(buffer, (char *)_buffer + handle.offset(), read);
+        size_t index = (offset + done) / ARCH_PAGE_SIZE;
+        size_t offset_in_page = (offset + done) % ARCH_PAGE_SIZE;
+        size_t chunk = MIN(ARCH_PAGE_SIZE - offset_in_page, read - done);
+
+        uint8_t *destination = reinterpret_cast<uint8_t *>(buffer) + done;
+
+        if (index < _pages.count() && _pages[index] != nullptr)
+        {
+            memcpy(destination, _pages[index] + offset_in_page, chunk);
+        }
+        else
+        {
+            memset(destination, 0, chunk);
+        }
+
+        done += chunk;
     }
 
     return read;
@@ -50,14 +100,41 @@ ResultOr<size_t> FsFile::read(FsHandle &handle, void *buffer, size_t size)
 
 ResultOr<size_t> FsFile::write(FsHandle &handle, const void *buffer, size_t size)
 {
-    if ((handle.offset() + size) > _buffer_allocated)
+    // The content is addressed with a size_t, so the end of the write must
+    // fit in one, the offset alone is 64 bits wide.
+    size64_t end = handle.offset() + size;
+
+    if (end < handle.offset() || (size_t)end != end)
     {
-        _buffer = (char *)realloc(_buffer, handle.offset() + size);
-        _buffer_allocated = handle.offset() + size;
+        return ERR_INVALID_ARGUMENT;
     }
 
-    _buffer_size = MAX(handle.offset() + size, _buffer_size);
-    memcpy((char *)(_buffer) + handle.offset(), buffer, size);
+    size_t offset = handle.offset();
+    size_t done = 0;
+
+    while (done < size)
+    {
+        size_t index = (offset + done) / ARCH_PAGE_SIZE;
+        size_t offset_in_page = (offset + done) % ARCH_PAGE_SIZE;
+        size_t chunk = MIN(ARCH_PAGE_SIZE - offset_in_page, size - done);
+
+        auto page_or_result = page_or_allocate(index);
+
+        if (!page_or_result.success())
+        {
+            if (done == 0)
+            {
+                return page_or_result.result();
+            }
+
+            break;
+        }
+
+        memcpy(page_or_result.unwrap() + offset_in_page, reinterpret_cast<const uint8_t *>(buffer) + done, chunk);
+
+        done += chunk;
+        _size = MAX(offset + done, _size);
+    }
 
-    return size;
+    return done;
 }
@@ -1,13 +1,20 @@
 #pragma once
 
+#include <libutils/Vector.h>
+
 #include "kernel/node/Node.h"
 
 class FsFile : public FsNode
 {
 private:
-    char *_buffer;
-    size_t _buffer_allocated;
-    size_t _buffer_size;
+    // The content of the file is stored in page-sized frames, a null
+    // entry is a hole that reads as zeros and is allocated on write.
+    Vector<uint8_t *> _pages{};
+    size_t _size = 0;
+
+    ResultOr<uint8_t *> page_or_allocate(size_t index);
+
+    void truncate();
 
 public:
     FsFile();
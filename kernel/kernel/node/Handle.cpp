@@ -5,6 +5,9 @@
 #include <libmath/MinMax.h>
 #include <libsystem/Result.h>
 
+#include "archs/Arch.h"
+
+#include "kernel/memory/Memory.h"
 #include "kernel/node/Connection.h"
 #include "kernel/node/Handle.h"
 #include "kernel/scheduling/Blocker.h"
@@ -87,7 +90,19 @@ PollEvent FsHandle::poll(PollEvent events)
     return selected_events;
 }
 
+bool FsHandle::seekable()
+{
+    return _node->type() == FILE_TYPE_REGULAR ||
+           _node->type() == FILE_TYPE_DEVICE;
+}
+
 ResultOr<size_t> FsHandle::read(void *buffer, size_t size)
+{
+    IOVector vector{buffer, size};
+    return readv(&vector, 1);
+}
+
+ResultOr<size_t> FsHandle::readv(const IOVector *vectors, size_t count)
 {
     if (!has_flag(OPEN_READ) &&
         !has_flag(OPEN_SERVER) &&
@@ -100,21 +115,46 @@ ResultOr<size_t> FsHandle::read(void *buffer, size_t size)
 
     TRY(task_block(scheduler_running(), blocker, -1));
 
-    auto read_result = _node->read(*this, buffer, size);
+    size_t read = 0;
 
-    if (!read_result.success())
+    for (size_t i = 0; i < count; i++)
     {
-        _node->release(scheduler_running_id());
-        return read_result;
+        auto read_result = _node->read(*this, vectors[i].buffer, vectors[i].size);
+
+        if (!read_result.success())
+        {
+            _node->release(scheduler_running_id());
+
+            if (read > 0)
+            {
+                return read;
+            }
+
+            return read_result;
+        }
+
+        _offset += read_result.unwrap();
+        read += read_result.unwrap();
+
+        // Don't leave a hole in the caller's buffers.
+        if (read_result.unwrap() < vectors[i].size)
+        {
+            break;
+        }
     }
 
-    _offset += read_result.unwrap();
     _node->release(scheduler_running_id());
 
-    return read_result;
+    return read;
 }
 
 ResultOr<size_t> FsHandle::write(const void *buffer, size_t size)
+{
+    IOVector vector{const_cast<void *>(buffer), size};
+    return writev(&vector, 1);
+}
+
+ResultOr<size_t> FsHandle::writev(const IOVector *vectors, size_t count)
 {
     if (!has_flag(OPEN_WRITE) &&
         !has_flag(OPEN_SERVER) &&
@@ -123,7 +163,12 @@ ResultOr<size_t> FsHandle::write(const void *buffer, size_t size)
         return ERR_READ_ONLY_STREAM;
     }
 
-    auto attempt_a_write = [&](const void *buffer, size_t size) -> ResultOr<size_t> {
+    size_t written = 0;
+    size_t index = 0;
+    size_t written_in_vector = 0;
+
+    while (index < count)
+    {
         BlockerWrite blocker{*this};
 
         TRY(task_block(scheduler_running(), blocker, -1));
@@ -133,33 +178,182 @@ ResultOr<size_t> FsHandle::write(const void *buffer, size_t size)
             _offset = _node->size();
         }
 
-        auto write_result = _node->write(*this, buffer, size);
-
-        if (!write_result.success())
+        // Push as many buffers as the node accepts while holding its lock,
+        // so a record split across buffers isn't interleaved with others.
+        while (index < count)
         {
-            _node->release(scheduler_running_id());
+            auto &vector = vectors[index];
+            auto remaining = vector.size - written_in_vector;
+            auto remaining_buffer = reinterpret_cast<const char *>(vector.buffer) + written_in_vector;
 
-            return write_result;
-        }
+            auto write_result = _node->write(*this, remaining_buffer, remaining);
+
+            if (!write_result.success())
+            {
+                _node->release(scheduler_running_id());
+
+                return write_result;
+            }
+
+            _offset += write_result.unwrap();
+            written += write_result.unwrap();
+            written_in_vector += write_result.unwrap();
 
-        _offset += write_result.unwrap();
+            if (written_in_vector < vector.size)
+            {
+                break;
+            }
+
+            index++;
+            written_in_vector = 0;
+        }
 
         _node->release(scheduler_running_id());
+    }
 
-        return write_result;
-    };
+    return written;
+}
 
-    size_t written = 0;
+ResultOr<size_t> FsHandle::pread(void *buffer, size_t size, ssize64_t offset)
+{
+    if (!seekable())
+    {
+        return ERR_OPERATION_NOT_SUPPORTED;
+    }
 
-    do
+    if (offset < 0)
     {
-        auto remaining = size - written;
-        auto remaining_buffer = reinterpret_cast<const char *>((reinterpret_cast<uintptr_t>(buffer)) + written);
+        return ERR_INVALID_ARGUMENT;
+    }
 
-        written += TRY(attempt_a_write(remaining_buffer, remaining));
-    } while (written < size);
+    // The handle is held by the calling task for the whole syscall, so its
+    // offset can be moved for this transfer and restored without racing.
+    auto original_offset = exchange_and_return_initial_value(_offset, (size64_t)offset);
+    auto read_result = read(buffer, size);
+    _offset = original_offset;
 
-    return written;
+    return read_result;
+}
+
+ResultOr<size_t> FsHandle::pwrite(const void *buffer, size_t size, ssize64_t offset)
+{
+    if (!seekable())
+    {
+        return ERR_OPERATION_NOT_SUPPORTED;
+    }
+
+    if (offset < 0)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    auto original_offset = exchange_and_return_initial_value(_offset, (size64_t)offset);
+    auto write_result = write(buffer, size);
+    _offset = original_offset;
+
+    return write_result;
+}
+
+ResultOr<size_t> FsHandle::list(DirectoryEntry *entries, size_t count)
+{
+    if (!has_flag(OPEN_READ))
+    {
+        return ERR_WRITE_ONLY_STREAM;
+    }
+
+    _node->acquire(scheduler_running_id());
+    auto list_result = _node->list(*this, entries, count);
+
+    if (list_result.success())
+    {
+        _offset += list_result.unwrap() * sizeof(DirectoryEntry);
+    }
+
+    _node->release(scheduler_running_id());
+
+    return list_result;
+}
+
+ResultOr<size_t> FsHandle::splice(FsHandle &destination, size_t size)
+{
+    static constexpr size_t SPLICE_BUFFER_SIZE = 4 * ARCH_PAGE_SIZE;
+
+    // The data goes through a kernel buffer and never touches the caller's
+    // memory, it also lets both nodes be locked one after the other instead
+    // of together.
+    uintptr_t buffer_address = 0;
+    TRY(memory_alloc(arch_kernel_address_space(), SPLICE_BUFFER_SIZE, MEMORY_NONE, &buffer_address));
+    auto buffer = reinterpret_cast<void *>(buffer_address);
+
+    size_t spliced = 0;
+    Result result = SUCCESS;
+
+    while (spliced < size)
+    {
+        size_t chunk = MIN(SPLICE_BUFFER_SIZE, size - spliced);
+
+        auto read_result = read(buffer, chunk);
+
+        if (!read_result.success())
+        {
+            result = read_result.result();
+            break;
+        }
+
+        if (read_result.unwrap() == 0)
+        {
+            break;
+        }
+
+        size_t written = 0;
+
+        while (written < read_result.unwrap())
+        {
+            auto write_result = destination.write(reinterpret_cast<uint8_t *>(buffer) + written, read_result.unwrap() - written);
+
+            if (!write_result.success())
+            {
+                result = write_result.result();
+                break;
+            }
+
+            if (write_result.unwrap() == 0)
+            {
+                break;
+            }
+
+            written += write_result.unwrap();
+        }
+
+        spliced += written;
+
+        if (written < read_result.unwrap())
+        {
+            // What a pipe or a socket gave us is gone, but a file can be
+            // read again from where the destination stopped taking it.
+            if (_node->type() == FILE_TYPE_REGULAR)
+            {
+                _offset -= read_result.unwrap() - written;
+            }
+
+            break;
+        }
+
+        // Like read, return what is available instead of waiting for more.
+        if (read_result.unwrap() < chunk)
+        {
+            break;
+        }
+    }
+
+    memory_free(arch_kernel_address_space(), MemoryRange{buffer_address, SPLICE_BUFFER_SIZE});
+
+    if (spliced == 0 && result != SUCCESS)
+    {
+        return result;
+    }
+
+    return spliced;
 }
 
 ResultOr<ssize64_t> FsHandle::seek(IO::SeekFrom from)
@@ -177,7 +371,7 @@ ResultOr<ssize64_t> FsHandle::seek(IO::SeekFrom from)
     case IO::Whence::CURRENT:
         if (from.position < 0)
         {
-            if ((size_t)-from.position <= _offset)
+            if ((size64_t)-from.position <= _offset)
             {
                 _offset = _offset + from.position;
             }
@@ -195,7 +389,7 @@ ResultOr<ssize64_t> FsHandle::seek(IO::SeekFrom from)
     case IO::Whence::END:
         if (from.position < 0)
         {
-            if ((size_t)-from.position <= size)
+            if ((size64_t)-from.position <= size)
             {
                 _offset = size + from.position;
             }
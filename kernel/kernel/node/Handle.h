@@ -11,7 +11,7 @@ private:
     Lock _lock{"fshandle"};
     RefPtr<FsNode> _node = nullptr;
     OpenFlag _flags = 0;
-    size_t _offset = 0;
+    size64_t _offset = 0;
 
 public:
     void *attached;
@@ -25,6 +25,8 @@ public:
 
     bool has_flag(OpenFlag flag) { return (_flags & flag) == flag; }
 
+    bool seekable();
+
     FsHandle(RefPtr<FsNode> node, OpenFlag flags);
 
     FsHandle(FsHandle &other);
@@ -43,6 +45,18 @@ public:
 
     ResultOr<size_t> write(const void *buffer, size_t size);
 
+    ResultOr<size_t> readv(const IOVector *vectors, size_t count);
+
+    ResultOr<size_t> writev(const IOVector *vectors, size_t count);
+
+    ResultOr<size_t> pread(void *buffer, size_t size, ssize64_t offset);
+
+    ResultOr<size_t> pwrite(const void *buffer, size_t size, ssize64_t offset);
+
+    ResultOr<size_t> list(DirectoryEntry *entries, size_t count);
+
+    ResultOr<size_t> splice(FsHandle &destination, size_t size);
+
     ResultOr<ssize64_t> seek(IO::SeekFrom from);
 
     Result call(IOCall request, void *args);
@@ -81,6 +81,15 @@ public:
         return ERR_NOT_WRITABLE;
     }
 
+    virtual ResultOr<size_t> list(FsHandle &handle, DirectoryEntry *entries, size_t count)
+    {
+        UNUSED(handle);
+        UNUSED(entries);
+        UNUSED(count);
+
+        return ERR_NOT_A_DIRECTORY;
+    }
+
     virtual RefPtr<FsNode> find(String name)
     {
         UNUSED(name);
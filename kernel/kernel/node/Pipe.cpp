@@ -43,3 +43,29 @@ ResultOr<size_t> FsPipe::write(FsHandle &handle, const void *buffer, size_t size
 
     return _buffer.write((const char *)buffer, size);
 }
+
+Result FsPipe::call(FsHandle &handle, IOCall request, void *args)
+{
+    UNUSED(handle);
+
+    auto capacity_args = (IOCallPipeCapacityArgs *)args;
+
+    switch (request)
+    {
+    case IOCALL_PIPE_GET_CAPACITY:
+        capacity_args->capacity = _buffer.capacity();
+        return SUCCESS;
+
+    case IOCALL_PIPE_SET_CAPACITY:
+        if (capacity_args->capacity > PIPE_CAPACITY_MAX ||
+            !_buffer.resize(capacity_args->capacity))
+        {
+            return ERR_INVALID_ARGUMENT;
+        }
+
+        return SUCCESS;
+
+    default:
+        return ERR_INAPPROPRIATE_CALL_FOR_DEVICE;
+    }
+}
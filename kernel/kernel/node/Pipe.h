@@ -21,4 +21,6 @@ public:
     ResultOr<size_t> read(FsHandle &handle, void *buffer, size_t size) override;
 
     ResultOr<size_t> write(FsHandle &handle, const void *buffer, size_t size) override;
+
+    Result call(FsHandle &handle, IOCall request, void *args) override;
 };
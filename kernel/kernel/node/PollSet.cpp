@@ -0,0 +1,136 @@
+#include "kernel/interrupts/Interupts.h"
+#include "kernel/node/PollSet.h"
+
+FsPollSet::FsPollSet() : FsNode(FILE_TYPE_POLLSET)
+{
+}
+
+bool FsPollSet::can_read(FsHandle &)
+{
+    return any_ready();
+}
+
+Result FsPollSet::add(int index, RefPtr<FsHandle> handle, PollEvent events)
+{
+    if (index < 0 || index >= PROCESS_HANDLE_COUNT)
+    {
+        return ERR_BAD_HANDLE;
+    }
+
+    if (_interests[index].handle != nullptr)
+    {
+        // The index was closed and reused without being removed first, keep
+        // the previous handle alive until we are out of the retainer.
+        auto previous = _interests[index].handle;
+
+        InterruptsRetainer retainer;
+        _interests[index].handle = handle;
+        _interests[index].events = events;
+
+        return SUCCESS;
+    }
+
+    _interests[index].handle = handle;
+    _interests[index].events = events;
+
+    // Blocked tasks look at the list from the scheduler.
+    InterruptsRetainer retainer;
+    _registered[_count] = index;
+    _count++;
+
+    return SUCCESS;
+}
+
+Result FsPollSet::modify(int index, PollEvent events)
+{
+    if (index < 0 || index >= PROCESS_HANDLE_COUNT ||
+        _interests[index].handle == nullptr)
+    {
+        return ERR_BAD_HANDLE;
+    }
+
+    _interests[index].events = events;
+
+    return SUCCESS;
+}
+
+Result FsPollSet::remove(int index)
+{
+    if (index < 0 || index >= PROCESS_HANDLE_COUNT ||
+        _interests[index].handle == nullptr)
+    {
+        return ERR_BAD_HANDLE;
+    }
+
+    {
+        InterruptsRetainer retainer;
+
+        for (size_t i = 0; i < _count; i++)
+        {
+            if (_registered[i] == index)
+            {
+                _registered[i] = _registered[_count - 1];
+                _count--;
+                break;
+            }
+        }
+    }
+
+    // Dropped outside of the retainer, closing the handle might take locks.
+    _interests[index].handle = nullptr;
+    _interests[index].events = 0;
+
+    return SUCCESS;
+}
+
+void FsPollSet::forget(int index, FsHandle &handle)
+{
+    if (index < 0 || index >= PROCESS_HANDLE_COUNT ||
+        _interests[index].handle != &handle)
+    {
+        return;
+    }
+
+    remove(index);
+}
+
+bool FsPollSet::any_ready()
+{
+    for (size_t i = 0; i < _count; i++)
+    {
+        auto &interest = _interests[_registered[i]];
+
+        if (interest.handle->poll(interest.events) != 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t FsPollSet::collect(HandlePoll *ready, size_t count)
+{
+    size_t collected = 0;
+
+    for (size_t i = 0; i < _count && collected < count; i++)
+    {
+        int index = _registered[(_cursor + i) % _count];
+        auto &interest = _interests[index];
+
+        PollEvent result = interest.handle->poll(interest.events);
+
+        if (result != 0)
+        {
+            ready[collected] = {index, interest.events, result};
+            collected++;
+        }
+    }
+
+    if (_count > 0)
+    {
+        _cursor = (_cursor + 1) % _count;
+    }
+
+    return collected;
+}
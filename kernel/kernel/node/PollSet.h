@@ -0,0 +1,50 @@
+#pragma once
+
+#include <abi/Process.h>
+
+#include "kernel/node/Handle.h"
+
+struct PollInterest
+{
+    RefPtr<FsHandle> handle;
+    PollEvent events;
+};
+
+// A persistent set of handles to wait on. Interests are registered once and
+// indexed by the handle index of the process that owns the set, a wait only
+// looks at the registered ones and reports those which are ready.
+//
+// Callers hold the node lock, blocked tasks read the set from the scheduler
+// so changes to the registered list are also done with interrupts retained.
+class FsPollSet : public FsNode
+{
+private:
+    PollInterest _interests[PROCESS_HANDLE_COUNT];
+
+    // Compact list of the registered handle indexes.
+    int _registered[PROCESS_HANDLE_COUNT];
+    size_t _count = 0;
+
+    // Where the next collect starts, so a small output buffer doesn't
+    // always get the same handles.
+    size_t _cursor = 0;
+
+public:
+    FsPollSet();
+
+    bool can_read(FsHandle &handle) override;
+
+    Result add(int index, RefPtr<FsHandle> handle, PollEvent events);
+
+    Result modify(int index, PollEvent events);
+
+    Result remove(int index);
+
+    // Drops the interest at `index` if it is still on `handle`, the set must
+    // not keep a closed handle alive or its peer never sees the hang up.
+    void forget(int index, FsHandle &handle);
+
+    bool any_ready();
+
+    size_t collect(HandlePoll *ready, size_t count);
+};
@@ -32,6 +32,13 @@ void BlockerRead::on_unblock(Task &task)
     _handle.node()->acquire(task.id);
 }
 
+/* --- BlockerPollSet ------------------------------------------------------- */
+
+bool BlockerPollSet::can_unblock(Task &)
+{
+    return _pollset.any_ready();
+}
+
 /* --- BlockerSelect -------------------------------------------------------- */
 
 bool BlockerSelect::can_unblock(Task &)
@@ -5,6 +5,7 @@
 #include <libutils/Vector.h>
 
 #include "kernel/node/Handle.h"
+#include "kernel/node/PollSet.h"
 #include "kernel/system/System.h"
 
 struct Task;
@@ -128,6 +129,20 @@ public:
     bool can_unblock(Task &task) override;
 };
 
+class BlockerPollSet : public Blocker
+{
+private:
+    FsPollSet &_pollset;
+
+public:
+    BlockerPollSet(FsPollSet &pollset)
+        : _pollset{pollset}
+    {
+    }
+
+    bool can_unblock(Task &task) override;
+};
+
 class BlockerTime : public Blocker
 {
 public:
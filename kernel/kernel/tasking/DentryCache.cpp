@@ -0,0 +1,71 @@
+#include "kernel/scheduling/Scheduler.h"
+#include "kernel/tasking/DentryCache.h"
+
+RefPtr<FsNode> DentryCache::lookup(const IO::Path &path)
+{
+    auto key = path.string();
+
+    _lock.acquire_for(scheduler_running_id());
+
+    RefPtr<FsNode> result = nullptr;
+
+    if (_entries.has_key(key))
+    {
+        result = _entries[key];
+    }
+
+    _lock.release_for(scheduler_running_id());
+
+    return result;
+}
+
+void DentryCache::insert(const IO::Path &path, RefPtr<FsNode> node, uint32_t generation)
+{
+    auto key = path.string();
+
+    _lock.acquire_for(scheduler_running_id());
+
+    if (generation != _generation)
+    {
+        _lock.release_for(scheduler_running_id());
+        return;
+    }
+
+    if (_count >= CAPACITY)
+    {
+        _entries.clear();
+        _count = 0;
+    }
+
+    if (!_entries.has_key(key))
+    {
+        _count++;
+    }
+
+    _entries[key] = node;
+
+    _lock.release_for(scheduler_running_id());
+}
+
+void DentryCache::invalidate(const IO::Path &path, RefPtr<FsNode> node)
+{
+    auto key = path.string();
+
+    _lock.acquire_for(scheduler_running_id());
+
+    _generation++;
+
+    if (node && node->type() == FILE_TYPE_DIRECTORY)
+    {
+        // Every cached path below this directory is now stale.
+        _entries.clear();
+        _count = 0;
+    }
+    else if (_entries.has_key(key))
+    {
+        _entries.remove_key(key);
+        _count--;
+    }
+
+    _lock.release_for(scheduler_running_id());
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <libio/Path.h>
+#include <libutils/HashMap.h>
+
+#include "kernel/node/Node.h"
+
+// Maps absolute paths to the node they resolved to last time, so path
+// resolution doesn't walk every directory on each open, connect, mkdir...
+// Only successful lookups are cached, so linking a new node never
+// invalidates anything; unlinking or renaming does.
+class DentryCache : public RefCounted<DentryCache>
+{
+private:
+    static constexpr size_t CAPACITY = 1024;
+
+    Lock _lock{"dentry-cache"};
+    HashMap<String, RefPtr<FsNode>> _entries{};
+    size_t _count = 0;
+    uint32_t _generation = 0;
+
+public:
+    // Bumped on every invalidation, a walk that started under an older
+    // generation may have raced with an unlink and must not be cached.
+    uint32_t generation() { return __atomic_load_n(&_generation, __ATOMIC_SEQ_CST); }
+
+    RefPtr<FsNode> lookup(const IO::Path &path);
+
+    void insert(const IO::Path &path, RefPtr<FsNode> node, uint32_t generation);
+
+    void invalidate(const IO::Path &path, RefPtr<FsNode> node);
+};
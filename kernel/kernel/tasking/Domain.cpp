@@ -10,11 +10,13 @@
 Domain::Domain()
 {
     _root = make<FsDirectory>();
+    _cache = make<DentryCache>();
 }
 
 Domain::Domain(const Domain &parent)
 {
     _root = parent._root;
+    _cache = parent._cache;
 }
 
 Domain::~Domain()
@@ -26,12 +28,13 @@ Domain &Domain::operator=(const Domain &other)
     if (this != &other)
     {
         _root = other._root;
+        _cache = other._cache;
     }
 
     return *this;
 }
 
-RefPtr<FsNode> Domain::find(IO::Path path)
+RefPtr<FsNode> Domain::walk(const IO::Path &path)
 {
     auto current = root();
 
@@ -56,6 +59,31 @@ RefPtr<FsNode> Domain::find(IO::Path path)
     return current;
 }
 
+RefPtr<FsNode> Domain::find(IO::Path path)
+{
+    if (path.length() == 0)
+    {
+        return root();
+    }
+
+    auto cached = _cache->lookup(path);
+
+    if (cached)
+    {
+        return cached;
+    }
+
+    auto generation = _cache->generation();
+    auto node = walk(path);
+
+    if (node)
+    {
+        _cache->insert(path, node, generation);
+    }
+
+    return node;
+}
+
 ResultOr<RefPtr<FsHandle>> Domain::open(IO::Path path, OpenFlag flags)
 {
     bool should_create_if_not_present = (flags & OPEN_CREATE) == OPEN_CREATE;
@@ -212,9 +240,15 @@ Result Domain::unlink(IO::Path path)
     }
 
     parent->acquire(scheduler_running_id());
+    auto child = parent->find(path.basename());
     auto result = parent->unlink(path.basename());
     parent->release(scheduler_running_id());
 
+    if (result == SUCCESS)
+    {
+        _cache->invalidate(path, child);
+    }
+
     return result;
 }
 
@@ -267,5 +301,10 @@ Result Domain::rename(IO::Path old_path, IO::Path new_path)
 
     new_parent->release(scheduler_running_id());
 
+    if (result == SUCCESS)
+    {
+        _cache->invalidate(old_path, child);
+    }
+
     return result;
 }
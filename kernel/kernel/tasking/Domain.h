@@ -4,11 +4,15 @@
 
 #include "kernel/node/Handle.h"
 #include "kernel/node/Node.h"
+#include "kernel/tasking/DentryCache.h"
 
 class Domain
 {
 private:
     RefPtr<FsNode> _root;
+    RefPtr<DentryCache> _cache;
+
+    RefPtr<FsNode> walk(const IO::Path &path);
 
 public:
     RefPtr<FsNode> root() { return _root; }
@@ -1,4 +1,5 @@
 
+#include <libmath/MinMax.h>
 #include <libsystem/Logger.h>
 
 #include "kernel/node/Pipe.h"
@@ -85,6 +86,27 @@ Result Handles::release(int handle_index)
     return SUCCESS;
 }
 
+RefPtr<FsPollSet> Handles::acquire_pollset(int handle_index)
+{
+    auto handle = acquire(handle_index);
+
+    if (!handle)
+    {
+        return nullptr;
+    }
+
+    auto node = handle->node();
+
+    release(handle_index);
+
+    if (node->type() != FILE_TYPE_POLLSET)
+    {
+        return nullptr;
+    }
+
+    return node;
+}
+
 ResultOr<int> Handles::open(Domain &domain, IO::Path &path, OpenFlag flags)
 {
     auto handle = TRY(domain.open(path, flags));
@@ -97,8 +119,44 @@ ResultOr<int> Handles::connect(Domain &domain, IO::Path &path)
     return add(handle);
 }
 
+void Handles::forget(int handle_index)
+{
+    RefPtr<FsHandle> handle;
+    RefPtr<FsPollSet> pollsets[PROCESS_HANDLE_COUNT];
+    size_t pollsets_count = 0;
+
+    {
+        LockHolder holder(_lock);
+
+        if (!is_valid_handle(handle_index))
+        {
+            return;
+        }
+
+        handle = _handles[handle_index];
+
+        for (int i = 0; i < PROCESS_HANDLE_COUNT; i++)
+        {
+            if (_handles[i] != nullptr && _handles[i]->node()->type() == FILE_TYPE_POLLSET)
+            {
+                pollsets[pollsets_count] = RefPtr<FsPollSet>{_handles[i]->node()};
+                pollsets_count++;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < pollsets_count; i++)
+    {
+        pollsets[i]->acquire(scheduler_running_id());
+        pollsets[i]->forget(handle_index, *handle);
+        pollsets[i]->release(scheduler_running_id());
+    }
+}
+
 Result Handles::close(int handle_index)
 {
+    forget(handle_index);
+
     return remove(handle_index);
 }
 
@@ -139,6 +197,8 @@ Result Handles::copy(int source, int destination)
 
     auto copy_handle = make<FsHandle>(*source_handle);
 
+    forget(destination);
+
     return add_at(copy_handle, destination);
 }
 
@@ -220,6 +280,133 @@ ResultOr<size_t> Handles::write(int handle_index, const void *buffer, size_t siz
     return result_or_written;
 }
 
+ResultOr<size_t> Handles::readv(int handle_index, const IOVector *vectors, size_t count)
+{
+    auto handle = acquire(handle_index);
+
+    if (!handle)
+    {
+        return ERR_BAD_HANDLE;
+    }
+
+    auto result_or_read = handle->readv(vectors, count);
+
+    release(handle_index);
+
+    return result_or_read;
+}
+
+ResultOr<size_t> Handles::writev(int handle_index, const IOVector *vectors, size_t count)
+{
+    auto handle = acquire(handle_index);
+
+    if (!handle)
+    {
+        return ERR_BAD_HANDLE;
+    }
+
+    auto result_or_written = handle->writev(vectors, count);
+
+    release(handle_index);
+
+    return result_or_written;
+}
+
+ResultOr<size_t> Handles::pread(int handle_index, void *buffer, size_t size, ssize64_t offset)
+{
+    auto handle = acquire(handle_index);
+
+    if (!handle)
+    {
+        return ERR_BAD_HANDLE;
+    }
+
+    auto result_or_read = handle->pread(buffer, size, offset);
+
+    release(handle_index);
+
+    return result_or_read;
+}
+
+ResultOr<size_t> Handles::pwrite(int handle_index, const void *buffer, size_t size, ssize64_t offset)
+{
+    auto handle = acquire(handle_index);
+
+    if (!handle)
+    {
+        return ERR_BAD_HANDLE;
+    }
+
+    auto result_or_written = handle->pwrite(buffer, size, offset);
+
+    release(handle_index);
+
+    return result_or_written;
+}
+
+ResultOr<size_t> Handles::list(int handle_index, DirectoryEntry *entries, size_t count)
+{
+    auto handle = acquire(handle_index);
+
+    if (!handle)
+    {
+        return ERR_BAD_HANDLE;
+    }
+
+    auto result_or_listed = handle->list(entries, count);
+
+    release(handle_index);
+
+    return result_or_listed;
+}
+
+ResultOr<size_t> Handles::splice(int source_index, int destination_index, size_t size)
+{
+    {
+        LockHolder holder(_lock);
+
+        if (!is_valid_handle(source_index) || !is_valid_handle(destination_index))
+        {
+            return ERR_BAD_HANDLE;
+        }
+
+        if (_handles[source_index] == _handles[destination_index])
+        {
+            return ERR_INVALID_ARGUMENT;
+        }
+    }
+
+    // Always take the handles in the same order, so two tasks splicing
+    // between the same pair in opposite directions can't deadlock.
+    int first_index = MIN(source_index, destination_index);
+    int second_index = MAX(source_index, destination_index);
+
+    auto first = acquire(first_index);
+
+    if (!first)
+    {
+        return ERR_BAD_HANDLE;
+    }
+
+    auto second = acquire(second_index);
+
+    if (!second)
+    {
+        release(first_index);
+        return ERR_BAD_HANDLE;
+    }
+
+    auto source = source_index == first_index ? first : second;
+    auto destination = source_index == first_index ? second : first;
+
+    auto result_or_spliced = source->splice(*destination, size);
+
+    release(second_index);
+    release(first_index);
+
+    return result_or_spliced;
+}
+
 ResultOr<ssize64_t> Handles::seek(int handle_index, IO::SeekFrom from)
 {
     auto handle = acquire(handle_index);
@@ -368,6 +555,93 @@ Result Handles::pipe(int *reader, int *writer)
         OPEN_WRITE);
 }
 
+ResultOr<int> Handles::pollset()
+{
+    return add(make<FsHandle>(make<FsPollSet>(), OPEN_READ));
+}
+
+Result Handles::pollset_control(int pollset_index, PollSetControl control, int handle_index, PollEvent events)
+{
+    auto pollset = acquire_pollset(pollset_index);
+
+    if (!pollset)
+    {
+        return ERR_BAD_HANDLE;
+    }
+
+    RefPtr<FsHandle> handle = nullptr;
+
+    if (control == POLLSET_ADD)
+    {
+        handle = acquire(handle_index);
+
+        if (!handle)
+        {
+            return ERR_BAD_HANDLE;
+        }
+
+        release(handle_index);
+
+        // A set holding a reference to another one could form a cycle.
+        if (handle->node()->type() == FILE_TYPE_POLLSET)
+        {
+            return ERR_INVALID_ARGUMENT;
+        }
+    }
+
+    pollset->acquire(scheduler_running_id());
+
+    Result result = ERR_INVALID_ARGUMENT;
+
+    if (control == POLLSET_ADD)
+    {
+        result = pollset->add(handle_index, handle, events);
+    }
+    else if (control == POLLSET_MODIFY)
+    {
+        result = pollset->modify(handle_index, events);
+    }
+    else if (control == POLLSET_REMOVE)
+    {
+        result = pollset->remove(handle_index);
+    }
+
+    pollset->release(scheduler_running_id());
+
+    return result;
+}
+
+ResultOr<size_t> Handles::pollset_wait(int pollset_index, HandlePoll *ready, size_t count, Timeout timeout)
+{
+    auto pollset = acquire_pollset(pollset_index);
+
+    if (!pollset)
+    {
+        return ERR_BAD_HANDLE;
+    }
+
+    {
+        BlockerPollSet blocker{*pollset};
+        Result block_result = task_block(scheduler_running(), blocker, timeout);
+
+        if (block_result == TIMEOUT)
+        {
+            return 0;
+        }
+
+        if (block_result != SUCCESS)
+        {
+            return block_result;
+        }
+    }
+
+    pollset->acquire(scheduler_running_id());
+    size_t collected = pollset->collect(ready, count);
+    pollset->release(scheduler_running_id());
+
+    return collected;
+}
+
 Result Handles::pass(Handles &handles, int source, int destination)
 {
     {
@@ -3,6 +3,7 @@
 #include <libio/Path.h>
 
 #include "kernel/node/Handle.h"
+#include "kernel/node/PollSet.h"
 
 class Handles
 {
@@ -19,8 +20,13 @@ private:
 
     Result remove(int handle_index);
 
+    // Takes the handle out of the poll sets of this process before it goes away.
+    void forget(int handle_index);
+
     RefPtr<FsHandle> acquire(int handle_index);
 
+    RefPtr<FsPollSet> acquire_pollset(int handle_index);
+
     Result release(int handle_index);
 
 public:
@@ -46,6 +52,18 @@ public:
 
     ResultOr<size_t> write(int handle_index, const void *buffer, size_t size);
 
+    ResultOr<size_t> readv(int handle_index, const IOVector *vectors, size_t count);
+
+    ResultOr<size_t> writev(int handle_index, const IOVector *vectors, size_t count);
+
+    ResultOr<size_t> pread(int handle_index, void *buffer, size_t size, ssize64_t offset);
+
+    ResultOr<size_t> pwrite(int handle_index, const void *buffer, size_t size, ssize64_t offset);
+
+    ResultOr<size_t> list(int handle_index, DirectoryEntry *entries, size_t count);
+
+    ResultOr<size_t> splice(int source_index, int destination_index, size_t size);
+
     ResultOr<ssize64_t> seek(int handle_index, IO::SeekFrom from);
 
     Result call(int handle_index, IOCall request, void *args);
@@ -63,5 +81,11 @@ public:
 
     Result pipe(int *reader, int *writer);
 
+    ResultOr<int> pollset();
+
+    Result pollset_control(int pollset_index, PollSetControl control, int handle_index, PollEvent events);
+
+    ResultOr<size_t> pollset_wait(int pollset_index, HandlePoll *ready, size_t count, Timeout timeout);
+
     Result pass(Handles &handles, int source, int destination);
 };
@@ -410,6 +410,63 @@ Result hj_create_term(int *server_handle, int *client_handle)
     return handles.term(server_handle, client_handle);
 }
 
+Result hj_create_pollset(int *handle)
+{
+    if (!syscall_validate_ptr((uintptr_t)handle, sizeof(int)))
+    {
+        return ERR_BAD_ADDRESS;
+    }
+
+    auto &handles = scheduler_running()->handles();
+
+    auto result_or_handle = handles.pollset();
+
+    if (!result_or_handle.success())
+    {
+        return result_or_handle.result();
+    }
+
+    *handle = result_or_handle.unwrap();
+
+    return SUCCESS;
+}
+
+Result hj_pollset_control(int pollset, PollSetControl control, int handle, PollEvent events)
+{
+    auto &handles = scheduler_running()->handles();
+
+    return handles.pollset_control(pollset, control, handle, events);
+}
+
+Result hj_pollset_wait(int pollset, HandlePoll *ready, size_t count, size_t *ready_count, Timeout timeout)
+{
+    if (count > PROCESS_HANDLE_COUNT)
+    {
+        count = PROCESS_HANDLE_COUNT;
+    }
+
+    if (!syscall_validate_ptr((uintptr_t)ready, sizeof(HandlePoll) * count) ||
+        !syscall_validate_ptr((uintptr_t)ready_count, sizeof(size_t)))
+    {
+        return ERR_BAD_ADDRESS;
+    }
+
+    auto &handles = scheduler_running()->handles();
+
+    auto result_or_ready = handles.pollset_wait(pollset, ready, count, timeout);
+
+    if (result_or_ready.success())
+    {
+        *ready_count = result_or_ready.unwrap();
+        return SUCCESS;
+    }
+    else
+    {
+        *ready_count = 0;
+        return result_or_ready.result();
+    }
+}
+
 /* --- Handles -------------------------------------------------------------- */
 
 Result hj_handle_open(int *handle,
@@ -519,6 +576,191 @@ Result hj_handle_read(int handle, void *buffer, size_t size, size_t *read)
     }
 }
 
+static bool copy_io_vectors(const IOVector *vectors, size_t count, IOVector *copy)
+{
+    if (count > IOVECTOR_MAX ||
+        !syscall_validate_ptr((uintptr_t)vectors, sizeof(IOVector) * count))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        copy[i] = vectors[i];
+
+        if (!syscall_validate_ptr((uintptr_t)copy[i].buffer, copy[i].size))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Result hj_handle_readv(int handle, const IOVector *vectors, size_t count, size_t *read)
+{
+    IOVector vectors_copy[IOVECTOR_MAX];
+
+    if (!copy_io_vectors(vectors, count, vectors_copy) ||
+        !syscall_validate_ptr((uintptr_t)read, sizeof(size_t)))
+    {
+        return ERR_BAD_ADDRESS;
+    }
+
+    auto &handles = scheduler_running()->handles();
+
+    auto result_or_read = handles.readv(handle, vectors_copy, count);
+
+    if (result_or_read.success())
+    {
+        *read = result_or_read.unwrap();
+        return SUCCESS;
+    }
+    else
+    {
+        *read = 0;
+        return result_or_read.result();
+    }
+}
+
+Result hj_handle_writev(int handle, const IOVector *vectors, size_t count, size_t *written)
+{
+    IOVector vectors_copy[IOVECTOR_MAX];
+
+    if (!copy_io_vectors(vectors, count, vectors_copy) ||
+        !syscall_validate_ptr((uintptr_t)written, sizeof(size_t)))
+    {
+        return ERR_BAD_ADDRESS;
+    }
+
+    auto &handles = scheduler_running()->handles();
+
+    auto result_or_written = handles.writev(handle, vectors_copy, count);
+
+    if (result_or_written.success())
+    {
+        *written = result_or_written.unwrap();
+        return SUCCESS;
+    }
+    else
+    {
+        *written = 0;
+        return result_or_written.result();
+    }
+}
+
+Result hj_handle_pread(int handle, void *buffer, size_t size, ssize64_t *offset, size_t *read)
+{
+    if (!syscall_validate_ptr((uintptr_t)buffer, size) ||
+        !syscall_validate_ptr((uintptr_t)offset, sizeof(ssize64_t)) ||
+        !syscall_validate_ptr((uintptr_t)read, sizeof(size_t)))
+    {
+        return ERR_BAD_ADDRESS;
+    }
+
+    if (*offset < 0)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    auto &handles = scheduler_running()->handles();
+
+    auto result_or_read = handles.pread(handle, buffer, size, *offset);
+
+    if (result_or_read.success())
+    {
+        *read = result_or_read.unwrap();
+        return SUCCESS;
+    }
+    else
+    {
+        *read = 0;
+        return result_or_read.result();
+    }
+}
+
+Result hj_handle_pwrite(int handle, const void *buffer, size_t size, ssize64_t *offset, size_t *written)
+{
+    if (!syscall_validate_ptr((uintptr_t)buffer, size) ||
+        !syscall_validate_ptr((uintptr_t)offset, sizeof(ssize64_t)) ||
+        !syscall_validate_ptr((uintptr_t)written, sizeof(size_t)))
+    {
+        return ERR_BAD_ADDRESS;
+    }
+
+    if (*offset < 0)
+    {
+        return ERR_INVALID_ARGUMENT;
+    }
+
+    auto &handles = scheduler_running()->handles();
+
+    auto result_or_written = handles.pwrite(handle, buffer, size, *offset);
+
+    if (result_or_written.success())
+    {
+        *written = result_or_written.unwrap();
+        return SUCCESS;
+    }
+    else
+    {
+        *written = 0;
+        return result_or_written.result();
+    }
+}
+
+Result hj_handle_list(int handle, DirectoryEntry *entries, size_t count, size_t *listed)
+{
+    if (count > DIRECTORY_LIST_MAX)
+    {
+        count = DIRECTORY_LIST_MAX;
+    }
+
+    if (!syscall_validate_ptr((uintptr_t)entries, sizeof(DirectoryEntry) * count) ||
+        !syscall_validate_ptr((uintptr_t)listed, sizeof(size_t)))
+    {
+        return ERR_BAD_ADDRESS;
+    }
+
+    auto &handles = scheduler_running()->handles();
+
+    auto result_or_listed = handles.list(handle, entries, count);
+
+    if (result_or_listed.success())
+    {
+        *listed = result_or_listed.unwrap();
+        return SUCCESS;
+    }
+    else
+    {
+        *listed = 0;
+        return result_or_listed.result();
+    }
+}
+
+Result hj_handle_splice(int source, int destination, size_t size, size_t *spliced)
+{
+    if (!syscall_validate_ptr((uintptr_t)spliced, sizeof(size_t)))
+    {
+        return ERR_BAD_ADDRESS;
+    }
+
+    auto &handles = scheduler_running()->handles();
+
+    auto result_or_spliced = handles.splice(source, destination, size);
+
+    if (result_or_spliced.success())
+    {
+        *spliced = result_or_spliced.unwrap();
+        return SUCCESS;
+    }
+    else
+    {
+        *spliced = 0;
+        return result_or_spliced.result();
+    }
+}
+
 Result hj_handle_write(int handle, const void *buffer, size_t size, size_t *written)
 {
     if (!syscall_validate_ptr((uintptr_t)buffer, size) ||
@@ -678,6 +920,15 @@ static SyscallHandler syscalls[__SYSCALL_COUNT] = {
     [HJ_HANDLE_ACCEPT] = reinterpret_cast<SyscallHandler>(hj_handle_accept),
     [HJ_CREATE_PIPE] = reinterpret_cast<SyscallHandler>(hj_create_pipe),
     [HJ_CREATE_TERM] = reinterpret_cast<SyscallHandler>(hj_create_term),
+    [HJ_HANDLE_LIST] = reinterpret_cast<SyscallHandler>(hj_handle_list),
+    [HJ_HANDLE_READV] = reinterpret_cast<SyscallHandler>(hj_handle_readv),
+    [HJ_HANDLE_WRITEV] = reinterpret_cast<SyscallHandler>(hj_handle_writev),
+    [HJ_HANDLE_PREAD] = reinterpret_cast<SyscallHandler>(hj_handle_pread),
+    [HJ_HANDLE_PWRITE] = reinterpret_cast<SyscallHandler>(hj_handle_pwrite),
+    [HJ_HANDLE_SPLICE] = reinterpret_cast<SyscallHandler>(hj_handle_splice),
+    [HJ_CREATE_POLLSET] = reinterpret_cast<SyscallHandler>(hj_create_pollset),
+    [HJ_POLLSET_CONTROL] = reinterpret_cast<SyscallHandler>(hj_pollset_control),
+    [HJ_POLLSET_WAIT] = reinterpret_cast<SyscallHandler>(hj_pollset_wait),
 };
 
 #pragma GCC diagnostic pop
@@ -123,6 +123,28 @@ Result BGA::call(IOCall request, void *args)
 
         return SUCCESS;
     }
+    else if (request == IOCALL_DISPLAY_MAP)
+    {
+        IOCallDisplayMapArgs *map = (IOCallDisplayMapArgs *)args;
+
+        InterruptsRetainer retainer;
+
+        // The whole video memory, so it stays valid across mode changes.
+        if (_framebuffer_memory == nullptr)
+        {
+            _framebuffer_memory = memory_object_create_device((MemoryRange){
+                _framebuffer->physical_base(),
+                PAGE_ALIGN_UP(_framebuffer->size()),
+            });
+        }
+
+        map->handle = _framebuffer_memory->id;
+        map->width = _width;
+        map->height = _height;
+        map->pitch = _width * sizeof(uint32_t);
+
+        return SUCCESS;
+    }
     else
     {
         return ERR_INAPPROPRIATE_CALL_FOR_DEVICE;
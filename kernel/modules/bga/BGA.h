@@ -1,6 +1,7 @@
 #pragma once
 
 #include "kernel/memory/MMIO.h"
+#include "kernel/memory/MemoryObject.h"
 #include "pci/PCIDevice.h"
 
 #define BGA_ADDRESS 0x01CE
@@ -22,6 +23,7 @@ private:
     int _height;
 
     RefPtr<MMIORange> _framebuffer;
+    MemoryObject *_framebuffer_memory = nullptr;
 
     void write_register(uint16_t address, uint16_t data);
     uint16_t read_register(uint16_t address);
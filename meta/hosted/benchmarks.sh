@@ -0,0 +1,41 @@
+#!/bin/bash
+g++ \
+    -O2 \
+    -g \
+    -std=c++20 \
+    -Imeta/hosted/includes \
+    -Iuserspace/libraries \
+    -Iuserspace/apps \
+    -Iuserspace \
+    -Iuserspace/hosted/includes \
+    -idirafter userspace/libraries/libc \
+    -D__CONFIG_IS_RELEASE__=0 \
+    -D__CONFIG_IS_HOSTED__=1 \
+    -DDISABLE_LOGGER \
+    userspace/benchmarks/main.cpp \
+    userspace/benchmarks/Driver.cpp \
+    userspace/benchmarks/libasync/*.cpp \
+    userspace/benchmarks/libgraphic/*.cpp \
+    userspace/libraries/libasync/*.cpp \
+    userspace/libraries/libgraphic/Bitmap.cpp \
+    userspace/libraries/libgraphic/Color.cpp \
+    userspace/libraries/libgraphic/EffectCache.cpp \
+    userspace/libraries/libgraphic/Font.cpp \
+    userspace/libraries/libgraphic/Icon.cpp \
+    userspace/libraries/libgraphic/Painter.cpp \
+    userspace/libraries/libgraphic/Spans.cpp \
+    userspace/libraries/libgraphic/StackBlur.cpp \
+    userspace/libraries/libgraphic/png/*.cpp \
+    userspace/libraries/libgraphic/rast/*.cpp \
+    userspace/libraries/libgraphic/svg/*.cpp \
+    userspace/libraries/libcompression/*.cpp \
+    userspace/libraries/libxml/*.cpp \
+    userspace/libraries/libsystem/system/System.cpp \
+    userspace/libraries/libsystem/plugs/__plug_memory.cpp \
+    userspace/libraries/libsystem/plugs/__plug_system.cpp \
+    userspace/libraries/libio/Directory.cpp \
+    userspace/libraries/libio/File.cpp \
+    userspace/libraries/libio/Format.cpp \
+    userspace/libraries/libio/Streams.cpp \
+    meta/hosted/plugs/*.cpp \
+    -o benchmarks.out
@@ -2,11 +2,19 @@
 #include <libio/Streams.h>
 #include <libmath/MinMax.h>
 
+#include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/epoll.h>
+#include <sys/sendfile.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
+#include <sys/uio.h>
+#include <time.h>
 #include <unistd.h>
 
 int open_flags_to_posix(OpenFlag flags)
@@ -130,6 +138,40 @@ Result errno_to_skift_result()
     return result;
 }
 
+// Nothing is shared with other processes when hosted, memory objects are
+// plain allocations.
+Result hj_memory_alloc(size_t size, uintptr_t *out_address)
+{
+    *out_address = reinterpret_cast<uintptr_t>(calloc(1, size));
+
+    return *out_address ? SUCCESS : ERR_OUT_OF_MEMORY;
+}
+
+Result hj_memory_free(uintptr_t address)
+{
+    free(reinterpret_cast<void *>(address));
+
+    return SUCCESS;
+}
+
+Result hj_memory_include(int handle, uintptr_t *out_address, size_t *out_size)
+{
+    UNUSED(handle);
+    UNUSED(out_address);
+    UNUSED(out_size);
+
+    return ERR_NOT_IMPLEMENTED;
+}
+
+Result hj_memory_get_handle(uintptr_t address, int *out_handle)
+{
+    UNUSED(address);
+
+    *out_handle = -1;
+
+    return ERR_NOT_IMPLEMENTED;
+}
+
 Result hj_handle_open(int *handle, const char *raw_path, size_t size, OpenFlag flags)
 {
     char buffer[256];
@@ -160,6 +202,56 @@ Result hj_handle_write(int handle, const void *buffer, size_t size, size_t *amou
     return errno_to_skift_result();
 }
 
+Result hj_handle_readv(int handle, const IOVector *vectors, size_t count, size_t *amount_read)
+{
+    struct iovec posix_vectors[IOVECTOR_MAX];
+
+    for (size_t i = 0; i < MIN(count, IOVECTOR_MAX); i++)
+    {
+        posix_vectors[i] = {vectors[i].buffer, vectors[i].size};
+    }
+
+    *amount_read = readv(handle, posix_vectors, MIN(count, IOVECTOR_MAX));
+
+    return errno_to_skift_result();
+}
+
+Result hj_handle_writev(int handle, const IOVector *vectors, size_t count, size_t *amount_written)
+{
+    struct iovec posix_vectors[IOVECTOR_MAX];
+
+    for (size_t i = 0; i < MIN(count, IOVECTOR_MAX); i++)
+    {
+        posix_vectors[i] = {vectors[i].buffer, vectors[i].size};
+    }
+
+    *amount_written = writev(handle, posix_vectors, MIN(count, IOVECTOR_MAX));
+
+    return errno_to_skift_result();
+}
+
+Result hj_handle_pread(int handle, void *buffer, size_t size, ssize64_t *offset, size_t *amount_read)
+{
+    *amount_read = pread(handle, buffer, size, *offset);
+
+    return errno_to_skift_result();
+}
+
+Result hj_handle_pwrite(int handle, const void *buffer, size_t size, ssize64_t *offset, size_t *amount_written)
+{
+    *amount_written = pwrite(handle, buffer, size, *offset);
+
+    return errno_to_skift_result();
+}
+
+Result hj_handle_splice(int source, int destination, size_t size, size_t *spliced)
+{
+    ssize_t result = sendfile(destination, source, nullptr, size);
+    *spliced = result < 0 ? 0 : result;
+
+    return errno_to_skift_result();
+}
+
 Result hj_handle_seek(int handle, ssize64_t *offset, HjWhence whence, ssize64_t *result)
 {
     *result = lseek(handle, *offset, whence_to_posix(whence));
@@ -177,6 +269,53 @@ Result hj_handle_stat(int handle, FileState *state)
     return errno_to_skift_result();
 }
 
+Result hj_handle_list(int handle, DirectoryEntry *entries, size_t count, size_t *listed)
+{
+    *listed = 0;
+
+    char buffer[1024];
+
+    while (*listed < count)
+    {
+        long size = syscall(SYS_getdents64, handle, buffer, sizeof(buffer));
+
+        if (size <= 0)
+        {
+            break;
+        }
+
+        long offset = 0;
+        off_t next = 0;
+
+        while (offset < size && *listed < count)
+        {
+            auto *entry = reinterpret_cast<struct dirent64 *>(buffer + offset);
+            offset += entry->d_reclen;
+            next = entry->d_off;
+
+            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+            {
+                continue;
+            }
+
+            struct stat sb;
+            fstatat(handle, entry->d_name, &sb, 0);
+
+            strlcpy(entries[*listed].name, entry->d_name, FILE_NAME_LENGTH);
+            entries[*listed].stat = stat_to_skift(sb);
+            (*listed)++;
+        }
+
+        // The next call picks up the entries that didn't fit.
+        if (offset < size)
+        {
+            lseek(handle, next, SEEK_SET);
+        }
+    }
+
+    return errno_to_skift_result();
+}
+
 Result hj_handle_call(int handle, IOCall call, void *args)
 {
     UNUSED(handle);
@@ -184,4 +323,131 @@ Result hj_handle_call(int handle, IOCall call, void *args)
     UNUSED(args);
 
     return ERR_NOT_IMPLEMENTED;
-}
\ No newline at end of file
+}
+
+Result hj_system_tick(uint32_t *tick)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    *tick = now.tv_sec * 1000 + now.tv_nsec / 1000000;
+
+    return SUCCESS;
+}
+
+Result hj_create_pipe(int *reader_handle, int *writer_handle)
+{
+    int handles[2];
+    pipe(handles);
+
+    *reader_handle = handles[0];
+    *writer_handle = handles[1];
+
+    return errno_to_skift_result();
+}
+
+static uint32_t poll_events_to_epoll(PollEvent events)
+{
+    uint32_t result = 0;
+
+    if (events & (POLL_READ | POLL_ACCEPT))
+    {
+        result |= EPOLLIN;
+    }
+
+    if (events & (POLL_WRITE | POLL_CONNECT))
+    {
+        result |= EPOLLOUT;
+    }
+
+    return result;
+}
+
+static PollEvent epoll_to_poll_events(uint32_t events, PollEvent interests)
+{
+    PollEvent result = 0;
+
+    if (events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+    {
+        result |= interests & (POLL_READ | POLL_ACCEPT);
+    }
+
+    if (events & (EPOLLOUT | EPOLLERR))
+    {
+        result |= interests & (POLL_WRITE | POLL_CONNECT);
+    }
+
+    return result;
+}
+
+Result hj_handle_poll(HandlePoll *handles, size_t count, Timeout timeout)
+{
+    struct pollfd fds[PROCESS_HANDLE_COUNT];
+    count = MIN(count, PROCESS_HANDLE_COUNT);
+
+    // poll() and epoll share the values of their events on linux.
+    for (size_t i = 0; i < count; i++)
+    {
+        fds[i] = {handles[i].handle, (short)poll_events_to_epoll(handles[i].events), 0};
+    }
+
+    int result = poll(fds, count, timeout == UINT32_MAX ? -1 : (int)timeout);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        handles[i].result = result > 0 ? epoll_to_poll_events(fds[i].revents, handles[i].events) : 0;
+    }
+
+    return errno_to_skift_result();
+}
+
+Result hj_create_pollset(int *handle)
+{
+    *handle = epoll_create1(0);
+
+    return errno_to_skift_result();
+}
+
+Result hj_pollset_control(int pollset, PollSetControl control, int handle, PollEvent events)
+{
+    struct epoll_event event = {};
+    event.events = poll_events_to_epoll(events);
+
+    // Keep the interests around so the wait can report them back.
+    event.data.u64 = ((uint64_t)events << 32) | (uint32_t)handle;
+
+    if (control == POLLSET_ADD)
+    {
+        epoll_ctl(pollset, EPOLL_CTL_ADD, handle, &event);
+    }
+    else if (control == POLLSET_MODIFY)
+    {
+        epoll_ctl(pollset, EPOLL_CTL_MOD, handle, &event);
+    }
+    else
+    {
+        epoll_ctl(pollset, EPOLL_CTL_DEL, handle, &event);
+    }
+
+    return errno_to_skift_result();
+}
+
+Result hj_pollset_wait(int pollset, HandlePoll *ready, size_t count, size_t *ready_count, Timeout timeout)
+{
+    struct epoll_event events[PROCESS_HANDLE_COUNT];
+
+    int result = epoll_wait(pollset, events, MIN(count, PROCESS_HANDLE_COUNT), timeout == UINT32_MAX ? -1 : (int)timeout);
+
+    *ready_count = 0;
+
+    for (int i = 0; i < result; i++)
+    {
+        int handle = events[i].data.u64 & 0xffffffff;
+        PollEvent interests = events[i].data.u64 >> 32;
+
+        ready[i] = {handle, interests, epoll_to_poll_events(events[i].events, interests)};
+        *ready_count = i + 1;
+    }
+
+    return errno_to_skift_result();
+}
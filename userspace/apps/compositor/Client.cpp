@@ -1,4 +1,5 @@
 #include <libio/Streams.h>
+#include <libmath/MinMax.h>
 #include <libsystem/system/Memory.h>
 #include <libsystem/utils/Hexdump.h>
 #include <libutils/Assert.h>
@@ -20,7 +21,7 @@ void Client::handle(const CompositorCreateWindow &create_window)
         return;
     }
 
-    auto frontbuffer = Graphic::Bitmap::create_shared_from_handle(create_window.frontbuffer, create_window.backbuffer_size);
+    auto frontbuffer = Graphic::Bitmap::create_shared_from_handle(create_window.frontbuffer, create_window.frontbuffer_size);
 
     if (!frontbuffer.success())
     {
@@ -81,11 +82,12 @@ void Client::handle(const CompositorFlipWindow &flip_window)
     }
 
     window->resize(flip_window.bound);
-    window->flip_buffers(flip_window.frontbuffer, flip_window.frontbuffer_size, flip_window.backbuffer, flip_window.backbuffer_size, flip_window.dirty);
-
-    CompositorMessage message = {};
-    message.type = COMPOSITOR_MESSAGE_ACK;
-    send_message(message);
+    window->flip_buffers(
+        flip_window.frame,
+        flip_window.frontbuffer,
+        flip_window.frontbuffer_size,
+        flip_window.dirty,
+        MIN(flip_window.dirty_count, WINDOW_DIRTY_MAX));
 }
 
 void Client::handle(const CompositorCursorWindow &cursor_window)
@@ -98,11 +100,7 @@ void Client::handle(const CompositorCursorWindow &cursor_window)
         return;
     }
 
-    renderer_region_dirty(cursor_dirty_bound());
-
     window->cursor_state(cursor_window.state);
-
-    renderer_region_dirty(cursor_dirty_bound());
 }
 
 void Client::handle(const CompositorSetResolution &set_resolution)
@@ -141,23 +139,11 @@ void Client::handle_request()
     Assert::is_false(_disconnected);
 
     CompositorMessage message = {};
-    auto read_result = _connection.read(&message, sizeof(CompositorMessage));
+    auto read_result = CompositorSchema::read(_channel, message);
 
-    if (!read_result.success())
+    if (read_result != SUCCESS)
     {
-        IO::logln("Client handle has error: {}!", read_result.description());
-        _disconnected = true;
-        client_destroy_disconnected();
-        return;
-    }
-
-    size_t message_size = read_result.unwrap();
-
-    if (message_size != sizeof(CompositorMessage))
-    {
-        IO::logln("Got a message with an invalid size from client {} != {}!", sizeof(CompositorMessage), message_size);
-        hexdump(&message, message_size);
-
+        IO::logln("Client handle has error: {}!", get_result_description(read_result));
         _disconnected = true;
         client_destroy_disconnected();
         return;
@@ -199,7 +185,7 @@ void Client::handle_request()
 
     default:
         IO::logln("Invalid message for client {08x}", this);
-        hexdump(&message, message_size);
+        hexdump(&message, CompositorSchema::wire_size(message));
 
         _disconnected = true;
         client_destroy_disconnected();
@@ -213,11 +199,9 @@ void Client::connect(IO::Connection connection)
     _clients.push_back(own<Client>(connection));
 }
 
-Client::Client(IO::Connection connection)
+Client::Client(IO::Connection connection) : _channel{connection}
 {
-    _connection = connection;
-
-    _notifier = own<Async::Notifier>(connection, POLL_READ, [this]() {
+    _channel.on_receive([this]() {
         this->handle_request();
     });
 
@@ -268,13 +252,13 @@ Result Client::send_message(CompositorMessage message)
         return ERR_STREAM_CLOSED;
     }
 
-    auto write_result = _connection.write(&message, sizeof(CompositorMessage));
+    auto write_result = CompositorSchema::write(_channel, message);
 
-    if (!write_result.success())
+    if (write_result != SUCCESS)
     {
-        IO::logln("Failed to send message to {08x}: {}", this, write_result.description());
+        IO::logln("Failed to send message to {08x}: {}", this, get_result_description(write_result));
         _disconnected = true;
-        return write_result.result();
+        return write_result;
     }
 
     return SUCCESS;
@@ -1,14 +1,12 @@
 #pragma once
 
-#include <libasync/Notifier.h>
-#include <libio/Connection.h>
+#include <libipc/Channel.h>
 
 #include "compositor/Protocol.h"
 
 struct Client
 {
-    OwnPtr<Async::Notifier> _notifier = nullptr;
-    IO::Connection _connection;
+    IPC::Channel _channel;
     bool _disconnected = false;
 
     static void connect(IO::Connection connection);
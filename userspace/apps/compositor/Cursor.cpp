@@ -74,11 +74,10 @@ void cursor_handle_packet(MousePacket packet)
     Window *window_under = manager_get_window_at(_mouse_position);
     Window *window_on_focus = manager_focus_window();
 
+    // The renderer notices the cursor moved on its own, and moves it
+    // without compositing anything.
     if (_mouse_old_position != _mouse_position)
     {
-        renderer_region_dirty(cursor_dirty_bound_from_position(_mouse_old_position));
-        renderer_region_dirty(cursor_dirty_bound_from_position(_mouse_position));
-
         if (window_on_focus)
         {
             window_on_focus->handle_mouse_move(_mouse_old_position, _mouse_position, _mouse_buttons);
@@ -135,11 +134,9 @@ Widget::CursorState cursor_get_state()
     }
 }
 
-void cursor_render(Graphic::Painter &painter)
+Graphic::Bitmap &cursor_bitmap()
 {
-    auto cursor_bitmap = _cursor_bitmaps[cursor_get_state()];
-
-    painter.blit(*cursor_bitmap, cursor_bitmap->bound(), cursor_bound());
+    return *_cursor_bitmaps[cursor_get_state()];
 }
 
 Math::Recti cursor_bound_from_position(Math::Vec2i position)
@@ -169,18 +166,6 @@ Math::Recti cursor_bound()
     return cursor_bound_from_position(_mouse_position);
 }
 
-Math::Recti cursor_dirty_bound_from_position(Math::Vec2i position)
-{
-    return Math::Recti(
-        position + Math::Vec2i(-28, -28),
-        Math::Vec2i(56, 56));
-}
-
-Math::Recti cursor_dirty_bound()
-{
-    return cursor_dirty_bound_from_position(_mouse_position);
-}
-
 Math::Vec2i cursor_position()
 {
     return _mouse_position;
@@ -0,0 +1,96 @@
+#include <libgraphic/Painter.h>
+
+#include "compositor/CursorPlane.h"
+
+static void copy_pixels(Graphic::Bitmap &destination, Math::Vec2i to, Graphic::Bitmap &source, Math::Vec2i from, Math::Vec2i size)
+{
+    for (int y = 0; y < size.y(); y++)
+    {
+        Graphic::copy_span(
+            destination.pixels() + (to.y() + y) * destination.width() + to.x(),
+            source.pixels() + (from.y() + y) * source.width() + from.x(),
+            size.x());
+    }
+}
+
+Graphic::Bitmap &CursorPlane::tinted(Graphic::Bitmap &cursor, Graphic::Color tint)
+{
+    if (_tinted && _tinted_from == &cursor && _tinted_with == tint)
+    {
+        return *_tinted;
+    }
+
+    if (!_tinted || _tinted->size() != cursor.size())
+    {
+        _tinted = Graphic::Bitmap::create_shared(cursor.width(), cursor.height()).unwrap();
+    }
+
+    // Scaling the colors down keeps them under their alpha, premultiplied
+    // pixels can be tinted as they are.
+    for (int i = 0; i < cursor.width() * cursor.height(); i++)
+    {
+        auto pixel = cursor.pixels()[i];
+
+        _tinted->pixels()[i] = Graphic::Color::from_rgba_byte(
+            pixel.red() * tint.redf(),
+            pixel.green() * tint.greenf(),
+            pixel.blue() * tint.bluef(),
+            pixel.alpha());
+    }
+
+    _tinted_from = &cursor;
+    _tinted_with = tint;
+
+    return *_tinted;
+}
+
+void CursorPlane::hide(Graphic::Bitmap &framebuffer)
+{
+    if (!_visible.is_empty())
+    {
+        copy_pixels(framebuffer, _visible.position(), *_under, {}, _visible.size());
+    }
+
+    _cursor = nullptr;
+    _visible = Math::Recti::empty();
+}
+
+void CursorPlane::show(Graphic::Bitmap &framebuffer, Graphic::Bitmap &cursor, Math::Recti bound, Optional<Graphic::Color> tint)
+{
+    hide(framebuffer);
+
+    _cursor = &cursor;
+    _tint = tint;
+    _bound = bound;
+    _visible = bound.clipped_with(framebuffer.bound());
+
+    if (_visible.is_empty())
+    {
+        return;
+    }
+
+    if (!_under || _under->size() != bound.size())
+    {
+        _under = Graphic::Bitmap::create_shared(bound.width(), bound.height()).unwrap();
+    }
+
+    copy_pixels(*_under, {}, framebuffer, _visible.position(), _visible.size());
+
+    Graphic::Painter painter{framebuffer};
+
+    if (tint.present())
+    {
+        auto &tinted_cursor = tinted(cursor, tint.unwrap());
+        painter.blit(tinted_cursor, tinted_cursor.bound(), bound);
+    }
+    else
+    {
+        painter.blit(cursor, cursor.bound(), bound);
+    }
+}
+
+void CursorPlane::forget()
+{
+    _cursor = nullptr;
+    _visible = Math::Recti::empty();
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <libgraphic/Bitmap.h>
+#include <libutils/Optional.h>
+
+// The cursor goes straight into the framebuffer, over everything that was
+// composited, and the pixels it hides are kept aside. Moving it puts them
+// back and saves the ones at the new place, nothing is composited again.
+// None of the display drivers have a cursor of their own, so this is the
+// only plane there is.
+class CursorPlane
+{
+private:
+    RefPtr<Graphic::Bitmap> _under;
+
+    // The cursor tinted for the night light, made again only when the
+    // cursor or the tint changes.
+    RefPtr<Graphic::Bitmap> _tinted;
+    Graphic::Bitmap *_tinted_from = nullptr;
+    Graphic::Color _tinted_with;
+
+    Graphic::Bitmap *_cursor = nullptr;
+    Optional<Graphic::Color> _tint;
+    Math::Recti _bound = Math::Recti::empty();
+    Math::Recti _visible = Math::Recti::empty();
+
+    Graphic::Bitmap &tinted(Graphic::Bitmap &cursor, Graphic::Color tint);
+
+public:
+    // Where the cursor is, unclipped.
+    Math::Recti bound() const { return _bound; }
+
+    // The part of the framebuffer covered by the cursor, empty if hidden.
+    Math::Recti visible() const { return _visible; }
+
+    bool shows(Graphic::Bitmap &cursor, Math::Recti bound, Optional<Graphic::Color> tint) const
+    {
+        if (_cursor != &cursor || _bound != bound || _tint.present() != tint.present())
+        {
+            return false;
+        }
+
+        return !tint.present() || _tint.unwrap() == tint.unwrap();
+    }
+
+    // Puts back the pixels hidden by the cursor.
+    void hide(Graphic::Bitmap &framebuffer);
+
+    // Saves the pixels under `bound` and draws `cursor` over them, tinted
+    // by `tint` if there is one.
+    void show(Graphic::Bitmap &framebuffer, Graphic::Bitmap &cursor, Math::Recti bound, Optional<Graphic::Color> tint);
+
+    // Drops the saved pixels without putting them back, for when the
+    // framebuffer is going away.
+    void forget();
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <libipc/Schema.h>
 #include <libmath/Rect.h>
 #include <libwidget/Cursor.h>
 #include <libwidget/Event.h>
@@ -23,6 +24,8 @@ enum CompositorMessageType
 
     COMPOSITOR_MESSAGE_GET_MOUSE_POSITION,
     COMPOSITOR_MESSAGE_MOUSE_POSITION,
+
+    COMPOSITOR_MESSAGE_FRAME_DONE,
 };
 
 #define WINDOW_NONE (0)
@@ -37,6 +40,16 @@ enum CompositorMessageType
 
 typedef unsigned int WindowFlag;
 
+// Clients paint into one buffer while the compositor shows another and a
+// third one waits to be presented.
+#define WINDOW_SWAPCHAIN_SIZE (3)
+
+// Clients merge their damage down to this many rectangles per flip.
+#define WINDOW_DIRTY_MAX (8)
+
+// Events queued for a window are sent together, up to this many at once.
+#define WINDOW_EVENTS_MAX (8)
+
 enum WindowType
 {
     WINDOW_TYPE_POPOVER,
@@ -84,21 +97,32 @@ struct CompositorMoveWindow
 struct CompositorFlipWindow
 {
     int id;
+    unsigned int frame;
 
     int frontbuffer;
     Math::Vec2i frontbuffer_size;
-    int backbuffer;
-    Math::Vec2i backbuffer_size;
 
-    Math::Recti dirty;
     Math::Recti bound;
+
+    // Only the rectangles in use go on the wire, keep them last.
+    size_t dirty_count;
+    Math::Recti dirty[WINDOW_DIRTY_MAX];
+};
+
+// Sent once a flipped frame made it to the screen, the buffer that was shown
+// before it is no longer used by the compositor.
+struct CompositorFrameDone
+{
+    int id;
+    unsigned int frame;
 };
 
 struct CompositorEventWindow
 {
     int id;
 
-    Widget::Event event;
+    size_t count;
+    Widget::Event events[WINDOW_EVENTS_MAX];
 };
 
 struct CompositorCursorWindow
@@ -136,6 +160,7 @@ struct CompositorMessage
         CompositorDestroyWindow destroy_window;
         CompositorMoveWindow move_window;
         CompositorFlipWindow flip_window;
+        CompositorFrameDone frame_done;
         CompositorEventWindow event_window;
         CompositorCursorWindow cursor_window;
         CompositorSetResolution set_resolution;
@@ -144,3 +169,18 @@ struct CompositorMessage
         CompositorMousePosition mouse_position;
     };
 };
+
+using CompositorSchema = IPC::Schema<
+    CompositorMessage,
+    IPC::Entry<COMPOSITOR_MESSAGE_GREETINGS, &CompositorMessage::greetings>,
+    IPC::Entry<COMPOSITOR_MESSAGE_EVENT, &CompositorMessage::event>,
+    IPC::Entry<COMPOSITOR_MESSAGE_CHANGED_RESOLUTION, &CompositorMessage::changed_resolution>,
+    IPC::Entry<COMPOSITOR_MESSAGE_CREATE_WINDOW, &CompositorMessage::create_window>,
+    IPC::Entry<COMPOSITOR_MESSAGE_DESTROY_WINDOW, &CompositorMessage::destroy_window>,
+    IPC::Entry<COMPOSITOR_MESSAGE_MOVE_WINDOW, &CompositorMessage::move_window>,
+    IPC::Entry<COMPOSITOR_MESSAGE_FLIP_WINDOW, &CompositorMessage::flip_window, IPC::Trailing<&CompositorFlipWindow::dirty_count, &CompositorFlipWindow::dirty>>,
+    IPC::Entry<COMPOSITOR_MESSAGE_FRAME_DONE, &CompositorMessage::frame_done>,
+    IPC::Entry<COMPOSITOR_MESSAGE_EVENT_WINDOW, &CompositorMessage::event_window, IPC::Trailing<&CompositorEventWindow::count, &CompositorEventWindow::events>>,
+    IPC::Entry<COMPOSITOR_MESSAGE_CURSOR_WINDOW, &CompositorMessage::cursor_window>,
+    IPC::Entry<COMPOSITOR_MESSAGE_SET_RESOLUTION, &CompositorMessage::set_resolution>,
+    IPC::Entry<COMPOSITOR_MESSAGE_MOUSE_POSITION, &CompositorMessage::mouse_position>>;
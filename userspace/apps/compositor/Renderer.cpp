@@ -1,7 +1,11 @@
 #include <libgraphic/Framebuffer.h>
+#include <libio/Streams.h>
+#include <libmath/Region.h>
+#include <libsystem/system/System.h>
 #include <libutils/Vector.h>
 
 #include "compositor/Cursor.h"
+#include "compositor/CursorPlane.h"
 #include "compositor/Manager.h"
 #include "compositor/Renderer.h"
 #include "compositor/Window.h"
@@ -11,7 +15,23 @@
 static OwnPtr<Graphic::Framebuffer> _framebuffer;
 static OwnPtr<compositor::Wallpaper> _wallpaper;
 
-static Vector<Math::Recti> _dirty_regions;
+// Everything that has to be drawn again on the next frame.
+static Math::Regioni _damage;
+
+struct VisibleWindow
+{
+    Window *window;
+    Math::Regioni region;
+};
+
+static Vector<VisibleWindow> _visible_windows;
+
+static CursorPlane _cursor_plane;
+
+// About every ten seconds while something is moving on screen.
+static constexpr size_t RENDERER_STATISTICS_PERIOD = 600;
+
+static RendererStatistics _statistics = {};
 
 static OwnPtr<Settings::Setting> _night_light_enable_setting;
 bool _night_light_enable = false;
@@ -40,213 +60,222 @@ void renderer_initialize()
 
 void renderer_region_dirty(Math::Recti new_region)
 {
+    new_region = new_region.clipped_with(renderer_bound());
+
     if (new_region.is_empty())
     {
         return;
     }
 
-    bool merged = false;
+    _damage.add(new_region);
+}
 
-    _dirty_regions.foreach ([&](Math::Recti &region) {
-        if (region.colide_with(new_region))
-        {
-            Math::Recti top;
-            Math::Recti botton;
-            Math::Recti left;
-            Math::Recti right;
+static constexpr int WINDOW_CORNER_RADIUS = 6;
 
-            new_region.substract(region, top, botton, left, right);
+static constexpr Graphic::Color RENDERER_NIGHT_LIGHT_TINT = Graphic::Color::from_rgb(1, 0.9, 0.8);
 
-            renderer_region_dirty(top);
-            renderer_region_dirty(botton);
-            renderer_region_dirty(left);
-            renderer_region_dirty(right);
+// The part of the window hiding whatever is behind it.
+static Math::Regioni renderer_window_opaque_region(Window *window)
+{
+    if (window->flags() & WINDOW_TRANSPARENT)
+    {
+        return {};
+    }
 
-            merged = true;
+    Math::Regioni region{window->bound()};
 
-            return Iteration::STOP;
+    if (!(window->flags() & WINDOW_NO_ROUNDED_CORNERS))
+    {
+        region.remove(window->bound().take_top_left(WINDOW_CORNER_RADIUS));
+        region.remove(window->bound().take_top_right(WINDOW_CORNER_RADIUS));
+        region.remove(window->bound().take_bottom_left(WINDOW_CORNER_RADIUS));
+        region.remove(window->bound().take_bottom_right(WINDOW_CORNER_RADIUS));
+    }
+
+    return region;
+}
+
+static void renderer_composite_window(Graphic::Painter &painter, Window *window, Math::Recti rectangle)
+{
+    bool rounded = !(window->flags() & WINDOW_NO_ROUNDED_CORNERS);
+
+    painter.push();
+    painter.clip(rectangle);
+
+    if (window->flags() & WINDOW_ACRYLIC)
+    {
+        if (rounded)
+        {
+            painter.blit_rounded(_wallpaper->acrylic(), window->bound(), window->bound(), WINDOW_CORNER_RADIUS);
         }
         else
         {
-            return Iteration::CONTINUE;
+            painter.blit(_wallpaper->acrylic(), rectangle, rectangle);
         }
-    });
+    }
 
-    if (!merged)
+    if (rounded)
     {
-        _dirty_regions.push_back(new_region);
+        painter.blit_rounded(window->frontbuffer(), window->bound().size(), window->bound(), WINDOW_CORNER_RADIUS);
+    }
+    else
+    {
+        Math::Recti source{rectangle.position() - window->bound().position(), rectangle.size()};
+        painter.blit(window->frontbuffer(), source, rectangle);
     }
-}
 
-void renderer_composite_wallpaper(Graphic::Painter &painter, Math::Recti region)
-{
-    painter.blit(_wallpaper->scaled(), region, region);
-    _framebuffer->mark_dirty(region);
+    painter.pop();
 }
 
-void renderer_composite_region(Graphic::Painter &painter, Math::Recti region, Window *window_transparent)
+// Goes through the windows from front to back, each one gets whatever is
+// damaged and not hidden by the opaque windows in front of it. What is left
+// goes to the wallpaper. Then everything is drawn back to front, so
+// translucent parts of windows go over what is behind them, and every pixel
+// is only drawn by the windows that can actually be seen there.
+static void renderer_composite(Graphic::Painter &painter)
 {
-    renderer_composite_wallpaper(painter, region);
+    _visible_windows.clear();
+
+    Math::Regioni covered;
 
-    manager_iterate_back_to_front([&](Window *window) {
-        if (window == window_transparent)
+    manager_iterate_front_to_back([&](Window *window) {
+        if (!_damage.colide_with(window->bound()))
         {
-            return Iteration::STOP;
+            return Iteration::CONTINUE;
         }
 
-        if (window->bound().colide_with(region))
-        {
-            Math::Recti destination = window->bound().clipped_with(region);
+        auto region = _damage.clipped_with(window->bound()).without(covered);
 
-            Math::Recti source(
-                destination.position() - window->bound().position(),
-                destination.size());
+        if (!region.is_empty())
+        {
+            _visible_windows.push_back({window, region});
+        }
 
-            if (window->flags() & WINDOW_ACRYLIC)
-            {
-                painter.blit(_wallpaper->acrylic(), destination, destination);
-            }
+        covered.add(renderer_window_opaque_region(window));
 
-            painter.blit(window->frontbuffer(), source, destination);
-        }
+        return Iteration::CONTINUE;
+    });
 
+    _damage.without(covered).foreach([&](auto &rectangle) {
+        painter.blit(_wallpaper->scaled(), rectangle, rectangle);
         return Iteration::CONTINUE;
     });
 
-    _framebuffer->mark_dirty(region);
+    _visible_windows.foreach_reversed([&](auto &visible) {
+        visible.region.foreach([&](auto &rectangle) {
+            renderer_composite_window(painter, visible.window, rectangle);
+            return Iteration::CONTINUE;
+        });
+
+        return Iteration::CONTINUE;
+    });
 }
 
-void renderer_region(Graphic::Painter &painter, Math::Recti region)
+Math::Recti renderer_bound()
 {
-    bool should_paint_wallpaper = true;
-
-    if (region.is_empty())
-    {
-        return;
-    }
-
-    manager_iterate_front_to_back([&](Window *window) {
-        if (window->bound().colide_with(region))
-        {
-            Math::Recti destination = window->bound().clipped_with(region);
-
-            Math::Recti source(
-                destination.position() - window->bound().position(),
-                destination.size());
+    return _framebuffer->resolution();
+}
 
-            int radius = 6;
+static void renderer_report_statistics()
+{
+    IO::logln("{} frames, {} pixels presented, {}ms compositing, {}ms presenting, slowest frame {}ms ({})",
+              _statistics.frames,
+              _statistics.pixels,
+              _statistics.composite,
+              _statistics.present,
+              _statistics.slowest_frame,
+              _framebuffer->mapped() ? "mapped" : "blit");
+
+    _statistics = {};
+}
 
-            if (window->flags() & WINDOW_TRANSPARENT)
-            {
-                renderer_composite_region(painter, destination, window);
-                painter.blit(window->frontbuffer(), source, destination);
-            }
-            else if (window->flags() & WINDOW_ACRYLIC)
-            {
-                if (window->flags() & WINDOW_NO_ROUNDED_CORNERS)
-                {
-                    painter.blit(_wallpaper->acrylic(), region, region);
-                    painter.blit(window->frontbuffer(), source, destination);
-                }
-                else
-                {
-                    painter.push();
-                    painter.clip(destination);
-
-                    renderer_composite_region(painter, window->bound().take_top_left(radius).clipped_with(region), window);
-                    renderer_composite_region(painter, window->bound().take_top_right(radius).clipped_with(region), window);
-                    renderer_composite_region(painter, window->bound().take_bottom_left(radius).clipped_with(region), window);
-                    renderer_composite_region(painter, window->bound().take_bottom_right(radius).clipped_with(region), window);
-
-                    painter.blit_rounded(_wallpaper->acrylic(), window->bound(), window->bound(), radius);
-                    painter.blit_rounded(window->frontbuffer(), window->bound().size(), window->bound(), radius);
-                    painter.pop();
-                }
-            }
-            else
-            {
-                if (window->flags() & WINDOW_NO_ROUNDED_CORNERS)
-                {
-                    painter.blit(window->frontbuffer(), source, destination);
-                }
-                else
-                {
-                    painter.push();
-                    painter.clip(destination);
-
-                    renderer_composite_region(painter, window->bound().take_top_left(radius).clipped_with(region), window);
-                    renderer_composite_region(painter, window->bound().take_top_right(radius).clipped_with(region), window);
-                    renderer_composite_region(painter, window->bound().take_bottom_left(radius).clipped_with(region), window);
-                    renderer_composite_region(painter, window->bound().take_bottom_right(radius).clipped_with(region), window);
-
-                    painter.blit_rounded(window->frontbuffer(), window->bound().size(), window->bound(), radius);
-                    painter.pop();
-                }
-            }
+const RendererStatistics &renderer_statistics()
+{
+    return _statistics;
+}
 
-            _framebuffer->mark_dirty(destination);
+void renderer_repaint_dirty()
+{
+    Tick start = system_get_ticks();
 
-            Math::Recti top;
-            Math::Recti botton;
-            Math::Recti left;
-            Math::Recti right;
+    auto &bitmap = _framebuffer->bitmap();
+    Graphic::Painter painter{bitmap};
 
-            region.substract(destination, top, botton, left, right);
+    // The cursor is taken off the framebuffer while what is under it gets
+    // composited, then put back on top.
+    // Hiding forgets where the cursor was, but that place may have moved
+    // away from the damage and still needs to reach the screen.
+    auto old_cursor = _cursor_plane.visible();
+    bool cursor_damaged = _damage.colide_with(old_cursor);
 
-            renderer_region(painter, top);
-            renderer_region(painter, botton);
-            renderer_region(painter, left);
-            renderer_region(painter, right);
+    if (cursor_damaged)
+    {
+        _cursor_plane.hide(bitmap);
+    }
 
-            should_paint_wallpaper = false;
+    renderer_composite(painter);
 
-            return Iteration::STOP;
+    _damage.foreach([&](auto &rectangle) {
+        if (_night_light_enable)
+        {
+            painter.tint(rectangle, RENDERER_NIGHT_LIGHT_TINT);
         }
 
+        _framebuffer->mark_dirty(rectangle);
+
         return Iteration::CONTINUE;
     });
 
-    if (should_paint_wallpaper)
+    Optional<Graphic::Color> cursor_tint;
+
+    if (_night_light_enable)
     {
-        renderer_composite_wallpaper(painter, region);
+        cursor_tint = RENDERER_NIGHT_LIGHT_TINT;
     }
-}
 
-Math::Recti renderer_bound()
-{
-    return _framebuffer->resolution();
-}
+    // Moving the cursor only puts back the pixels it was hiding and saves
+    // the ones at its new place.
+    if (cursor_damaged || !_cursor_plane.shows(cursor_bitmap(), cursor_bound(), cursor_tint))
+    {
+        _framebuffer->mark_dirty(old_cursor);
+        _cursor_plane.show(bitmap, cursor_bitmap(), cursor_bound(), cursor_tint);
+        _framebuffer->mark_dirty(_cursor_plane.visible());
+    }
 
-void renderer_repaint_dirty()
-{
-    Graphic::Painter painter{_framebuffer->bitmap()};
+    Tick composited = system_get_ticks();
 
-    _dirty_regions.foreach ([&](Math::Recti region) {
-        renderer_region(painter, region);
+    size_t pixels = _framebuffer->blit();
 
-        if (_night_light_enable)
-        {
-            painter.tint(region, Graphic::Color::from_rgb(1, 0.9, 0.8));
-        }
+    Tick presented = system_get_ticks();
 
-        if (region.colide_with(cursor_bound()))
-        {
-            renderer_region(painter, cursor_bound());
+    if (pixels > 0)
+    {
+        _statistics.frames++;
+        _statistics.pixels += pixels;
+        _statistics.composite += composited - start;
+        _statistics.present += presented - composited;
+        _statistics.slowest_frame = MAX(_statistics.slowest_frame, presented - start);
 
-            cursor_render(painter);
+        if (_statistics.frames == RENDERER_STATISTICS_PERIOD)
+        {
+            renderer_report_statistics();
+        }
+    }
 
-            if (_night_light_enable)
+    // Only the windows whose new frame just reached the screen are told.
+    if (!_damage.is_empty())
+    {
+        manager_iterate_back_to_front([](Window *window) {
+            if (window->frame_pending() && _damage.colide_with(window->frame_damage()))
             {
-                painter.tint(cursor_bound(), Graphic::Color::from_rgb(1, 0.9, 0.8));
+                window->frame_presented();
             }
-        }
 
-        return Iteration::CONTINUE;
-    });
-
-    _framebuffer->blit();
+            return Iteration::CONTINUE;
+        });
+    }
 
-    _dirty_regions.clear();
+    _damage.clear();
 }
 
 bool renderer_set_resolution(int width, int height)
@@ -258,6 +287,9 @@ bool renderer_set_resolution(int width, int height)
         return false;
     }
 
+    // Whatever the cursor was hiding went away with the old framebuffer.
+    _cursor_plane.forget();
+
     _wallpaper->change_resolution({width, height});
     renderer_region_dirty(renderer_bound());
 
@@ -1,8 +1,20 @@
 #pragma once
 
+#include <abi/Time.h>
+
 #include <libgraphic/Bitmap.h>
 #include <libmath/Rect.h>
 
+// Counted since the last time they were reported, ticks are milliseconds.
+struct RendererStatistics
+{
+    size_t frames;
+    size_t pixels;
+    Tick composite;
+    Tick present;
+    Tick slowest_frame;
+};
+
 void renderer_initialize();
 
 Math::Recti renderer_bound();
@@ -11,6 +23,8 @@ void renderer_region_dirty(Math::Recti region);
 
 void renderer_repaint_dirty();
 
+const RendererStatistics &renderer_statistics();
+
 bool renderer_set_resolution(int width, int height);
 
 void renderer_set_wallaper(RefPtr<Graphic::Bitmap> wallaper);
@@ -19,9 +19,13 @@ Window::Window(
       _type(type),
       _client(client),
       _bound(bound),
-      _frontbuffer(frontbuffer),
-      _backbuffer(backbuffer)
+      _frontbuffer(frontbuffer)
 {
+    _buffers.push_back(frontbuffer);
+    _buffers.push_back(backbuffer);
+
+    _events_invoker = own<Async::Invoker>([this]() { flush_events(); });
+
     manager_register_window(this);
 }
 
@@ -69,14 +73,45 @@ void Window::resize(Math::Recti new_bound)
 
 void Window::send_event(Widget::Event event)
 {
+    if (!_events.empty() && Widget::event_coalesce(_events.peek_back(), event))
+    {
+        return;
+    }
+
+    if (_events.count() == WINDOW_EVENTS_MAX)
+    {
+        flush_events();
+    }
+
+    _events.push_back(event);
+    _events_invoker->invoke_later();
+}
+
+void Window::flush_events()
+{
+    _events_invoker->cancel();
+
+    if (_events.empty())
+    {
+        return;
+    }
+
     CompositorMessage message = {
         .type = COMPOSITOR_MESSAGE_EVENT_WINDOW,
         .event_window = {
             .id = _id,
-            .event = event,
+            .count = _events.count(),
+            .events = {},
         },
     };
 
+    for (size_t i = 0; i < _events.count(); i++)
+    {
+        message.event_window.events[i] = _events[i];
+    }
+
+    _events.clear();
+
     _client->send_message(message);
 }
 
@@ -216,37 +251,86 @@ void Window::lost_focus()
     send_event(event);
 }
 
-void Window::flip_buffers(int frontbuffer_handle, Math::Vec2i frontbuffer_size, int backbuffer_handle, Math::Vec2i backbuffer_size, Math::Recti region)
+void Window::flip_buffers(unsigned int frame, int frontbuffer_handle, Math::Vec2i frontbuffer_size, const Math::Recti *dirty, size_t dirty_count)
 {
-    swap(_frontbuffer, _backbuffer);
+    RefPtr<Graphic::Bitmap> new_frontbuffer = nullptr;
 
-    if (_frontbuffer->handle() != frontbuffer_handle)
-    {
+    _buffers.foreach ([&](auto &buffer) {
+        if (buffer->handle() == frontbuffer_handle && buffer->size() == frontbuffer_size)
+        {
+            new_frontbuffer = buffer;
+            return Iteration::STOP;
+        }
+
+        return Iteration::CONTINUE;
+    });
 
-        auto new_frontbuffer = Graphic::Bitmap::create_shared_from_handle(frontbuffer_handle, frontbuffer_size);
+    if (new_frontbuffer == nullptr)
+    {
+        auto result = Graphic::Bitmap::create_shared_from_handle(frontbuffer_handle, frontbuffer_size);
 
-        if (!new_frontbuffer.success())
+        if (!result.success())
         {
             IO::logln("Client application gave us a jankie shared memory object id");
             return;
         }
 
-        _frontbuffer = new_frontbuffer.unwrap();
+        new_frontbuffer = result.unwrap();
+
+        // The client recreates its whole swap chain when it resizes.
+        _buffers.remove_all_match([&](auto &buffer) {
+            return buffer->size() != frontbuffer_size;
+        });
+
+        if (_buffers.count() >= WINDOW_SWAPCHAIN_SIZE)
+        {
+            _buffers.remove_index(0);
+        }
+
+        _buffers.push_back(new_frontbuffer);
     }
 
-    if (_backbuffer->handle() != backbuffer_handle)
-    {
+    _frontbuffer = new_frontbuffer;
+    _frame = frame;
+    _frame_pending = true;
+    _frame_damage = {};
 
-        auto new_backbuffer = Graphic::Bitmap::create_shared_from_handle(backbuffer_handle, backbuffer_size);
+    for (size_t i = 0; i < dirty_count; i++)
+    {
+        auto rectangle = dirty[i].clipped_with(bound().size()).offset(bound().position()).clipped_with(renderer_bound());
 
-        if (!new_backbuffer.success())
+        if (rectangle.is_empty())
         {
-            IO::logln("Client application gave us a jankie shared memory object id");
-            return;
+            continue;
         }
 
-        _backbuffer = new_backbuffer.unwrap();
+        renderer_region_dirty(rectangle);
+        _frame_damage = _frame_damage.is_empty() ? rectangle : _frame_damage.merged_with(rectangle);
+    }
+
+    // Nothing of it reaches the screen, there is no repaint to wait for.
+    if (_frame_damage.is_empty())
+    {
+        frame_presented();
+    }
+}
+
+void Window::frame_presented()
+{
+    if (!_frame_pending)
+    {
+        return;
     }
 
-    renderer_region_dirty(region.offset(bound().position()));
+    _frame_pending = false;
+
+    CompositorMessage message = {
+        .type = COMPOSITOR_MESSAGE_FRAME_DONE,
+        .frame_done = {
+            .id = _id,
+            .frame = _frame,
+        },
+    };
+
+    _client->send_message(message);
 }
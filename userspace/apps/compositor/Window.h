@@ -1,8 +1,10 @@
 #pragma once
 
+#include <libasync/Invoker.h>
 #include <libgraphic/Bitmap.h>
 #include <libmath/Rect.h>
 #include <libutils/Assert.h>
+#include <libutils/Vector.h>
 #include <libwidget/Cursor.h>
 #include <libwidget/Event.h>
 
@@ -22,7 +24,20 @@ private:
     Widget::CursorState _cursor_state{};
 
     RefPtr<Graphic::Bitmap> _frontbuffer;
-    RefPtr<Graphic::Bitmap> _backbuffer;
+
+    // The buffers of the client's swap chain, kept mapped between flips.
+    Vector<RefPtr<Graphic::Bitmap>> _buffers;
+
+    unsigned int _frame = 0;
+    bool _frame_pending = false;
+
+    // Where the pending frame changed the screen.
+    Math::Recti _frame_damage{};
+
+    // Sent once everything that is ready to be processed was, so motions
+    // can be merged.
+    Vector<Widget::Event> _events;
+    OwnPtr<Async::Invoker> _events_invoker;
 
 public:
     int id() { return _id; }
@@ -62,6 +77,8 @@ public:
 
     void send_event(Widget::Event event);
 
+    void flush_events();
+
     void handle_mouse_move(Math::Vec2i old_position, Math::Vec2i position, Widget::MouseButton buttons);
 
     void handle_mouse_buttons(Widget::MouseButton old_buttons, Widget::MouseButton buttons, Math::Vec2i position);
@@ -74,5 +91,11 @@ public:
 
     void lost_focus();
 
-    void flip_buffers(int frontbuffer_handle, Math::Vec2i frontbuffer_size, int backbuffer_handle, Math::Vec2i backbuffer_size, Math::Recti region);
+    void flip_buffers(unsigned int frame, int frontbuffer_handle, Math::Vec2i frontbuffer_size, const Math::Recti *dirty, size_t dirty_count);
+
+    bool frame_pending() { return _frame_pending; }
+
+    Math::Recti frame_damage() { return _frame_damage; }
+
+    void frame_presented();
 };
@@ -103,12 +103,17 @@ int main(int argc, char const *argv[])
     });
 
     auto mouse_notifier = own<Async::Notifier>(mouse_stream, POLL_READ, [&]() {
-        MousePacket packet;
-        size_t size = mouse_stream.read(&packet, sizeof(MousePacket)).unwrap();
+        // Take every pending packet at once, the motions they produce are
+        // merged before being sent to the windows.
+        MousePacket packets[32];
+        size_t size = mouse_stream.read(packets, sizeof(packets)).unwrap();
 
-        if (size == sizeof(MousePacket))
+        if (size % sizeof(MousePacket) == 0)
         {
-            cursor_handle_packet(packet);
+            for (size_t i = 0; i < size / sizeof(MousePacket); i++)
+            {
+                cursor_handle_packet(packets[i]);
+            }
         }
         else
         {
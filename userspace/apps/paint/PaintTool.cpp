@@ -111,8 +111,9 @@ void FillTool::event(PaintDocument &document, Widget::Event &event, Graphic::Col
     {
         if (event.mouse.buttons & (MOUSE_BUTTON_LEFT | MOUSE_BUTTON_RIGHT))
         {
-            Graphic::Color target_color = document.bitmap().get_pixel(event.mouse.position);
-            flood_fill(document.bitmap(), event.mouse.position, target_color, color);
+            auto &bitmap = document.bitmap();
+            Graphic::Color target_color = bitmap.get_pixel(event.mouse.position);
+            flood_fill(bitmap, event.mouse.position, target_color, bitmap.encode(color));
             document.dirty(true);
         }
     }
@@ -124,13 +125,15 @@ void PickerTool::event(PaintDocument &document, Widget::Event &event, Graphic::C
 
     if (event.type == Widget::Event::MOUSE_BUTTON_PRESS)
     {
+        auto &bitmap = document.bitmap();
+
         if (event.mouse.buttons & MOUSE_BUTTON_LEFT)
         {
-            document.primary_color(document.bitmap().get_pixel(event.mouse.position));
+            document.primary_color(bitmap.decode(bitmap.get_pixel(event.mouse.position)));
         }
         else if (event.mouse.buttons & MOUSE_BUTTON_RIGHT)
         {
-            document.secondary_color(document.bitmap().get_pixel(event.mouse.position));
+            document.secondary_color(bitmap.decode(bitmap.get_pixel(event.mouse.position)));
         }
     }
 }
@@ -1,5 +1,7 @@
 #include "panel/widgets/DateAndTime.h"
 
+#include <skift/Time.h>
+
 using namespace Widget;
 
 namespace Panel
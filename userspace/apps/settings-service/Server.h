@@ -59,6 +59,7 @@ public:
         {
             Message response;
             response.type = Message::SERVER_VALUE;
+            response.request = message.request;
             response.path = message.path;
             response.payload = _repository.read(message.path.unwrap());
 
@@ -84,6 +85,7 @@ public:
 
             Message response;
             response.type = Message::SERVER_ACK;
+            response.request = message.request;
 
             client.send(response);
         }
@@ -93,6 +95,7 @@ public:
 
             Message response;
             response.type = Message::SERVER_ACK;
+            response.request = message.request;
 
             client.send(response);
         }
@@ -102,6 +105,7 @@ public:
 
             Message response;
             response.type = Message::SERVER_ACK;
+            response.request = message.request;
 
             client.send(response);
         }
@@ -65,22 +65,13 @@ TerminalView::TerminalView()
     font(Graphic::Font::get("mono").unwrap());
 }
 
-void TerminalView::paint_cell(
+void TerminalView::paint_cell_background(
     Graphic::Painter &painter,
-    int x,
-    int y,
-    Codepoint codepoint,
+    Math::Recti bound,
     Terminal::Color foreground,
     Terminal::Color background,
     Terminal::Attributes attributes)
 {
-    Math::Recti bound = cell_bound(x, y);
-
-    if (attributes.invert)
-    {
-        swap(foreground, background);
-    }
-
     if (background != Terminal::BACKGROUND)
     {
         painter.clear(bound, cell_color(background));
@@ -93,6 +84,25 @@ void TerminalView::paint_cell(
             bound.position() + Math::Vec2i(bound.width(), 14),
             cell_color(foreground));
     }
+}
+
+void TerminalView::paint_cell(
+    Graphic::Painter &painter,
+    int x,
+    int y,
+    Codepoint codepoint,
+    Terminal::Color foreground,
+    Terminal::Color background,
+    Terminal::Attributes attributes)
+{
+    Math::Recti bound = cell_bound(x, y);
+
+    if (attributes.invert)
+    {
+        swap(foreground, background);
+    }
+
+    paint_cell_background(painter, bound, foreground, background, attributes);
 
     if (codepoint == U' ')
     {
@@ -117,6 +127,68 @@ void TerminalView::paint_cell(
     }
 }
 
+// The backgrounds go first, then the text, in runs of cells drawn the same
+// way, so a whole line of text is blended in one go.
+void TerminalView::paint_row(Graphic::Painter &painter, int y)
+{
+    int run_start = 0;
+    Terminal::Color run_color = Terminal::FOREGROUND;
+    bool run_bold = false;
+
+    auto flush = [&]() {
+        if (_run.empty())
+        {
+            return;
+        }
+
+        auto position = cell_bound(run_start, y).position() + Math::Vec2i(0, 13);
+        painter.draw_text_run(*font(), _run.raw_storage(), _run.count(), position, cell_color(run_color), cell_size().x());
+
+        if (run_bold)
+        {
+            painter.draw_text_run(*font(), _run.raw_storage(), _run.count(), position + Math::Vec2i(1, 0), cell_color(run_color), cell_size().x());
+        }
+
+        _run.clear();
+    };
+
+    for (int x = 0; x < _terminal->width(); x++)
+    {
+        Terminal::Cell cell = _terminal->surface().at(x, y);
+
+        auto foreground = cell.attributes.foreground;
+        auto background = cell.attributes.background;
+
+        if (cell.attributes.invert)
+        {
+            swap(foreground, background);
+        }
+
+        paint_cell_background(painter, cell_bound(x, y), foreground, background, cell.attributes);
+
+        if (cell.codepoint == U' ' || foreground != run_color || cell.attributes.bold != run_bold)
+        {
+            flush();
+        }
+
+        if (cell.codepoint == U' ')
+        {
+            continue;
+        }
+
+        if (_run.empty())
+        {
+            run_start = x;
+            run_color = foreground;
+            run_bold = cell.attributes.bold;
+        }
+
+        _run.push_back(cell.codepoint);
+    }
+
+    flush();
+}
+
 void TerminalView::paint(Graphic::Painter &painter, const Math::Recti &dirty)
 {
     painter.push();
@@ -124,10 +196,10 @@ void TerminalView::paint(Graphic::Painter &painter, const Math::Recti &dirty)
 
     for (int y = 0; y < _terminal->height(); y++)
     {
+        paint_row(painter, y + _scroll_offset / cell_size().y());
+
         for (int x = 0; x < _terminal->width(); x++)
         {
-            Terminal::Cell cell = _terminal->surface().at(x, y + _scroll_offset / cell_size().y());
-            paint_cell(painter, x, y + _scroll_offset / cell_size().y(), cell);
             _terminal->surface().undirty(x, y);
         }
     }
@@ -19,6 +19,9 @@ private:
     OwnPtr<Async::Timer> _cursor_blink_timer;
     OwnPtr<Async::Notifier> _server_notifier;
 
+    // The codepoints of the run of cells being painted.
+    Vector<Codepoint> _run;
+
 public:
     void blink() { _cursor_blink = !_cursor_blink; };
 
@@ -41,6 +44,13 @@ public:
 
     void handle_read();
 
+    void paint_cell_background(
+        Graphic::Painter &painter,
+        Math::Recti bound,
+        Terminal::Color foreground,
+        Terminal::Color background,
+        Terminal::Attributes attributes);
+
     void paint_cell(
         Graphic::Painter &painter,
         int x,
@@ -55,6 +65,8 @@ public:
         paint_cell(painter, x, y, cell.codepoint, cell.attributes.foreground, cell.attributes.background, cell.attributes);
     }
 
+    void paint_row(Graphic::Painter &painter, int y);
+
     void paint(Graphic::Painter &, const Math::Recti &) override;
 
     void event(Widget::Event *event) override;
@@ -0,0 +1,25 @@
+BENCHMARKS_BINARY  = $(BUILD_DIRECTORY_APPS)/benchmarks/benchmarks
+
+BENCHMARKS_SOURCES = $(wildcard userspace/benchmarks/*.cpp) \
+			         $(wildcard userspace/benchmarks/*/*.cpp)
+
+BENCHMARKS_OBJECTS = $(patsubst %.cpp, $(BUILDROOT)/%.o, $(BENCHMARKS_SOURCES))
+
+BENCHMARKS_LIBS = settings graphic async io system c
+
+TARGETS += $(BENCHMARKS_BINARY)
+OBJECTS += $(BENCHMARKS_OBJECTS)
+
+$(BENCHMARKS_BINARY): $(BENCHMARKS_OBJECTS) $(patsubst %, $(BUILD_DIRECTORY_LIBS)/lib%.a, $(BENCHMARKS_LIBS)) $(CRTS)
+	$(DIRECTORY_GUARD)
+	@echo [BENCHMARKS] [LD] benchmarks
+	@$(CXX) $(LDFLAGS) -o $@ $(BENCHMARKS_OBJECTS) $(patsubst %, -l%, $(BENCHMARKS_LIBS))
+	@if $(CONFIG_STRIP); then \
+		echo [BENCHMARKS] [STRIP] benchmarks; \
+		$(STRIP) $@; \
+	fi
+
+$(BUILDROOT)/userspace/benchmarks/%.o: userspace/benchmarks/%.cpp
+	$(DIRECTORY_GUARD)
+	@echo [BENCHMARKS] [CXX] $<
+	@$(CXX) $(CXXFLAGS) -c -o $@ $<
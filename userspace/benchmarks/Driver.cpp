@@ -0,0 +1,96 @@
+#include <abi/Syscalls.h>
+#include <libio/Streams.h>
+#include <libutils/Vector.h>
+#include <string.h>
+
+#include "benchmarks/Driver.h"
+
+namespace Benchmark
+{
+
+static Vector<Benchmark> *_benchmarks;
+
+void __register_benchmark(Benchmark &benchmark)
+{
+    if (!_benchmarks)
+    {
+        _benchmarks = new Vector<Benchmark>();
+    }
+
+    _benchmarks->push_back(benchmark);
+}
+
+Tick now()
+{
+    Tick tick = 0;
+    hj_system_tick(&tick);
+    return tick;
+}
+
+void report(const char *what, size_t amount, const char *unit, Tick elapsed)
+{
+    if (elapsed == 0)
+    {
+        IO::errln("    {}: {} {} in <1ms", what, amount, unit);
+    }
+    else
+    {
+        IO::errln("    {}: {} {} in {}ms ({} {}/s)", what, amount, unit, elapsed, (uint64_t)amount * 1000 / elapsed, unit);
+    }
+}
+
+static bool should_run(const Benchmark &benchmark, int argc, char const *argv[])
+{
+    if (argc <= 1)
+    {
+        return true;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], benchmark.name) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int run_all_benchmarks(int argc, char const *argv[])
+{
+    if (!_benchmarks)
+    {
+        IO::errln("benchmark: No benchmark registered");
+        return PROCESS_SUCCESS;
+    }
+
+    IO::errln("benchmark: Running {} benchmarks\n", _benchmarks->count());
+
+    Tick total = 0;
+
+    for (auto &benchmark : *_benchmarks)
+    {
+        if (!should_run(benchmark, argc, argv))
+        {
+            continue;
+        }
+
+        IO::errln("benchmark: {}: \e[1m{}\e[m", benchmark.location.file(), benchmark.name);
+
+        Tick start = now();
+        benchmark.function();
+        Tick elapsed = now() - start;
+
+        IO::errln("    took \e[1m{}ms\e[m", elapsed);
+
+        total += elapsed;
+    }
+
+    IO::errln("");
+    IO::errln("benchmark: Took \e[1m{}ms\e[m", total);
+
+    return PROCESS_SUCCESS;
+}
+
+} // namespace Benchmark
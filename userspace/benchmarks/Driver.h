@@ -0,0 +1,47 @@
+#pragma once
+
+#include <abi/Time.h>
+#include <libutils/SourceLocation.h>
+
+namespace Benchmark
+{
+
+typedef void (*BenchmarkFunction)();
+
+struct Benchmark;
+
+void __register_benchmark(Benchmark &benchmark);
+
+struct Benchmark
+{
+    const char *name;
+    BenchmarkFunction function;
+    Utils::SourceLocation location;
+
+    Benchmark(const char *name, BenchmarkFunction function, Utils::SourceLocation location = Utils::SourceLocation::current())
+    {
+        this->name = name;
+        this->function = function;
+        this->location = location;
+
+        __register_benchmark(*this);
+    }
+};
+
+#define BENCHMARK(__benchmark_function)                                 \
+    void __benchmark_##__benchmark_function##_function();               \
+    ::Benchmark::Benchmark __benchmark_##__benchmark_function##_object{ \
+        #__benchmark_function,                                          \
+        __benchmark_##__benchmark_function##_function,                  \
+    };                                                                  \
+    void __benchmark_##__benchmark_function##_function()
+
+// Report a throughput figure for the running benchmark, `amount` units of
+// `unit` processed in `elapsed` milliseconds.
+void report(const char *what, size_t amount, const char *unit, Tick elapsed);
+
+Tick now();
+
+int run_all_benchmarks(int argc, char const *argv[]);
+
+} // namespace Benchmark
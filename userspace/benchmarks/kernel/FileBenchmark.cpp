@@ -0,0 +1,55 @@
+#include <libio/File.h>
+#include <libsystem/io/Filesystem.h>
+
+#include "benchmarks/Driver.h"
+
+static constexpr auto FILE_BENCHMARK_PATH = "/User/benchmark-file.tmp";
+
+BENCHMARK(file_append_10mib_in_64_bytes_writes)
+{
+    static constexpr size_t TOTAL_SIZE = 10 * 1024 * 1024;
+    static constexpr size_t WRITE_SIZE = 64;
+
+    char chunk[WRITE_SIZE];
+    memset(chunk, 'x', WRITE_SIZE);
+
+    IO::File file{FILE_BENCHMARK_PATH, OPEN_WRITE | OPEN_CREATE | OPEN_TRUNC};
+
+    Tick start = Benchmark::now();
+
+    for (size_t written = 0; written < TOTAL_SIZE; written += WRITE_SIZE)
+    {
+        file.write(chunk, WRITE_SIZE);
+    }
+
+    Benchmark::report("append", TOTAL_SIZE / 1024, "KiB", Benchmark::now() - start);
+
+    filesystem_unlink(FILE_BENCHMARK_PATH);
+}
+
+BENCHMARK(file_random_offset_writes)
+{
+    static constexpr size_t FILE_SIZE = 4 * 1024 * 1024;
+    static constexpr size_t WRITE_SIZE = 512;
+    static constexpr size_t WRITE_COUNT = 16 * 1024;
+
+    char chunk[WRITE_SIZE];
+    memset(chunk, 'y', WRITE_SIZE);
+
+    IO::File file{FILE_BENCHMARK_PATH, OPEN_WRITE | OPEN_CREATE | OPEN_TRUNC};
+
+    Tick start = Benchmark::now();
+
+    uint32_t seed = 0x5eed;
+
+    for (size_t i = 0; i < WRITE_COUNT; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        file.seek(IO::SeekFrom::start((seed >> 8) % (FILE_SIZE - WRITE_SIZE)));
+        file.write(chunk, WRITE_SIZE);
+    }
+
+    Benchmark::report("random writes", WRITE_COUNT, "writes", Benchmark::now() - start);
+
+    filesystem_unlink(FILE_BENCHMARK_PATH);
+}
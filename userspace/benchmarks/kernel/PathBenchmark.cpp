@@ -0,0 +1,45 @@
+#include <libio/Directory.h>
+#include <libio/Handle.h>
+
+#include "benchmarks/Driver.h"
+
+static void collect_paths(const IO::Path &path, Vector<String> &paths)
+{
+    IO::Directory directory{path};
+
+    for (auto &entry : directory.entries())
+    {
+        auto child = IO::Path::join(path, entry.name);
+
+        if (entry.stat.type == FILE_TYPE_REGULAR)
+        {
+            paths.push_back(child.string());
+        }
+        else if (entry.stat.type == FILE_TYPE_DIRECTORY)
+        {
+            paths.push_back(child.string());
+            collect_paths(child, paths);
+        }
+    }
+}
+
+BENCHMARK(path_lookup_over_the_distro_tree)
+{
+    static constexpr size_t ROUNDS = 16;
+
+    Vector<String> paths{};
+    collect_paths(IO::Path::parse("/"), paths);
+
+    Tick start = Benchmark::now();
+
+    for (size_t round = 0; round < ROUNDS; round++)
+    {
+        for (auto &path : paths)
+        {
+            IO::Handle handle{path, OPEN_READ};
+            handle.stat();
+        }
+    }
+
+    Benchmark::report("lookups", paths.count() * ROUNDS, "paths", Benchmark::now() - start);
+}
@@ -0,0 +1,82 @@
+#include <libio/Format.h>
+#include <libio/Pipe.h>
+#include <libsystem/process/Launchpad.h>
+#include <libsystem/process/Process.h>
+
+#include "benchmarks/Driver.h"
+
+static constexpr size_t PIPE_CAPACITIES[] = {4 * 1024, 64 * 1024, 1024 * 1024};
+
+static constexpr size_t PIPE_BENCHMARK_SIZE = 16 * 1024 * 1024;
+
+static constexpr size_t PIPE_READ_SIZE = 64 * 1024;
+
+static void pipe_from_yes(size_t capacity)
+{
+    auto pipe = IO::Pipe::create(capacity).unwrap();
+
+    auto *launchpad = launchpad_create("yes", "/System/Utilities/yes");
+    launchpad_handle(launchpad, *pipe.writer, 1);
+
+    int pid = -1;
+    launchpad_launch(launchpad, &pid);
+
+    pipe.writer = nullptr;
+
+    static uint8_t buffer[PIPE_READ_SIZE];
+
+    Tick start = Benchmark::now();
+
+    size_t received = 0;
+
+    while (received < PIPE_BENCHMARK_SIZE)
+    {
+        auto read = pipe.reader->read(buffer, PIPE_READ_SIZE);
+
+        if (!read.success() || read.unwrap() == 0)
+        {
+            break;
+        }
+
+        received += read.unwrap();
+    }
+
+    Benchmark::report(IO::format("yes | head, {} KiB pipe", capacity / 1024).cstring(), received / 1024, "KiB", Benchmark::now() - start);
+
+    // Closing the reading end makes yes fail its next write and exit.
+    pipe.reader = nullptr;
+
+    int exit_value;
+    process_wait(pid, &exit_value);
+}
+
+BENCHMARK(pipe_throughput_from_yes)
+{
+    for (auto capacity : PIPE_CAPACITIES)
+    {
+        pipe_from_yes(capacity);
+    }
+}
+
+BENCHMARK(pipe_throughput_of_full_buffers)
+{
+    for (auto capacity : PIPE_CAPACITIES)
+    {
+        auto pipe = IO::Pipe::create(capacity).unwrap();
+
+        // A single task fills the pipe then drains it, so this measures the
+        // cost of moving data through the kernel and nothing else.
+        static uint8_t buffer[1024 * 1024];
+        memset(buffer, 'y', capacity);
+
+        Tick start = Benchmark::now();
+
+        for (size_t moved = 0; moved < PIPE_BENCHMARK_SIZE; moved += capacity)
+        {
+            pipe.writer->write(buffer, capacity);
+            pipe.reader->read(buffer, capacity);
+        }
+
+        Benchmark::report(IO::format("full buffers, {} KiB pipe", capacity / 1024).cstring(), PIPE_BENCHMARK_SIZE / 1024, "KiB", Benchmark::now() - start);
+    }
+}
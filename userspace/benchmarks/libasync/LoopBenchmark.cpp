@@ -0,0 +1,124 @@
+#include <libasync/Loop.h>
+#include <libasync/Notifier.h>
+#include <libasync/Timer.h>
+#include <libio/Format.h>
+#include <libio/Pipe.h>
+#include <libutils/OwnPtr.h>
+#include <libutils/Vector.h>
+
+#include "benchmarks/Driver.h"
+
+static constexpr size_t LOOP_PIPE_COUNT = 50;
+
+static constexpr size_t LOOP_NOTIFIERS_PER_PIPE = 20;
+
+static constexpr size_t LOOP_TIMER_COUNT = 1000;
+
+static constexpr size_t LOOP_HOP_COUNT = 100000;
+
+static constexpr size_t LOOP_PUMP_COUNT = 100000;
+
+struct LoopBenchmarkHandle : public IO::RawHandle
+{
+    RefPtr<IO::Handle> _handle;
+
+    LoopBenchmarkHandle(RefPtr<IO::Handle> handle) : _handle{handle} {}
+
+    RefPtr<IO::Handle> handle() override { return _handle; }
+};
+
+BENCHMARK(loop_notifier_dispatch)
+{
+    Vector<IO::Pipe> pipes;
+    Vector<OwnPtr<LoopBenchmarkHandle>> readers;
+    Vector<OwnPtr<Async::Notifier>> notifiers;
+
+    for (size_t i = 0; i < LOOP_PIPE_COUNT; i++)
+    {
+        pipes.push_back(IO::Pipe::create().unwrap());
+        readers.push_back(own<LoopBenchmarkHandle>(pipes[i].reader));
+    }
+
+    size_t hops = 0;
+    size_t wakeups = 0;
+
+    // A single token goes around a ring of pipes, every pipe is watched by
+    // many notifiers but only the first one moves the token along.
+    for (size_t i = 0; i < LOOP_PIPE_COUNT; i++)
+    {
+        notifiers.push_back(own<Async::Notifier>(*readers[i], POLL_READ, [&, i]() {
+            uint8_t token;
+            pipes[i].reader->read(&token, sizeof(token));
+            pipes[(i + 1) % LOOP_PIPE_COUNT].writer->write(&token, sizeof(token));
+            hops++;
+        }));
+
+        for (size_t j = 1; j < LOOP_NOTIFIERS_PER_PIPE; j++)
+        {
+            notifiers.push_back(own<Async::Notifier>(*readers[i], POLL_READ, [&]() {
+                wakeups++;
+            }));
+        }
+    }
+
+    uint8_t token = 0;
+    pipes[0].writer->write(&token, sizeof(token));
+
+    Tick start = Benchmark::now();
+
+    while (hops < LOOP_HOP_COUNT)
+    {
+        Async::Loop::the()->pump(false);
+    }
+
+    Benchmark::report(IO::format("{} notifiers on {} pipes", notifiers.count(), LOOP_PIPE_COUNT).cstring(), hops, "hops", Benchmark::now() - start);
+}
+
+BENCHMARK(loop_pump_with_idle_timers)
+{
+    Vector<OwnPtr<Async::Timer>> timers;
+
+    for (size_t i = 0; i < LOOP_TIMER_COUNT; i++)
+    {
+        // Far enough in the future to never fire while we measure.
+        auto timer = own<Async::Timer>(60 * 1000 + i, []() {});
+        timer->schedule(Benchmark::now() + timer->interval());
+        timer->start();
+        timers.push_back(move(timer));
+    }
+
+    Tick start = Benchmark::now();
+
+    for (size_t i = 0; i < LOOP_PUMP_COUNT; i++)
+    {
+        Async::Loop::the()->pump(true);
+    }
+
+    Benchmark::report(IO::format("{} idle timers", LOOP_TIMER_COUNT).cstring(), LOOP_PUMP_COUNT, "pumps", Benchmark::now() - start);
+}
+
+BENCHMARK(loop_timer_restart)
+{
+    Vector<OwnPtr<Async::Timer>> timers;
+
+    for (size_t i = 0; i < LOOP_TIMER_COUNT; i++)
+    {
+        auto timer = own<Async::Timer>(60 * 1000 + i, []() {});
+        timer->schedule(Benchmark::now() + timer->interval());
+        timer->start();
+        timers.push_back(move(timer));
+    }
+
+    Tick start = Benchmark::now();
+
+    // Restarting a timer in the middle of the queue is what widgets do on
+    // every keystroke or animation frame.
+    for (size_t i = 0; i < LOOP_PUMP_COUNT; i++)
+    {
+        auto &timer = timers[(i * 7) % LOOP_TIMER_COUNT];
+        timer->stop();
+        timer->start();
+    }
+
+    Benchmark::report(IO::format("{} timers", LOOP_TIMER_COUNT).cstring(), LOOP_PUMP_COUNT, "restarts", Benchmark::now() - start);
+}
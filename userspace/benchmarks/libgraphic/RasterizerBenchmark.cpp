@@ -0,0 +1,296 @@
+#include <libgraphic/rast/Rasterizer.h>
+#include <libio/BufReader.h>
+#include <libio/Directory.h>
+#include <libio/File.h>
+#include <libio/Format.h>
+#include <libio/NumberScanner.h>
+#include <libio/Streams.h>
+#include <libxml/Parser.h>
+
+#include "benchmarks/Driver.h"
+
+// The benchmarks run from the root of the source tree.
+static constexpr auto RASTERIZER_ICONS_PATH = "sysroot/Files/Icons";
+
+static constexpr size_t RASTERIZER_ROUNDS = 8;
+
+struct BenchmarkIcon
+{
+    int size;
+    Vector<Graphic::Path> paths;
+};
+
+static void collect_paths(Xml::Node &node, Vector<Graphic::Path> &paths)
+{
+    for (auto child : node.children())
+    {
+        if (child.name() == "path")
+        {
+            paths.push_back(Graphic::Path::parse(child.attributes()["d"].cstring()));
+        }
+        else if (child.name() == "g")
+        {
+            collect_paths(child, paths);
+        }
+    }
+}
+
+static Vector<BenchmarkIcon> load_icons()
+{
+    Vector<BenchmarkIcon> icons;
+    IO::Directory directory{RASTERIZER_ICONS_PATH};
+
+    for (auto &entry : directory.entries())
+    {
+        IO::File file{IO::format("{}/{}", RASTERIZER_ICONS_PATH, entry.name), OPEN_READ};
+        IO::BufReader reader{file, 512};
+
+        auto document = Xml::parse(reader);
+
+        if (!document.success())
+        {
+            continue;
+        }
+
+        BenchmarkIcon icon{24, {}};
+
+        if (document.unwrap().root().attributes().has_key("width"))
+        {
+            IO::MemoryReader width_reader{document.unwrap().root().attributes()["width"]};
+            IO::Scanner width_scanner{width_reader};
+            icon.size = IO::NumberScanner::decimal().scan_int(width_scanner).unwrap_or(24);
+        }
+
+        collect_paths(document.unwrap().root(), icon.paths);
+        icons.push_back(icon);
+    }
+
+    return icons;
+}
+
+// How Rasterizer::fill flattens a path.
+static void flatten(const Graphic::Path &path, Math::Mat3x2f transform, Graphic::EdgeList &edges)
+{
+    for (auto &subpath : path.subpaths())
+    {
+        for (size_t i = 0; i < subpath.length(); i++)
+        {
+            edges.append(transform.apply(subpath.curves(i)));
+        }
+
+        if (!subpath.closed())
+        {
+            edges.begin();
+            edges.append(transform.apply(subpath.curves(subpath.length() - 1).end()));
+            edges.append(transform.apply(subpath.curves(0).start()));
+            edges.end();
+        }
+    }
+}
+
+// What Rasterizer::rasterize did before the edge table: every edge looked
+// at on every subscanline of the clip, and coverage counted in quarters of
+// pixels.
+static void rasterize_per_subscanline(Graphic::Bitmap &bitmap, Graphic::EdgeList &edges, Graphic::Color color)
+{
+    Vector<Math::Edgef> actives_edges;
+    Vector<uint16_t> coverage;
+    coverage.resize(bitmap.width());
+
+    auto line = [&](float start, float end) {
+        for (float x = start; x < end; x += 1.0f / 4)
+        {
+            if ((int)x < (int)coverage.count())
+            {
+                coverage[(int)x] += 1;
+            }
+        }
+    };
+
+    auto scanline = [&](int start, int end, float y) {
+        actives_edges.clear();
+
+        for (auto &edge : edges.edges())
+        {
+            if (y >= edge.min_y() && y < edge.max_y())
+            {
+                actives_edges.push_back(edge);
+            }
+        }
+
+        actives_edges.sort([&](Math::Edgef &a, Math::Edgef &b) { return a.intersection_y(y).x() - b.intersection_y(y).x(); });
+
+        for (size_t i = 0; i + 1 < actives_edges.count(); i += 2)
+        {
+            line(MAX(actives_edges[i].intersection_y(y).x(), start),
+                 MIN(actives_edges[i + 1].intersection_y(y).x(), end));
+        }
+    };
+
+    auto bound = bitmap.bound();
+
+    for (int y = bound.top(); y < bound.bottom(); y++)
+    {
+        for (int i = bound.left(); i < bound.right(); i++)
+        {
+            coverage[i] = 0;
+        }
+
+        for (float yy = (y - 0.5f); yy < (y + 0.5f); yy += 1.0f / 4)
+        {
+            scanline(bound.left(), bound.right(), yy + 0.5f);
+        }
+
+        for (int i = bound.left(); i < bound.right(); i++)
+        {
+            auto alpha = clamp((coverage[i] / 16.0f), 0, 1);
+
+            if (alpha >= 0.003f)
+            {
+                bitmap.blend_pixel_no_check({i, y}, color.with_alpha(color.alphaf() * alpha));
+            }
+        }
+    }
+}
+
+BENCHMARK(rasterizer_icon_set)
+{
+    auto icons = load_icons();
+
+    if (icons.empty())
+    {
+        IO::errln("    no icons in {}", RASTERIZER_ICONS_PATH);
+        return;
+    }
+
+    for (int size : {24, 48, 256})
+    {
+        Vector<Graphic::Color> pixels;
+        pixels.resize(size * size);
+
+        auto bitmap = Graphic::Bitmap::create_static(size, size, pixels.raw_storage());
+        Graphic::TransformStack stack{bitmap->bound()};
+
+        auto run = [&](const char *name, auto callback) {
+            auto what = IO::format("{} at {}px", name, size);
+            Tick start = Benchmark::now();
+
+            for (size_t round = 0; round < RASTERIZER_ROUNDS; round++)
+            {
+                for (auto &icon : icons)
+                {
+                    bitmap->clear(Graphic::Colors::TRANSPARENT);
+                    callback(icon, Math::Mat3x2f::scale((float)size / icon.size));
+                }
+            }
+
+            Benchmark::report(what.cstring(), icons.count() * RASTERIZER_ROUNDS, "icons", Benchmark::now() - start);
+        };
+
+        run("per subscanline", [&](const BenchmarkIcon &icon, Math::Mat3x2f transform) {
+            for (auto &path : icon.paths)
+            {
+                Graphic::EdgeList edges;
+                flatten(path, transform, edges);
+                rasterize_per_subscanline(*bitmap, edges, Graphic::Colors::BLACK);
+            }
+        });
+
+        run("edge table", [&](const BenchmarkIcon &icon, Math::Mat3x2f transform) {
+            Graphic::Rasterizer rasterizer{*bitmap, stack};
+
+            for (auto &path : icon.paths)
+            {
+                rasterizer.fill(path, transform, Graphic::Fill{Graphic::Colors::BLACK});
+            }
+        });
+    }
+}
+
+static constexpr int RASTERIZER_GRADIENT_SIZE = 1024;
+
+static constexpr size_t RASTERIZER_GRADIENT_FRAMES = 16;
+
+// What the rasterizer did for every pixel before paints were shaded along
+// spans: look for the stops around the pixel and divide.
+static Graphic::Color sample_per_pixel(Graphic::Gradient &gradient, int x, int y)
+{
+    Math::Vec2f p = {
+        x / (float)RASTERIZER_GRADIENT_SIZE,
+        y / (float)RASTERIZER_GRADIENT_SIZE,
+    };
+
+    float v = p.x();
+
+    if (v <= gradient.stops[0].value)
+    {
+        return gradient.stops[0].color;
+    }
+
+    if (v >= gradient.stops[gradient.count - 1].value)
+    {
+        return gradient.stops[gradient.count - 1].color;
+    }
+
+    for (size_t i = 0; i + 1 < gradient.count; i++)
+    {
+        auto s0 = gradient.stops[i];
+        auto s1 = gradient.stops[i + 1];
+
+        if (s0.value <= v && v < s1.value)
+        {
+            return Graphic::Color::lerp(s0.color, s1.color, (v - s0.value) / (s1.value - s0.value));
+        }
+    }
+
+    return gradient.stops[0].color;
+}
+
+BENCHMARK(rasterizer_shade_gradient)
+{
+    Graphic::Gradient gradient{};
+    gradient.stops[0] = {Graphic::Colors::RED, 0};
+    gradient.stops[1] = {Graphic::Colors::YELLOW, 0.3};
+    gradient.stops[2] = {Graphic::Colors::GREEN, 0.6};
+    gradient.stops[3] = {Graphic::Colors::BLUE, 1};
+    gradient.count = 4;
+
+    Vector<Graphic::Color> row;
+    row.resize(RASTERIZER_GRADIENT_SIZE);
+
+    auto run = [&](const char *what, auto callback) {
+        Tick start = Benchmark::now();
+
+        for (size_t frame = 0; frame < RASTERIZER_GRADIENT_FRAMES; frame++)
+        {
+            for (int y = 0; y < RASTERIZER_GRADIENT_SIZE; y++)
+            {
+                callback(y);
+            }
+        }
+
+        Benchmark::report(what, RASTERIZER_GRADIENT_FRAMES, "Mpx", Benchmark::now() - start);
+    };
+
+    run("per pixel", [&](int y) {
+        for (int x = 0; x < RASTERIZER_GRADIENT_SIZE; x++)
+        {
+            row[x] = sample_per_pixel(gradient, x, y).premultiplied();
+        }
+    });
+
+    Graphic::Paint paint = gradient;
+    Graphic::Shader linear{paint, Math::Rectf{RASTERIZER_GRADIENT_SIZE, RASTERIZER_GRADIENT_SIZE}};
+
+    run("linear along spans", [&](int y) {
+        linear.shade(row.raw_storage(), 0, y, RASTERIZER_GRADIENT_SIZE);
+    });
+
+    gradient.shape = Graphic::GradientShape::RADIAL;
+    paint = gradient;
+    Graphic::Shader radial{paint, Math::Rectf{RASTERIZER_GRADIENT_SIZE, RASTERIZER_GRADIENT_SIZE}};
+
+    run("radial along spans", [&](int y) {
+        radial.shade(row.raw_storage(), 0, y, RASTERIZER_GRADIENT_SIZE);
+    });
+}
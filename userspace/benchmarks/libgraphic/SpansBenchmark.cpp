@@ -0,0 +1,255 @@
+#include <libgraphic/Spans.h>
+#include <libutils/Vector.h>
+#include <string.h>
+
+#include "benchmarks/Driver.h"
+
+// A frame is 1024x1024, so the figures below are in 2^20 pixels.
+static constexpr int SPANS_FRAME_SIZE = 1024;
+
+static constexpr size_t SPANS_FRAME_COUNT = 64;
+
+static const Graphic::SpanIsa SPANS_BENCHMARK_ISAS[] = {
+    Graphic::SpanIsa::SCALAR,
+    Graphic::SpanIsa::SSE2,
+    Graphic::SpanIsa::AVX2,
+};
+
+// Something that looks like a window: opaque, with translucent rounded
+// corners and a shadow along the edges.
+static Vector<Graphic::Color> window_pixels()
+{
+    Vector<Graphic::Color> pixels;
+    pixels.resize(SPANS_FRAME_SIZE * SPANS_FRAME_SIZE);
+
+    for (int y = 0; y < SPANS_FRAME_SIZE; y++)
+    {
+        for (int x = 0; x < SPANS_FRAME_SIZE; x++)
+        {
+            int edge = MIN(MIN(x, y), MIN(SPANS_FRAME_SIZE - 1 - x, SPANS_FRAME_SIZE - 1 - y));
+            uint8_t alpha = edge < 16 ? edge * 16 : 0xff;
+
+            pixels[y * SPANS_FRAME_SIZE + x] = Graphic::Color::from_rgba_byte(x, y, x ^ y, alpha);
+        }
+    }
+
+    return pixels;
+}
+
+static Vector<Graphic::Color> wallpaper_pixels()
+{
+    Vector<Graphic::Color> pixels;
+    pixels.resize(SPANS_FRAME_SIZE * SPANS_FRAME_SIZE);
+
+    for (int i = 0; i < SPANS_FRAME_SIZE * SPANS_FRAME_SIZE; i++)
+    {
+        pixels[i] = Graphic::Color::from_rgb_byte(i, i >> 8, i >> 16);
+    }
+
+    return pixels;
+}
+
+// What Painter::blit_fast did before going through spans.
+static void blit_per_pixel(Graphic::Color *destination, const Graphic::Color *source)
+{
+    for (int y = 0; y < SPANS_FRAME_SIZE; y++)
+    {
+        for (int x = 0; x < SPANS_FRAME_SIZE; x++)
+        {
+            auto sample = source[clamp(y, 0, SPANS_FRAME_SIZE - 1) * SPANS_FRAME_SIZE + clamp(x, 0, SPANS_FRAME_SIZE - 1)];
+            auto &pixel = destination[clamp(y, 0, SPANS_FRAME_SIZE - 1) * SPANS_FRAME_SIZE + clamp(x, 0, SPANS_FRAME_SIZE - 1)];
+            pixel = Graphic::Color::blend(sample, pixel);
+        }
+    }
+}
+
+template <typename TCallback>
+static void run_frames(const char *what, TCallback callback)
+{
+    Tick start = Benchmark::now();
+
+    for (size_t i = 0; i < SPANS_FRAME_COUNT; i++)
+    {
+        callback();
+    }
+
+    Benchmark::report(what, SPANS_FRAME_COUNT, "Mpx", Benchmark::now() - start);
+}
+
+BENCHMARK(spans_blit_window)
+{
+    auto window = window_pixels();
+    auto framebuffer = wallpaper_pixels();
+
+    run_frames("per-pixel", [&]() {
+        blit_per_pixel(framebuffer.raw_storage(), window.raw_storage());
+    });
+
+    for (auto isa : SPANS_BENCHMARK_ISAS)
+    {
+        auto *kernels = Graphic::span_kernels(isa);
+
+        if (kernels == nullptr)
+        {
+            continue;
+        }
+
+        run_frames(kernels->name, [&]() {
+            for (int y = 0; y < SPANS_FRAME_SIZE; y++)
+            {
+                kernels->blend(framebuffer.raw_storage() + y * SPANS_FRAME_SIZE, window.raw_storage() + y * SPANS_FRAME_SIZE, SPANS_FRAME_SIZE);
+            }
+        });
+    }
+}
+
+BENCHMARK(spans_copy_wallpaper)
+{
+    auto wallpaper = wallpaper_pixels();
+    auto framebuffer = wallpaper_pixels();
+
+    run_frames("per-pixel", [&]() {
+        blit_per_pixel(framebuffer.raw_storage(), wallpaper.raw_storage());
+    });
+
+    for (auto isa : SPANS_BENCHMARK_ISAS)
+    {
+        auto *kernels = Graphic::span_kernels(isa);
+
+        if (kernels == nullptr)
+        {
+            continue;
+        }
+
+        run_frames(kernels->name, [&]() {
+            for (int y = 0; y < SPANS_FRAME_SIZE; y++)
+            {
+                kernels->copy(framebuffer.raw_storage() + y * SPANS_FRAME_SIZE, wallpaper.raw_storage() + y * SPANS_FRAME_SIZE, SPANS_FRAME_SIZE);
+            }
+        });
+    }
+}
+
+BENCHMARK(spans_fill_translucent_rectangle)
+{
+    auto framebuffer = wallpaper_pixels();
+    auto color = Graphic::Color::from_rgba_byte(0x12, 0x34, 0x56, 0x80);
+
+    run_frames("per-pixel", [&]() {
+        for (int i = 0; i < SPANS_FRAME_SIZE * SPANS_FRAME_SIZE; i++)
+        {
+            framebuffer[i] = Graphic::Color::blend(color, framebuffer[i]);
+        }
+    });
+
+    for (auto isa : SPANS_BENCHMARK_ISAS)
+    {
+        auto *kernels = Graphic::span_kernels(isa);
+
+        if (kernels == nullptr)
+        {
+            continue;
+        }
+
+        run_frames(kernels->name, [&]() {
+            for (int y = 0; y < SPANS_FRAME_SIZE; y++)
+            {
+                kernels->blend_color(framebuffer.raw_storage() + y * SPANS_FRAME_SIZE, color, SPANS_FRAME_SIZE);
+            }
+        });
+    }
+}
+
+BENCHMARK(spans_blend_premultiplied)
+{
+    auto window = window_pixels();
+    auto framebuffer = wallpaper_pixels();
+
+    for (size_t i = 0; i < window.count(); i++)
+    {
+        window[i] = window[i].premultiplied();
+    }
+
+    for (auto isa : SPANS_BENCHMARK_ISAS)
+    {
+        auto *kernels = Graphic::span_kernels(isa);
+
+        if (kernels == nullptr)
+        {
+            continue;
+        }
+
+        run_frames(kernels->name, [&]() {
+            for (int y = 0; y < SPANS_FRAME_SIZE; y++)
+            {
+                kernels->blend_premultiplied(framebuffer.raw_storage() + y * SPANS_FRAME_SIZE, window.raw_storage() + y * SPANS_FRAME_SIZE, SPANS_FRAME_SIZE);
+            }
+        });
+    }
+}
+
+BENCHMARK(spans_fill_translucent_rectangle_premultiplied)
+{
+    auto framebuffer = wallpaper_pixels();
+    auto color = Graphic::Color::from_rgba_byte(0x12, 0x34, 0x56, 0x80).premultiplied();
+
+    for (auto isa : SPANS_BENCHMARK_ISAS)
+    {
+        auto *kernels = Graphic::span_kernels(isa);
+
+        if (kernels == nullptr)
+        {
+            continue;
+        }
+
+        run_frames(kernels->name, [&]() {
+            for (int y = 0; y < SPANS_FRAME_SIZE; y++)
+            {
+                kernels->blend_color_premultiplied(framebuffer.raw_storage() + y * SPANS_FRAME_SIZE, color, SPANS_FRAME_SIZE);
+            }
+        });
+    }
+}
+
+// What the kernel does for every pixel when the framebuffer isn't mapped.
+static void swizzle_per_pixel(uint32_t *destination, const Graphic::Color *source)
+{
+    for (int i = 0; i < SPANS_FRAME_SIZE * SPANS_FRAME_SIZE; i++)
+    {
+        uint32_t pixel;
+        memcpy(&pixel, &source[i], sizeof(pixel));
+
+        destination[i] = ((pixel >> 16) & 0x000000ff) |
+                         (pixel & 0xff00ff00) |
+                         ((pixel << 16) & 0x00ff0000);
+    }
+}
+
+BENCHMARK(spans_swizzle_scanout)
+{
+    auto frame = window_pixels();
+
+    Vector<uint32_t> scanout;
+    scanout.resize(SPANS_FRAME_SIZE * SPANS_FRAME_SIZE);
+
+    run_frames("per-pixel", [&]() {
+        swizzle_per_pixel(scanout.raw_storage(), frame.raw_storage());
+    });
+
+    for (auto isa : SPANS_BENCHMARK_ISAS)
+    {
+        auto *kernels = Graphic::span_kernels(isa);
+
+        if (kernels == nullptr)
+        {
+            continue;
+        }
+
+        run_frames(kernels->name, [&]() {
+            for (int y = 0; y < SPANS_FRAME_SIZE; y++)
+            {
+                kernels->swizzle(scanout.raw_storage() + y * SPANS_FRAME_SIZE, frame.raw_storage() + y * SPANS_FRAME_SIZE, SPANS_FRAME_SIZE);
+            }
+        });
+    }
+}
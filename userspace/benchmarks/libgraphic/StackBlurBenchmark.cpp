@@ -0,0 +1,71 @@
+#include <libgraphic/StackBlur.h>
+#include <libio/Format.h>
+#include <libutils/Vector.h>
+
+#include "benchmarks/Driver.h"
+
+// A frame is 1024x1024, so the figures below are in 2^20 pixels.
+static constexpr int BLUR_FRAME_SIZE = 1024;
+
+static constexpr size_t BLUR_FRAME_COUNT = 16;
+
+static const Graphic::SpanIsa BLUR_BENCHMARK_ISAS[] = {
+    Graphic::SpanIsa::SCALAR,
+    Graphic::SpanIsa::SSE2,
+};
+
+static Vector<Graphic::Color> frame_pixels()
+{
+    Vector<Graphic::Color> pixels;
+    pixels.resize(BLUR_FRAME_SIZE * BLUR_FRAME_SIZE);
+
+    for (int i = 0; i < BLUR_FRAME_SIZE * BLUR_FRAME_SIZE; i++)
+    {
+        pixels[i] = Graphic::Color::from_rgb_byte(i, i >> 8, i >> 16);
+    }
+
+    return pixels;
+}
+
+template <typename TCallback>
+static void run_frames(const char *what, TCallback callback)
+{
+    Tick start = Benchmark::now();
+
+    for (size_t i = 0; i < BLUR_FRAME_COUNT; i++)
+    {
+        callback();
+    }
+
+    Benchmark::report(what, BLUR_FRAME_COUNT, "Mpx", Benchmark::now() - start);
+}
+
+BENCHMARK(stackblur_radius)
+{
+    auto pixels = frame_pixels();
+
+    for (auto isa : BLUR_BENCHMARK_ISAS)
+    {
+        auto *kernels = Graphic::span_kernels(isa);
+
+        if (kernels == nullptr)
+        {
+            continue;
+        }
+
+        for (unsigned radius : {4u, 16u, 64u})
+        {
+            auto what = IO::format("{} radius {}", kernels->name, radius);
+
+            run_frames(what.cstring(), [&]() {
+                Graphic::stackblur(
+                    (unsigned char *)pixels.raw_storage(),
+                    BLUR_FRAME_SIZE, BLUR_FRAME_SIZE,
+                    radius,
+                    0, BLUR_FRAME_SIZE,
+                    0, BLUR_FRAME_SIZE,
+                    isa);
+            });
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#include <libgraphic/Painter.h>
+#include <libio/File.h>
+#include <libio/Read.h>
+
+#include "benchmarks/Driver.h"
+
+// The benchmarks run from the root of the source tree.
+static constexpr auto TEXT_FONT_GLYPHS = "sysroot/Files/Fonts/mono.glyph";
+static constexpr auto TEXT_FONT_BITMAP = "sysroot/Files/Fonts/mono.png";
+
+static constexpr int TEXT_COLUMNS = 80;
+static constexpr int TEXT_ROWS = 25;
+static constexpr int TEXT_CELL_WIDTH = 7;
+static constexpr int TEXT_CELL_HEIGHT = 16;
+
+static constexpr size_t TEXT_SCREENS = 64;
+
+// How glyphs were found and drawn before the font had an index: a walk
+// through all of them, then a sample and a blend per pixel.
+static void text_draw_glyph_per_pixel(Graphic::Bitmap &bitmap, Graphic::Font &font, const Vector<Graphic::Glyph> &glyphs, Codepoint codepoint, Math::Vec2i position, Graphic::Color color)
+{
+    const Graphic::Glyph *found = nullptr;
+
+    for (auto &glyph : glyphs)
+    {
+        if (glyph.codepoint == codepoint)
+        {
+            found = &glyph;
+            break;
+        }
+    }
+
+    auto &glyph = found ? *found : font.glyph(U'?');
+    Math::Recti destination{position - glyph.origin, glyph.bound.size()};
+
+    for (int y = 0; y < destination.height(); y++)
+    {
+        for (int x = 0; x < destination.width(); x++)
+        {
+            Math::Vec2f sample_point(
+                x / (double)destination.width(),
+                y / (double)destination.height());
+
+            auto sample = font.bitmap().sample(glyph.bound, sample_point);
+            bitmap.blend_pixel(destination.position() + Math::Vec2i(x, y), color.with_alpha(sample.redf() * color.alphaf()));
+        }
+    }
+}
+
+BENCHMARK(text_terminal_screen)
+{
+    IO::File glyph_file{TEXT_FONT_GLYPHS, OPEN_READ};
+
+    Vector<Graphic::Glyph> glyphs;
+    IO::read_vector(glyph_file, glyphs).unwrap();
+
+    auto font = make<Graphic::Font>(Graphic::Bitmap::load_from(TEXT_FONT_BITMAP).unwrap(), glyphs);
+
+    // Mostly ascii with some box drawing, like what a shell prints.
+    Vector<Codepoint> text;
+
+    for (int i = 0; i < TEXT_COLUMNS * TEXT_ROWS; i++)
+    {
+        text.push_back(i % 13 == 0 ? 0x2500 : (Codepoint)(U'!' + (i * 7) % 94));
+    }
+
+    Vector<Graphic::Color> pixels;
+    pixels.resize(TEXT_COLUMNS * TEXT_CELL_WIDTH * TEXT_ROWS * TEXT_CELL_HEIGHT);
+    auto bitmap = Graphic::Bitmap::create_static(TEXT_COLUMNS * TEXT_CELL_WIDTH, TEXT_ROWS * TEXT_CELL_HEIGHT, pixels.raw_storage());
+
+    Graphic::Painter painter{*bitmap};
+    auto color = Graphic::Color::from_rgb_byte(220, 220, 200);
+
+    auto run = [&](const char *what, auto callback) {
+        Tick start = Benchmark::now();
+
+        for (size_t i = 0; i < TEXT_SCREENS; i++)
+        {
+            painter.clear(Graphic::Colors::BLACK);
+
+            for (int row = 0; row < TEXT_ROWS; row++)
+            {
+                callback(row, Math::Vec2i{0, row * TEXT_CELL_HEIGHT + 12});
+            }
+        }
+
+        Benchmark::report(what, TEXT_SCREENS * TEXT_COLUMNS * TEXT_ROWS, "glyphs", Benchmark::now() - start);
+    };
+
+    run("per pixel", [&](int row, Math::Vec2i position) {
+        for (int column = 0; column < TEXT_COLUMNS; column++)
+        {
+            text_draw_glyph_per_pixel(*bitmap, *font, glyphs, text[row * TEXT_COLUMNS + column], position + Math::Vec2i{column * TEXT_CELL_WIDTH, 0}, color);
+        }
+    });
+
+    run("per glyph", [&](int row, Math::Vec2i position) {
+        for (int column = 0; column < TEXT_COLUMNS; column++)
+        {
+            painter.draw_glyph(*font, font->glyph(text[row * TEXT_COLUMNS + column]), position + Math::Vec2i{column * TEXT_CELL_WIDTH, 0}, color);
+        }
+    });
+
+    run("per run", [&](int row, Math::Vec2i position) {
+        painter.draw_text_run(*font, &text[row * TEXT_COLUMNS], TEXT_COLUMNS, position, color, TEXT_CELL_WIDTH);
+    });
+}
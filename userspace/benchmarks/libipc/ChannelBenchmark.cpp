@@ -0,0 +1,101 @@
+#include <libasync/Loop.h>
+#include <libio/Format.h>
+#include <libio/Socket.h>
+#include <libipc/Channel.h>
+#include <libsettings/ServerConnection.h>
+
+#include "benchmarks/Driver.h"
+#include "compositor/Protocol.h"
+
+static constexpr size_t ROUND_TRIPS = 10000;
+
+BENCHMARK(ipc_settings_round_trips)
+{
+    for (bool shared : {false, true})
+    {
+        auto server = Settings::ServerConnection::open(shared);
+
+        Settings::Message message;
+        message.type = Settings::Message::CLIENT_READ;
+        message.path = Settings::Path::parse("appearance:widgets.theme");
+
+        Tick start = Benchmark::now();
+
+        for (size_t i = 0; i < ROUND_TRIPS; i++)
+        {
+            server->request_and_wait(message);
+        }
+
+        Benchmark::report(shared ? "settings over a shared ring" : "settings over the connection", ROUND_TRIPS, "round trips", Benchmark::now() - start);
+    }
+}
+
+BENCHMARK(ipc_settings_pipelined_reads)
+{
+    static constexpr size_t IN_FLIGHT = 64;
+
+    auto server = Settings::ServerConnection::open();
+
+    Settings::Message message;
+    message.type = Settings::Message::CLIENT_READ;
+    message.path = Settings::Path::parse("appearance:widgets.theme");
+
+    size_t sent = 0;
+    size_t completed = 0;
+
+    Tick start = Benchmark::now();
+
+    // Keep a window of requests in flight instead of waiting for each
+    // answer, the responses complete from the event loop.
+    while (completed < ROUND_TRIPS && server->connected())
+    {
+        while (sent < ROUND_TRIPS && sent - completed < IN_FLIGHT)
+        {
+            server->request(message, [&](auto) { completed++; });
+            sent++;
+        }
+
+        Async::Loop::the()->pump(false);
+    }
+
+    Benchmark::report(IO::format("settings, {} requests in flight", IN_FLIGHT).cstring(), completed, "requests", Benchmark::now() - start);
+}
+
+static ResultOr<CompositorMessage> wait_for(IPC::Channel &channel, CompositorMessageType type)
+{
+    CompositorMessage message{};
+
+    do
+    {
+        TRY(CompositorSchema::read(channel, message));
+    } while (message.type != type);
+
+    return message;
+}
+
+BENCHMARK(ipc_compositor_round_trips)
+{
+    for (bool shared : {false, true})
+    {
+        IPC::Channel channel{IO::Socket::connect("/Session/compositor.ipc").unwrap(), shared};
+
+        wait_for(channel, COMPOSITOR_MESSAGE_GREETINGS);
+
+        CompositorMessage message{};
+        message.type = COMPOSITOR_MESSAGE_GET_MOUSE_POSITION;
+
+        Tick start = Benchmark::now();
+
+        for (size_t i = 0; i < ROUND_TRIPS; i++)
+        {
+            CompositorSchema::write(channel, message);
+            wait_for(channel, COMPOSITOR_MESSAGE_MOUSE_POSITION);
+        }
+
+        Benchmark::report(shared ? "compositor over a shared ring" : "compositor over the connection", ROUND_TRIPS, "round trips", Benchmark::now() - start);
+
+        message.type = COMPOSITOR_MESSAGE_GOODBYE;
+        CompositorSchema::write(channel, message);
+        wait_for(channel, COMPOSITOR_MESSAGE_ACK);
+    }
+}
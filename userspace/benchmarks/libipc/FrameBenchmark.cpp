@@ -0,0 +1,167 @@
+#include <libio/Streams.h>
+#include <libsettings/Protocol.h>
+#include <string.h>
+
+#include "benchmarks/Driver.h"
+#include "compositor/Protocol.h"
+
+static constexpr size_t FRAME_ITERATIONS = 100000;
+
+// Keeps everything written to it so it can be read back, and counts the
+// calls that would each be a syscall on a connection.
+struct LoopbackStream :
+    public IO::Reader,
+    public IO::Writer
+{
+    Vector<uint8_t> data;
+    size_t offset = 0;
+    size_t writes = 0;
+    size_t reads = 0;
+
+    ResultOr<size_t> read(void *buffer, size_t size) override
+    {
+        reads++;
+
+        size_t read = MIN(size, data.count() - offset);
+        memcpy(buffer, data.raw_storage() + offset, read);
+        offset += read;
+
+        return read;
+    }
+
+    ResultOr<size_t> write(const void *buffer, size_t size) override
+    {
+        IOVector vector{const_cast<void *>(buffer), size};
+        return writev(&vector, 1);
+    }
+
+    ResultOr<size_t> writev(const IOVector *vectors, size_t count) override
+    {
+        writes++;
+
+        size_t written = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            data.push_back_many(reinterpret_cast<const uint8_t *>(vectors[i].buffer), vectors[i].size);
+            written += vectors[i].size;
+        }
+
+        return written;
+    }
+
+    void clear()
+    {
+        data.clear();
+        offset = 0;
+        writes = 0;
+        reads = 0;
+    }
+};
+
+static void report_frame(const char *what, LoopbackStream &stream)
+{
+    IO::errln("    {}: {} bytes, {} writes, {} reads", what, stream.data.count(), stream.writes, stream.reads);
+}
+
+static void measure_compositor(const char *what, const CompositorMessage &message)
+{
+    LoopbackStream stream;
+    CompositorSchema::write(stream, message);
+
+    CompositorMessage decoded{};
+    CompositorSchema::read(stream, decoded);
+
+    IO::errln("    {}: {} bytes (was {}), {} writes, {} reads", what, stream.data.count(), sizeof(CompositorMessage), stream.writes, stream.reads);
+}
+
+BENCHMARK(ipc_compositor_frame_sizes)
+{
+    CompositorMessage message{};
+
+    message.type = COMPOSITOR_MESSAGE_ACK;
+    measure_compositor("ack", message);
+
+    message.type = COMPOSITOR_MESSAGE_MOVE_WINDOW;
+    measure_compositor("move window", message);
+
+    message = {};
+    message.type = COMPOSITOR_MESSAGE_FLIP_WINDOW;
+    message.flip_window.dirty_count = 1;
+    measure_compositor("flip window, 1 rectangle", message);
+
+    message.flip_window.dirty_count = WINDOW_DIRTY_MAX;
+    measure_compositor("flip window, full damage list", message);
+
+    message = {};
+    message.type = COMPOSITOR_MESSAGE_EVENT_WINDOW;
+    message.event_window.count = 1;
+    measure_compositor("one window event", message);
+
+    message.event_window.count = WINDOW_EVENTS_MAX;
+    measure_compositor("full batch of window events", message);
+}
+
+BENCHMARK(ipc_compositor_frame_throughput)
+{
+    CompositorMessage message{};
+    message.type = COMPOSITOR_MESSAGE_FLIP_WINDOW;
+    message.flip_window.dirty_count = 2;
+
+    LoopbackStream stream;
+    CompositorMessage decoded{};
+
+    Tick start = Benchmark::now();
+
+    for (size_t i = 0; i < FRAME_ITERATIONS; i++)
+    {
+        stream.clear();
+        CompositorSchema::write(stream, message);
+        CompositorSchema::read(stream, decoded);
+    }
+
+    Benchmark::report("flip window round trips", FRAME_ITERATIONS, "messages", Benchmark::now() - start);
+}
+
+BENCHMARK(ipc_settings_frame_sizes)
+{
+    Settings::Protocol client;
+    Settings::Protocol server;
+    LoopbackStream stream;
+
+    Settings::Message read;
+    read.type = Settings::Message::CLIENT_READ;
+    read.path = Settings::Path::parse("appearance:widgets.theme");
+
+    Settings::Message value;
+    value.type = Settings::Message::SERVER_VALUE;
+    value.path = read.path;
+    value.payload = Json::Value{"skift-dark"};
+
+    // The first request goes out as text and tells the server we can read
+    // binary, everything after that is binary.
+    client.encode_message(stream, read);
+    server.decode_message(stream);
+    report_frame("read request, text", stream);
+
+    stream.clear();
+    server.encode_message(stream, value);
+    client.decode_message(stream);
+    report_frame("value, binary", stream);
+
+    stream.clear();
+    client.encode_message(stream, read);
+    server.decode_message(stream);
+    report_frame("read request, binary", stream);
+
+    Tick start = Benchmark::now();
+
+    for (size_t i = 0; i < FRAME_ITERATIONS; i++)
+    {
+        stream.clear();
+        server.encode_message(stream, value);
+        client.decode_message(stream);
+    }
+
+    Benchmark::report("settings values", FRAME_ITERATIONS, "messages", Benchmark::now() - start);
+}
@@ -0,0 +1,84 @@
+#include <libjson/Binary.h>
+#include <libjson/Json.h>
+
+#include "benchmarks/Driver.h"
+
+static constexpr size_t JSON_BENCHMARK_ITERATIONS = 20000;
+
+static Json::Value settings_payload()
+{
+    Json::Value::Object night_light;
+    night_light["enable"] = true;
+    night_light["strength"] = 0.42;
+
+    Json::Value::Object appearance;
+    appearance["theme"] = "skift-dark";
+    appearance["wallpaper"] = "/Files/Wallpapers/paint.png";
+    appearance["scaling"] = (int64_t)1;
+    appearance["night-light"] = move(night_light);
+
+    return move(appearance);
+}
+
+BENCHMARK(json_encode_text_vs_binary)
+{
+    auto value = settings_payload();
+    size_t bytes = 0;
+
+    Tick start = Benchmark::now();
+
+    for (size_t i = 0; i < JSON_BENCHMARK_ITERATIONS; i++)
+    {
+        Prettifier pretty;
+        Json::prettify(pretty, value);
+        bytes += pretty.finalize().length();
+    }
+
+    Benchmark::report("text", JSON_BENCHMARK_ITERATIONS, "values", Benchmark::now() - start);
+    Benchmark::report("text", bytes / 1024, "KiB", Benchmark::now() - start);
+
+    Json::BinaryWriter writer;
+    bytes = 0;
+
+    start = Benchmark::now();
+
+    for (size_t i = 0; i < JSON_BENCHMARK_ITERATIONS; i++)
+    {
+        writer.clear();
+        writer.write(value);
+        bytes += writer.size();
+    }
+
+    Benchmark::report("binary", JSON_BENCHMARK_ITERATIONS, "values", Benchmark::now() - start);
+    Benchmark::report("binary", bytes / 1024, "KiB", Benchmark::now() - start);
+}
+
+BENCHMARK(json_decode_text_vs_binary)
+{
+    auto value = settings_payload();
+
+    Prettifier pretty;
+    Json::prettify(pretty, value);
+    auto text = pretty.finalize();
+
+    Tick start = Benchmark::now();
+
+    for (size_t i = 0; i < JSON_BENCHMARK_ITERATIONS; i++)
+    {
+        Json::parse(text.cstring(), text.length());
+    }
+
+    Benchmark::report("text", JSON_BENCHMARK_ITERATIONS, "values", Benchmark::now() - start);
+
+    Json::BinaryWriter writer;
+    writer.write(value);
+
+    start = Benchmark::now();
+
+    for (size_t i = 0; i < JSON_BENCHMARK_ITERATIONS; i++)
+    {
+        Json::decode_binary(writer.data(), writer.size());
+    }
+
+    Benchmark::report("binary", JSON_BENCHMARK_ITERATIONS, "values", Benchmark::now() - start);
+}
@@ -7,6 +7,9 @@
 #define PATH_DEPTH (16)
 #define PATH_SEPARATOR '/'
 
+// Maximum number of entries returned by a single hj_handle_list().
+#define DIRECTORY_LIST_MAX (1024)
+
 enum HjWhence
 {
     HJ_WHENCE_START,
@@ -25,6 +28,7 @@ enum FileType
     FILE_TYPE_SOCKET,
     FILE_TYPE_CONNECTION,
     FILE_TYPE_TERMINAL,
+    FILE_TYPE_POLLSET,
 };
 
 #define OPEN_READ (1 << 0)
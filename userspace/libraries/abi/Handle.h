@@ -25,6 +25,23 @@ struct HandlePoll
     PollEvent result;
 };
 
+enum PollSetControl
+{
+    POLLSET_ADD,
+    POLLSET_MODIFY,
+    POLLSET_REMOVE,
+};
+
+// One buffer of a scatter/gather transfer.
+struct IOVector
+{
+    void *buffer;
+    size_t size;
+};
+
+// Maximum number of buffers in a single hj_handle_readv()/hj_handle_writev().
+#define IOVECTOR_MAX (16)
+
 #define HANDLE_INVALID_ID (-1)
 
 #define HANDLE(__subclass) ((Handle *)(__subclass))
@@ -26,6 +26,16 @@ struct IOCallDisplayBlitArgs
     int blit_height;
 };
 
+// Memory the display scans out of, to be mapped with memory_include. Pixels
+// are 32 bits with blue first, and rows are `pitch` bytes apart.
+struct IOCallDisplayMapArgs
+{
+    int handle;
+    int width;
+    int height;
+    int pitch;
+};
+
 struct IOCallKeyboardSetKeymapArgs
 {
     void *keymap;
@@ -45,6 +55,14 @@ struct IOCallNetworkSateAgs
     MacAddress mac_address;
 };
 
+// Pipes and connections can buffer up to this many bytes in each direction.
+#define PIPE_CAPACITY_MAX (1024 * 1024)
+
+struct IOCallPipeCapacityArgs
+{
+    size_t capacity;
+};
+
 enum IOCall
 {
     IOCALL_TERMINAL_GET_SIZE,
@@ -62,5 +80,10 @@ enum IOCall
 
     IOCALL_NETWORK_GET_STATE,
 
+    IOCALL_PIPE_GET_CAPACITY,
+    IOCALL_PIPE_SET_CAPACITY,
+
+    IOCALL_DISPLAY_MAP,
+
     __IOCALL_COUNT,
 };
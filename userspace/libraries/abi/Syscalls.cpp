@@ -159,6 +159,21 @@ Result hj_create_term(int *server_handle, int *client_handle)
     return __syscall(HJ_CREATE_TERM, (uintptr_t)server_handle, (uintptr_t)client_handle);
 }
 
+Result hj_create_pollset(int *handle)
+{
+    return __syscall(HJ_CREATE_POLLSET, (uintptr_t)handle);
+}
+
+Result hj_pollset_control(int pollset, PollSetControl control, int handle, PollEvent events)
+{
+    return __syscall(HJ_POLLSET_CONTROL, pollset, control, handle, events);
+}
+
+Result hj_pollset_wait(int pollset, HandlePoll *ready, size_t count, size_t *ready_count, Timeout timeout)
+{
+    return __syscall(HJ_POLLSET_WAIT, pollset, (uintptr_t)ready, count, (uintptr_t)ready_count, timeout);
+}
+
 Result hj_handle_open(int *handle, const char *raw_path, size_t size, OpenFlag flags)
 {
     return __syscall(HJ_HANDLE_OPEN, (uintptr_t)handle, (uintptr_t)raw_path, (uintptr_t)size, flags);
@@ -189,6 +204,36 @@ Result hj_handle_read(int handle, void *buffer, size_t size, size_t *read)
     return __syscall(HJ_HANDLE_READ, (uintptr_t)handle, (uintptr_t)buffer, (uintptr_t)size, (uintptr_t)read);
 }
 
+Result hj_handle_readv(int handle, const IOVector *vectors, size_t count, size_t *read)
+{
+    return __syscall(HJ_HANDLE_READV, (uintptr_t)handle, (uintptr_t)vectors, (uintptr_t)count, (uintptr_t)read);
+}
+
+Result hj_handle_writev(int handle, const IOVector *vectors, size_t count, size_t *written)
+{
+    return __syscall(HJ_HANDLE_WRITEV, (uintptr_t)handle, (uintptr_t)vectors, (uintptr_t)count, (uintptr_t)written);
+}
+
+Result hj_handle_pread(int handle, void *buffer, size_t size, ssize64_t *offset, size_t *read)
+{
+    return __syscall(HJ_HANDLE_PREAD, (uintptr_t)handle, (uintptr_t)buffer, (uintptr_t)size, (uintptr_t)offset, (uintptr_t)read);
+}
+
+Result hj_handle_pwrite(int handle, const void *buffer, size_t size, ssize64_t *offset, size_t *written)
+{
+    return __syscall(HJ_HANDLE_PWRITE, (uintptr_t)handle, (uintptr_t)buffer, (uintptr_t)size, (uintptr_t)offset, (uintptr_t)written);
+}
+
+Result hj_handle_list(int handle, DirectoryEntry *entries, size_t count, size_t *listed)
+{
+    return __syscall(HJ_HANDLE_LIST, (uintptr_t)handle, (uintptr_t)entries, (uintptr_t)count, (uintptr_t)listed);
+}
+
+Result hj_handle_splice(int source, int destination, size_t size, size_t *spliced)
+{
+    return __syscall(HJ_HANDLE_SPLICE, (uintptr_t)source, (uintptr_t)destination, (uintptr_t)size, (uintptr_t)spliced);
+}
+
 Result hj_handle_write(int handle, const void *buffer, size_t size, size_t *written)
 {
     return __syscall(HJ_HANDLE_WRITE, (uintptr_t)handle, (uintptr_t)buffer, (uintptr_t)size, (uintptr_t)written);
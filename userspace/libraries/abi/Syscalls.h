@@ -49,7 +49,16 @@
     __ENTRY(HJ_HANDLE_CONNECT)    \
     __ENTRY(HJ_HANDLE_ACCEPT)     \
     __ENTRY(HJ_CREATE_PIPE)       \
-    __ENTRY(HJ_CREATE_TERM)
+    __ENTRY(HJ_CREATE_TERM)       \
+    __ENTRY(HJ_HANDLE_LIST)       \
+    __ENTRY(HJ_HANDLE_READV)      \
+    __ENTRY(HJ_HANDLE_WRITEV)     \
+    __ENTRY(HJ_HANDLE_PREAD)      \
+    __ENTRY(HJ_HANDLE_PWRITE)     \
+    __ENTRY(HJ_HANDLE_SPLICE)     \
+    __ENTRY(HJ_CREATE_POLLSET)    \
+    __ENTRY(HJ_POLLSET_CONTROL)   \
+    __ENTRY(HJ_POLLSET_WAIT)
 
 #define SYSCALL_ENUM_ENTRY(__entry) __entry,
 
@@ -142,6 +151,10 @@ Result hj_system_shutdown();
 
 Result hj_create_pipe(int *reader_handle, int *writer_handle);
 Result hj_create_term(int *server_handle, int *client_handle);
+Result hj_create_pollset(int *handle);
+
+Result hj_pollset_control(int pollset, PollSetControl control, int handle, PollEvent events);
+Result hj_pollset_wait(int pollset, HandlePoll *ready, size_t count, size_t *ready_count, Timeout timeout);
 
 Result hj_handle_open(int *handle, const char *raw_path, size_t size, OpenFlag flags);
 Result hj_handle_close(int handle);
@@ -149,6 +162,12 @@ Result hj_handle_reopen(int handle, int *reopened);
 Result hj_handle_copy(int source, int destination);
 Result hj_handle_poll(HandlePoll *handles, size_t count, Timeout timeout);
 Result hj_handle_read(int handle, void *buffer, size_t size, size_t *read);
+Result hj_handle_readv(int handle, const IOVector *vectors, size_t count, size_t *read);
+Result hj_handle_writev(int handle, const IOVector *vectors, size_t count, size_t *written);
+Result hj_handle_pread(int handle, void *buffer, size_t size, ssize64_t *offset, size_t *read);
+Result hj_handle_pwrite(int handle, const void *buffer, size_t size, ssize64_t *offset, size_t *written);
+Result hj_handle_list(int handle, DirectoryEntry *entries, size_t count, size_t *listed);
+Result hj_handle_splice(int source, int destination, size_t size, size_t *spliced);
 Result hj_handle_write(int handle, const void *buffer, size_t size, size_t *written);
 Result hj_handle_call(int handle, IOCall request, void *args);
 Result hj_handle_seek(int handle, ssize64_t *offset, HjWhence whence, ssize64_t *result);
@@ -25,72 +25,273 @@ RefPtr<Loop> Loop::the()
 
 void Loop::update_notifier(int id, PollEvent event)
 {
-    for (size_t i = 0; i < _notifiers.count(); i++)
+    if (!_notifiers.has_key(id))
     {
-        if (_notifiers[i]->handle()->id() == id &&
-            _notifiers[i]->events() & event)
+        return;
+    }
+
+    // A notifier might register or destroy others while running.
+    auto notifiers = _notifiers[id];
+
+    for (Notifier *notifier : notifiers)
+    {
+        if (!_notifiers.has_key(id) || !_notifiers[id].contains(notifier))
+        {
+            continue;
+        }
+
+        if (notifier->events() & event)
         {
-            _notifiers[i]->invoke();
+            notifier->invoke();
         }
     }
 }
 
-void Loop::update_polling_list()
+PollEvent Loop::events_of(int id)
 {
-    _polls.clear();
+    PollEvent events = 0;
+
+    if (!_notifiers.has_key(id))
+    {
+        return events;
+    }
 
-    for (Notifier *notifier : _notifiers)
+    for (Notifier *notifier : _notifiers[id])
     {
-        _polls.push_back({
-            notifier->handle()->id(),
-            notifier->events(),
-            0,
-        });
+        events |= notifier->events();
+    }
+
+    return events;
+}
+
+void Loop::update_interest(int id, PollEvent previous_events)
+{
+    // Several notifiers can watch the same handle, the kernel only knows
+    // about the union of their events.
+    PollEvent events = events_of(id);
+
+    if (events == previous_events || _pollset == HANDLE_INVALID_ID)
+    {
+        return;
+    }
+
+    if (previous_events == 0)
+    {
+        hj_pollset_control(_pollset, POLLSET_ADD, id, events);
+    }
+    else if (events == 0)
+    {
+        hj_pollset_control(_pollset, POLLSET_REMOVE, id, 0);
+    }
+    else
+    {
+        hj_pollset_control(_pollset, POLLSET_MODIFY, id, events);
     }
 }
 
 void Loop::register_notifier(Notifier *notifier)
 {
+    int id = notifier->handle()->id();
+    PollEvent previous_events = events_of(id);
 
-    _notifiers.push_back(notifier);
+    _notifiers[id].push_back(notifier);
 
-    update_polling_list();
+    update_interest(id, previous_events);
 }
 
 void Loop::unregister_notifier(Notifier *notifier)
 {
-    _notifiers.remove_all_value(notifier);
+    int id = notifier->handle()->id();
+
+    if (!_notifiers.has_key(id))
+    {
+        return;
+    }
+
+    PollEvent previous_events = events_of(id);
 
-    update_polling_list();
+    auto &notifiers = _notifiers[id];
+    notifiers.remove_all_value(notifier);
+
+    if (notifiers.empty())
+    {
+        _notifiers.remove_key(id);
+    }
+
+    update_interest(id, previous_events);
 }
 
 /* --- Timers --------------------------------------------------------------- */
 
-void Loop::register_timer(Timer *timer)
+void Loop::timers_swap(size_t a, size_t b)
 {
+    swap(_timers[a], _timers[b]);
+
+    _timers[a]->_index = a;
+    _timers[b]->_index = b;
+}
+
+bool Loop::timers_before(size_t a, size_t b)
+{
+    if (_timers[a]->scheduled() != _timers[b]->scheduled())
+    {
+        return _timers[a]->scheduled() < _timers[b]->scheduled();
+    }
+
+    return _timers[a]->_sequence < _timers[b]->_sequence;
+}
+
+void Loop::timers_sift_up(size_t index)
+{
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+
+        if (timers_before(parent, index))
+        {
+            return;
+        }
+
+        timers_swap(parent, index);
+        index = parent;
+    }
+}
+
+void Loop::timers_sift_down(size_t index)
+{
+    while (true)
+    {
+        size_t smallest = index;
+        size_t left = index * 2 + 1;
+        size_t right = index * 2 + 2;
+
+        if (left < _timers.count() && timers_before(left, smallest))
+        {
+            smallest = left;
+        }
+
+        if (right < _timers.count() && timers_before(right, smallest))
+        {
+            smallest = right;
+        }
+
+        if (smallest == index)
+        {
+            return;
+        }
+
+        timers_swap(smallest, index);
+        index = smallest;
+    }
+}
+
+void Loop::timers_push(Timer *timer)
+{
+    timer->_sequence = _timers_pushed;
+    _timers_pushed++;
+
+    timer->_index = _timers.count();
     _timers.push_back(timer);
+    timers_sift_up(timer->_index);
+}
+
+void Loop::timers_remove(size_t index)
+{
+    size_t last = _timers.count() - 1;
+
+    _timers[index]->_index = Timer::NOT_QUEUED;
+
+    if (index != last)
+    {
+        _timers[index] = _timers[last];
+        _timers[index]->_index = index;
+    }
+
+    _timers.pop_back();
+
+    if (index < _timers.count())
+    {
+        timers_sift_down(index);
+        timers_sift_up(index);
+    }
+}
+
+void Loop::register_timer(Timer *timer)
+{
+    if (timer->interval() == 0)
+    {
+        _idle_timers.push_back(timer);
+    }
+    else
+    {
+        timers_push(timer);
+    }
+}
+
+void Loop::update_timer_interval(Timer *timer)
+{
+    if (timer->interval() == 0 && timer->_index != Timer::NOT_QUEUED)
+    {
+        timers_remove(timer->_index);
+        _idle_timers.push_back(timer);
+    }
+    else if (timer->interval() != 0 && _idle_timers.contains(timer))
+    {
+        _idle_timers.remove_all_value(timer);
+        timers_push(timer);
+    }
 }
 
 void Loop::unregister_timer(Timer *timer)
 {
-    _timers.remove_value(timer);
+    if (timer->_index != Timer::NOT_QUEUED)
+    {
+        timers_remove(timer->_index);
+    }
+
+    _due_timers.remove_all_value(timer);
+    _idle_timers.remove_all_value(timer);
 }
 
 void Loop::update_timers()
 {
     TimeStamp current_fire = system_get_ticks();
 
-    auto timers_list_copy = _timers;
+    // A callback might pump a nested loop while some are still due.
+    size_t first_due = _due_timers.count();
+
+    while (_timers.any() && _timers[0]->scheduled() <= current_fire)
+    {
+        _due_timers.push_back(_timers[0]);
+        timers_remove(0);
+    }
+
+    // Reschedule everything before running any callback, so they are free
+    // to start and stop timers, including themselves.
+    for (size_t i = first_due; i < _due_timers.count(); i++)
+    {
+        Timer *timer = _due_timers[i];
+        timer->schedule(current_fire + timer->interval());
+        register_timer(timer);
+    }
+
+    // They came out of the heap by deadline then by when they were queued,
+    // fire them in that order.
+    while (_due_timers.any())
+    {
+        _due_timers.pop()->trigger();
+    }
 
-    timers_list_copy.foreach ([&](auto timer) {
-        if (timer->running() && timer->scheduled() <= current_fire)
+    // One of them might stop, or even delete, the ones after it.
+    auto idle_timers = _idle_timers;
+
+    for (auto *timer : idle_timers)
+    {
+        if (_idle_timers.contains(timer))
         {
             timer->trigger();
-            timer->schedule(current_fire + timer->interval());
         }
-
-        return Iteration::CONTINUE;
-    });
+    }
 }
 
 /* --- Invokers ------------------------------------------------------------- */
@@ -107,8 +308,11 @@ void Loop::unregister_invoker(Invoker *invoker)
 
 void Loop::update_invoker()
 {
-    _invoker.foreach ([](Invoker *invoker) {
-        if (invoker->should_be_invoke_later())
+    auto invokers_list_copy = _invoker;
+
+    invokers_list_copy.foreach ([&](Invoker *invoker) {
+        // An invoker might destroy others while running.
+        if (_invoker.contains(invoker) && invoker->should_be_invoke_later())
         {
             invoker->invoke();
         }
@@ -123,6 +327,11 @@ static Vector<AtExitHook> _atexit_hooks;
 
 Loop::Loop()
 {
+    // Without a poll set, every watched handle is polled on each pass.
+    if (hj_create_pollset(&_pollset) != SUCCESS)
+    {
+        _pollset = HANDLE_INVALID_ID;
+    }
 }
 
 Loop::~Loop()
@@ -131,35 +340,61 @@ Loop::~Loop()
     {
         _atexit_hooks[i]();
     }
+
+    if (_pollset != HANDLE_INVALID_ID)
+    {
+        hj_handle_close(_pollset);
+    }
 }
 
-Timeout Loop::get_timeout()
+Result Loop::poll_handles(size_t *ready, Timeout timeout)
 {
-    Timeout timeout = UINT32_MAX;
-
-    TimeStamp current_tick = system_get_ticks();
+    _notifiers.foreach ([&](auto &id, auto &notifiers) {
+        PollEvent events = 0;
 
-    _timers.foreach ([&](auto timer) {
-        if (!timer->running() || timer->interval() == 0)
+        for (Notifier *notifier : notifiers)
         {
-            return Iteration::CONTINUE;
+            events |= notifier->events();
         }
 
-        if (timer->scheduled() < current_tick)
-        {
-            timeout = 0;
-            return Iteration::CONTINUE;
-        }
+        _ready[*ready] = {id, events, 0};
+        (*ready)++;
 
-        Timeout remaining = timer->scheduled() - current_tick;
+        return Iteration::CONTINUE;
+    });
 
-        if (remaining <= timeout)
+    return hj_handle_poll(_ready, *ready, timeout);
+}
+
+Timeout Loop::get_timeout()
+{
+    Timeout timeout = UINT32_MAX;
+
+    for (auto *invoker : _invoker)
+    {
+        if (invoker->should_be_invoke_later())
         {
-            timeout = remaining;
+            return 0;
         }
+    }
 
-        return Iteration::CONTINUE;
-    });
+    if (_timers.empty())
+    {
+        return timeout;
+    }
+
+    TimeStamp current_tick = system_get_ticks();
+    TimeStamp next_fire = _timers[0]->scheduled();
+
+    if (next_fire <= current_tick)
+    {
+        return 0;
+    }
+
+    if (next_fire - current_tick < timeout)
+    {
+        timeout = next_fire - current_tick;
+    }
 
     return timeout;
 }
@@ -179,16 +414,26 @@ void Loop::pump(bool pool)
         timeout = get_timeout();
     }
 
-    Result result = hj_handle_poll(_polls.raw_storage(), _polls.count(), timeout);
+    size_t ready = 0;
+    Result result = SUCCESS;
+
+    if (_pollset != HANDLE_INVALID_ID)
+    {
+        result = hj_pollset_wait(_pollset, _ready, PROCESS_HANDLE_COUNT, &ready, timeout);
+    }
+    else
+    {
+        result = poll_handles(&ready, timeout);
+    }
 
     if (result_is_error(result))
     {
         exit(PROCESS_FAILURE);
     }
 
-    for (const HandlePoll &poll : _polls)
+    for (size_t i = 0; i < ready; i++)
     {
-        update_notifier(poll.handle, poll.result);
+        update_notifier(_ready[i].handle, _ready[i].result);
     }
 
     update_timers();
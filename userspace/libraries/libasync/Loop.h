@@ -1,6 +1,7 @@
 #pragma once
 
 #include <libio/Handle.h>
+#include <libutils/HashMap.h>
 #include <libutils/RefCounted.h>
 #include <libutils/Vector.h>
 
@@ -24,18 +25,47 @@ private:
     bool _nested_is_running = false;
     int _nested_exit_value = 0;
 
-    Vector<HandlePoll> _polls;
+    // The kernel keeps the handles we are interested in, so only what
+    // changes is sent to it and a wait returns the ready ones.
+    int _pollset = HANDLE_INVALID_ID;
+    HandlePoll _ready[PROCESS_HANDLE_COUNT];
 
-    Vector<Notifier *> _notifiers;
+    // Indexed by the id of the handle they are watching.
+    HashMap<int, Vector<Notifier *>> _notifiers;
+
+    // A binary min-heap on the next time each timer fires, timers due at
+    // the same time come out in the order they were pushed.
     Vector<Timer *> _timers;
+    size_t _timers_pushed = 0;
+    Vector<Timer *> _due_timers;
+
+    // Timers with no interval fire on every pass but never wake the loop.
+    Vector<Timer *> _idle_timers;
+
     Vector<Invoker *> _invoker;
 
-    void update_polling_list();
+    PollEvent events_of(int id);
+
+    void update_interest(int id, PollEvent previous_events);
 
     void update_notifier(int id, PollEvent event);
 
+    void timers_swap(size_t a, size_t b);
+
+    bool timers_before(size_t a, size_t b);
+
+    void timers_sift_up(size_t index);
+
+    void timers_sift_down(size_t index);
+
+    void timers_push(Timer *timer);
+
+    void timers_remove(size_t index);
+
     void update_timers();
 
+    Result poll_handles(size_t *ready, Timeout timeout);
+
     void update_invoker();
 
     Timeout get_timeout();
@@ -55,6 +85,9 @@ public:
 
     void unregister_timer(Timer *timer);
 
+    // Moves a running timer in or out of the idle ones.
+    void update_timer_interval(Timer *timer);
+
     void register_invoker(Invoker *timer);
 
     void unregister_invoker(Invoker *timer);
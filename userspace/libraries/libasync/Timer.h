@@ -1,6 +1,6 @@
 #pragma once
 
-#include <skift/Time.h>
+#include <abi/Time.h>
 
 #include <libasync/Source.h>
 #include <libutils/Callback.h>
@@ -13,6 +13,16 @@ class Timer :
     public Source
 {
 private:
+    friend class Loop;
+
+    static constexpr size_t NOT_QUEUED = -1;
+
+    // Position in the loop's heap of running timers.
+    size_t _index = NOT_QUEUED;
+
+    // When it was pushed on the heap, orders timers due at the same time.
+    size_t _sequence = 0;
+
     bool _running = false;
     TimeStamp _scheduled = 0;
     Timeout _interval = 0;
@@ -23,7 +33,16 @@ public:
 
     auto interval() { return _interval; }
 
-    void interval(Timeout interval) { _interval = interval; }
+    void interval(Timeout interval)
+    {
+        bool was_idle = _interval == 0;
+        _interval = interval;
+
+        if (_running && was_idle != (_interval == 0))
+        {
+            loop().update_timer_interval(this);
+        }
+    }
 
     auto scheduled() { return _scheduled; }
 
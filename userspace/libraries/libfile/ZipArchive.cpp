@@ -119,12 +119,27 @@ ZipArchive::ZipArchive(IO::Path path, bool read) : Archive(path)
     }
 }
 
-Result read_local_headers(IO::SeekableReader auto &reader, Vector<Archive::Entry> &entries)
+Result read_local_headers(IO::File &file, Vector<Archive::Entry> &entries)
 {
+    // Each record is fetched with a single positional read: the header, the
+    // filename and the extra fields usually fit in the same buffer.
+    uint8_t record[sizeof(LocalHeader) + 512];
+
+    size_t offset = TRY(file.tell());
+    size_t length = TRY(file.length());
+
     // Read all local file headers and data descriptors
-    while (TRY(reader.tell()) < (TRY(reader.length()) - sizeof(LocalHeader)))
+    while (offset < length - sizeof(LocalHeader))
     {
-        auto local_header = TRY(IO::peek<LocalHeader>(reader));
+        size_t record_size = TRY(file.read_at(offset, record, sizeof(record)));
+
+        if (record_size < sizeof(LocalHeader))
+        {
+            return Result::ERR_INVALID_DATA;
+        }
+
+        LocalHeader local_header;
+        memcpy(&local_header, record, sizeof(LocalHeader));
 
         // Check if this is a local header
         if (local_header.signature() != ZIP_LOCAL_DIR_HEADER_SIG)
@@ -133,40 +148,66 @@ Result read_local_headers(IO::SeekableReader auto &reader, Vector<Archive::Entry
         }
 
         auto &entry = entries.emplace_back();
-        Assert::equal(IO::skip(reader, sizeof(LocalHeader)), SUCCESS);
 
         // Get the uncompressed & compressed sizes
         entry.uncompressed_size = local_header.uncompressed_size();
         entry.compressed_size = local_header.compressed_size();
         entry.compression = local_header.compression();
 
+        size_t header_size = sizeof(LocalHeader) + local_header.len_filename() + local_header.len_extrafield();
+
+        // The record didn't fit in the buffer, read the variable part separately
+        Vector<uint8_t> overflow;
+        uint8_t *fields = record + sizeof(LocalHeader);
+
+        if (header_size > record_size)
+        {
+            overflow.resize(header_size - sizeof(LocalHeader));
+
+            if (TRY(file.read_at(offset + sizeof(LocalHeader), overflow.raw_storage(), overflow.count())) != overflow.count())
+            {
+                return Result::ERR_INVALID_DATA;
+            }
+
+            fields = overflow.raw_storage();
+        }
+
         // Read the filename of this entry
-        entry.name = TRY(IO::read_string(reader, local_header.len_filename()));
+        entry.name = String{(const char *)fields, local_header.len_filename()};
 
         // Read extra fields
-        auto end_position = TRY(reader.tell()) + local_header.len_extrafield();
-        while (TRY(reader.tell()) < end_position)
+        IO::MemoryReader extra_fields{fields + local_header.len_filename(), local_header.len_extrafield()};
+        while (TRY(extra_fields.tell()) + 4 <= local_header.len_extrafield())
         {
-            le_eft extra_field_type = TRY(IO::read<ExtraFieldType>(reader));
-            le_uint16_t extra_field_size = TRY(IO::read<uint16_t>(reader));
+            le_eft extra_field_type = TRY(IO::read<ExtraFieldType>(extra_fields));
+            le_uint16_t extra_field_size = TRY(IO::read<uint16_t>(extra_fields));
 
             // TODO: parse the known extra field types
             UNUSED(extra_field_type);
-            TRY(IO::skip(reader, extra_field_size()));
+            TRY(IO::skip(extra_fields, extra_field_size()));
         }
 
-        entry.archive_offset = TRY(reader.tell());
+        entry.archive_offset = offset + header_size;
         // TODO: Compute the checksum for the compressed data
-        TRY(IO::skip(reader, entry.compressed_size));
+        offset = entry.archive_offset + entry.compressed_size;
 
         if (local_header.flags() & EF_DATA_DESCRIPTOR)
         {
-            auto data_descriptor = TRY(IO::read<DataDescriptor>(reader));
+            DataDescriptor data_descriptor;
+
+            if (TRY(file.read_at(offset, &data_descriptor, sizeof(DataDescriptor))) != sizeof(DataDescriptor))
+            {
+                return Result::ERR_INVALID_DATA;
+            }
+
             entry.uncompressed_size = data_descriptor.uncompressed_size();
             entry.compressed_size = data_descriptor.compressed_size();
+            offset += sizeof(DataDescriptor);
         }
     }
 
+    TRY(file.seek(IO::SeekFrom::start(offset)));
+
     return Result::SUCCESS;
 }
 
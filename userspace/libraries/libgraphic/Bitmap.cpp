@@ -49,9 +49,9 @@ ResultOr<RefPtr<Bitmap>> Bitmap::create_shared_from_handle(int handle, Math::Vec
     return make<Bitmap>(handle, BITMAP_SHARED, width_and_height.x(), width_and_height.y(), pixels);
 }
 
-RefPtr<Bitmap> Bitmap::create_static(int width, int height, Color *pixels)
+RefPtr<Bitmap> Bitmap::create_static(int width, int height, Color *pixels, BitmapFormat format)
 {
-    return make<Bitmap>(-1, BITMAP_STATIC, width, height, pixels);
+    return make<Bitmap>(-1, BITMAP_STATIC, width, height, pixels, format);
 }
 
 RefPtr<Bitmap> Bitmap::placeholder()
@@ -7,6 +7,7 @@
 #include <libutils/String.h>
 
 #include <libgraphic/Color.h>
+#include <libgraphic/Spans.h>
 
 namespace Graphic
 {
@@ -17,6 +18,15 @@ enum BitmapStorage
     BITMAP_STATIC,
 };
 
+// Pixels in bitmaps are premultiplied by their alpha, unless they come
+// from somewhere that says otherwise. Colors outside of bitmaps, the ones
+// handed to the painter for example, are always straight alpha.
+enum BitmapFormat
+{
+    BITMAP_PREMULTIPLIED,
+    BITMAP_STRAIGHT,
+};
+
 enum BitmapFiltering
 {
     NEAREST,
@@ -38,6 +48,7 @@ private:
     BitmapStorage _storage;
     int _width;
     int _height;
+    BitmapFormat _format;
     BitmapFiltering _filtering;
     Color *_pixels;
 
@@ -45,11 +56,12 @@ private:
     NONMOVABLE(Bitmap);
 
 public:
-    Bitmap(int handle, BitmapStorage storage, int width, int height, Color *pixels)
+    Bitmap(int handle, BitmapStorage storage, int width, int height, Color *pixels, BitmapFormat format = BITMAP_PREMULTIPLIED)
         : _handle(handle),
           _storage(storage),
           _width(width),
           _height(height),
+          _format(format),
           _filtering(BitmapFiltering::LINEAR),
           _pixels(pixels)
     {
@@ -65,6 +77,8 @@ public:
     Math::Vec2i size() const { return Math::Vec2i(_width, _height); }
     Math::Recti bound() const { return Math::Recti(_width, _height); }
 
+    BitmapFormat format() const { return _format; }
+
     void filtering(BitmapFiltering filtering) { _filtering = filtering; }
 
     static RefPtr<Bitmap> placeholder();
@@ -73,7 +87,7 @@ public:
 
     static ResultOr<RefPtr<Bitmap>> create_shared_from_handle(int handle, Math::Vec2i width_and_height);
 
-    static RefPtr<Bitmap> create_static(int width, int height, Color *pixels);
+    static RefPtr<Bitmap> create_static(int width, int height, Color *pixels, BitmapFormat format = BITMAP_PREMULTIPLIED);
 
     static ResultOr<RefPtr<Bitmap>> load_from(String path, int size_hint = -1);
 
@@ -81,6 +95,48 @@ public:
 
     Result save_to(String path);
 
+    static constexpr Color convert(Color color, BitmapFormat from, BitmapFormat to)
+    {
+        if (from == to)
+        {
+            return color;
+        }
+        else if (to == BITMAP_PREMULTIPLIED)
+        {
+            return color.premultiplied();
+        }
+        else
+        {
+            return color.unpremultiplied();
+        }
+    }
+
+    // From a straight alpha color to a pixel of this bitmap.
+    Color encode(Color color) const { return convert(color, BITMAP_STRAIGHT, _format); }
+
+    // From a pixel of this bitmap to a straight alpha color.
+    Color decode(Color pixel) const { return convert(pixel, _format, BITMAP_STRAIGHT); }
+
+    // Converts the pixels in place.
+    void convert_to(BitmapFormat format)
+    {
+        if (format == _format)
+        {
+            return;
+        }
+
+        for (int i = 0; i < width() * height(); i++)
+        {
+            _pixels[i] = convert(_pixels[i], _format, format);
+        }
+
+        _format = format;
+    }
+
+    // The pixel accessors work with pixels as they are in memory, in the
+    // format of the bitmap. Only the blending ones take a `color` in
+    // `format`, straight alpha unless told otherwise.
+
     void set_pixel(Math::Vec2i position, Color color)
     {
         if (bound().contains(position))
@@ -94,16 +150,26 @@ public:
         _pixels[position.x() + position.y() * width()] = color;
     }
 
-    void blend_pixel(Math::Vec2i position, Color color)
+    void blend_pixel(Math::Vec2i position, Color color, BitmapFormat format = BITMAP_STRAIGHT)
     {
-        Color background = get_pixel(position);
-        set_pixel(position, Color::blend(color, background));
+        if (bound().contains(position))
+        {
+            blend_pixel_no_check(position, color, format);
+        }
     }
 
-    void blend_pixel_no_check(Math::Vec2i position, Color color)
+    void blend_pixel_no_check(Math::Vec2i position, Color color, BitmapFormat format = BITMAP_STRAIGHT)
     {
         Color background = get_pixel_no_check(position);
-        set_pixel_no_check(position, Color::blend(color, background));
+
+        if (_format == BITMAP_PREMULTIPLIED)
+        {
+            set_pixel_no_check(position, Color::blend_premultiplied(convert(color, format, BITMAP_PREMULTIPLIED), background));
+        }
+        else
+        {
+            set_pixel_no_check(position, Color::blend(convert(color, format, BITMAP_STRAIGHT), background));
+        }
     }
 
     Color get_pixel(Math::Vec2i position)
@@ -153,19 +219,26 @@ public:
 
         for (int y = region.y(); y < region.y() + region.height(); y++)
         {
-            for (int x = region.x(); x < region.x() + region.width(); x++)
+            Color *destination_row = _pixels + y * width() + region.x();
+            Color *source_row = source._pixels + y * source.width() + region.x();
+
+            if (source.format() == _format)
             {
-                set_pixel_no_check(Math::Vec2i(x, y), source.get_pixel_no_check(Math::Vec2i(x, y)));
+                copy_span(destination_row, source_row, region.width());
+            }
+            else
+            {
+                for (int x = 0; x < region.width(); x++)
+                {
+                    destination_row[x] = convert(source_row[x], source.format(), _format);
+                }
             }
         }
     }
 
     void clear(Color color)
     {
-        for (int i = 0; i < width() * height(); i++)
-        {
-            pixels()[i] = color;
-        }
+        fill_span(_pixels, encode(color), width() * height());
     }
 };
 
@@ -188,6 +188,72 @@ public:
         }
     }
 
+    // Rounds `value / 255` to the nearest, for `value` up to 255 * 255.
+    static constexpr unsigned div255(unsigned value)
+    {
+        value += 128;
+        return (value + (value >> 8)) >> 8;
+    }
+
+    constexpr Color premultiplied() const
+    {
+        if (alpha() == 0xff)
+        {
+            return *this;
+        }
+
+        return {
+            static_cast<uint8_t>(div255(red() * alpha())),
+            static_cast<uint8_t>(div255(green() * alpha())),
+            static_cast<uint8_t>(div255(blue() * alpha())),
+            alpha(),
+        };
+    }
+
+    constexpr Color unpremultiplied() const
+    {
+        if (alpha() == 0xff)
+        {
+            return *this;
+        }
+
+        if (alpha() == 0)
+        {
+            return {0, 0, 0, 0};
+        }
+
+        auto unmultiply = [&](unsigned channel) {
+            unsigned value = (channel * 255 + alpha() / 2) / alpha();
+            return static_cast<uint8_t>(value > 255 ? 255 : value);
+        };
+
+        return {unmultiply(red()), unmultiply(green()), unmultiply(blue()), alpha()};
+    }
+
+    // Source over for colors premultiplied by their alpha, the background
+    // doesn't need to be opaque and there is no division involved.
+    static constexpr Color blend_premultiplied(Color fg, Color bg)
+    {
+        if (fg.alpha() == 0xff)
+        {
+            return fg;
+        }
+
+        unsigned inv_alpha = 255 - fg.alpha();
+
+        auto over = [&](unsigned fg_channel, unsigned bg_channel) {
+            unsigned value = fg_channel + div255(bg_channel * inv_alpha);
+            return static_cast<uint8_t>(value > 255 ? 255 : value);
+        };
+
+        return {
+            over(fg.red(), bg.red()),
+            over(fg.green(), bg.green()),
+            over(fg.blue(), bg.blue()),
+            over(fg.alpha(), bg.alpha()),
+        };
+    }
+
     static constexpr Color lerp(Color from, Color to, float transition)
     {
         return from_rgba(
@@ -0,0 +1,67 @@
+#include <libgraphic/EffectCache.h>
+
+namespace Graphic
+{
+
+uint32_t EffectCache::fingerprint(Bitmap &bitmap, Math::Recti bound)
+{
+    bound = bound.clipped_with(bitmap.bound());
+
+    // FNV-1a a pixel at a time, a lot cheaper than the effect itself.
+    uint32_t hash = 2166136261;
+
+    for (int y = bound.top(); y < bound.bottom(); y++)
+    {
+        auto *row = bitmap.pixels() + y * bitmap.width() + bound.x();
+
+        for (int x = 0; x < bound.width(); x++)
+        {
+            uint32_t pixel;
+            __builtin_memcpy(&pixel, &row[x], sizeof(pixel));
+            hash = (hash ^ pixel) * 16777619;
+        }
+    }
+
+    return hash;
+}
+
+bool EffectCache::restore(Bitmap &bitmap, uint32_t source, Math::Recti bound, Acrylic acrylic)
+{
+    if (!valid_for(source, bound, acrylic) ||
+        !bitmap.bound().contains(bound))
+    {
+        return false;
+    }
+
+    for (int y = 0; y < bound.height(); y++)
+    {
+        copy_span(
+            bitmap.pixels() + (bound.y() + y) * bitmap.width() + bound.x(),
+            _pixels.raw_storage() + y * bound.width(),
+            bound.width());
+    }
+
+    return true;
+}
+
+void EffectCache::store(Bitmap &bitmap, uint32_t source, Math::Recti bound, Acrylic acrylic)
+{
+    bound = bound.clipped_with(bitmap.bound());
+
+    _pixels.resize(bound.width() * bound.height());
+
+    for (int y = 0; y < bound.height(); y++)
+    {
+        copy_span(
+            _pixels.raw_storage() + y * bound.width(),
+            bitmap.pixels() + (bound.y() + y) * bitmap.width() + bound.x(),
+            bound.width());
+    }
+
+    _valid = true;
+    _source = source;
+    _bound = bound;
+    _acrylic = acrylic;
+}
+
+} // namespace Graphic
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <libgraphic/Bitmap.h>
+#include <libutils/Vector.h>
+
+namespace Graphic
+{
+
+struct Acrylic
+{
+    float saturation = 0.25;
+    int blur = 16;
+    float noise = 0.05;
+
+    bool operator==(const Acrylic &other) const
+    {
+        return saturation == other.saturation &&
+               blur == other.blur &&
+               noise == other.noise;
+    }
+};
+
+// Keeps the outcome of an effect so it can be put back instead of being
+// done again. What was under the effect is identified by a fingerprint of
+// its pixels, so anything drawn there, by the owner of the cache or by
+// what is behind it, is seen. The place it was at and the parameters of
+// the effect are part of the key too.
+class EffectCache
+{
+private:
+    bool _valid = false;
+    uint32_t _source = 0;
+    Math::Recti _bound = {};
+    Acrylic _acrylic = {};
+
+    Vector<Color> _pixels;
+
+public:
+    // Identifies the pixels of `bitmap` within `bound`, taken before the
+    // effect is done.
+    static uint32_t fingerprint(Bitmap &bitmap, Math::Recti bound);
+
+    bool valid_for(uint32_t source, Math::Recti bound, Acrylic acrylic) const
+    {
+        return _valid &&
+               _source == source &&
+               _bound == bound &&
+               _acrylic == acrylic;
+    }
+
+    // Puts the pixels back into `bitmap` if they were made from the same
+    // source, at this place, with the same parameters.
+    bool restore(Bitmap &bitmap, uint32_t source, Math::Recti bound, Acrylic acrylic);
+
+    // Keeps the pixels of `bitmap` within `bound`.
+    void store(Bitmap &bitmap, uint32_t source, Math::Recti bound, Acrylic acrylic);
+
+    void invalidate()
+    {
+        _valid = false;
+    }
+};
+
+} // namespace Graphic
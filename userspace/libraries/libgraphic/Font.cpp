@@ -63,30 +63,127 @@ ResultOr<RefPtr<Font>> Font::get(String name)
     return _fonts[name];
 }
 
-bool Font::has(Codepoint codepoint) const
+Font::Font(RefPtr<Bitmap> bitmap, Vector<Glyph> glyphs)
+    : _bitmap(bitmap),
+      _glyphs(move(glyphs))
+{
+    build_index();
+    build_coverage();
+
+    int fallback = index_of(U'?');
+
+    if (fallback != -1)
+    {
+        _default = _glyphs[fallback];
+    }
+}
+
+void Font::build_index()
 {
-    for (int i = 0; _glyphs[i].codepoint != 0; i++)
+    _pages.resize(GLYPH_PAGE_COUNT);
+
+    for (size_t i = 0; i < GLYPH_PAGE_COUNT; i++)
     {
-        if (_glyphs[i].codepoint == codepoint)
+        _pages[i] = -1;
+    }
+
+    // The list of glyphs ends with a null codepoint.
+    for (size_t i = 0; i < _glyphs.count() && _glyphs[i].codepoint != 0; i++)
+    {
+        auto codepoint = _glyphs[i].codepoint;
+
+        if (index_of(codepoint) != -1)
         {
-            return true;
+            continue;
         }
-    }
 
-    return false;
+        if (codepoint >= 0x10000)
+        {
+            _astral[codepoint] = i;
+            continue;
+        }
+
+        auto page = codepoint / GLYPH_PAGE_SIZE;
+
+        if (_pages[page] == -1)
+        {
+            _pages[page] = _bmp.count();
+
+            for (size_t j = 0; j < GLYPH_PAGE_SIZE; j++)
+            {
+                _bmp.push_back(NO_GLYPH);
+            }
+        }
+
+        _bmp[_pages[page] + codepoint % GLYPH_PAGE_SIZE] = i;
+    }
 }
 
-const Glyph &Font::glyph(Codepoint codepoint) const
+void Font::build_coverage()
 {
-    for (int i = 0; _glyphs[i].codepoint != 0; i++)
+    _coverage_offsets.resize(_glyphs.count());
+
+    for (size_t i = 0; i < _glyphs.count(); i++)
     {
-        if (_glyphs[i].codepoint == codepoint)
+        auto bound = _glyphs[i].bound;
+        _coverage_offsets[i] = _coverage.count();
+
+        // The glyphs are white on black, red is as good as any channel.
+        for (int y = 0; y < bound.height(); y++)
         {
-            return _glyphs[i];
+            for (int x = 0; x < bound.width(); x++)
+            {
+                _coverage.push_back(_bitmap->get_pixel(bound.position() + Math::Vec2i{x, y}).red());
+            }
         }
     }
+}
+
+int Font::index_of(Codepoint codepoint) const
+{
+    if (codepoint >= 0x10000)
+    {
+        auto *index = _astral.lookup(codepoint);
+        return index ? *index : -1;
+    }
+
+    int page = _pages[codepoint / GLYPH_PAGE_SIZE];
+
+    if (page == -1 || _bmp[page + codepoint % GLYPH_PAGE_SIZE] == NO_GLYPH)
+    {
+        return -1;
+    }
+
+    return _bmp[page + codepoint % GLYPH_PAGE_SIZE];
+}
+
+bool Font::has(Codepoint codepoint) const
+{
+    return index_of(codepoint) != -1;
+}
+
+const Glyph &Font::glyph(Codepoint codepoint) const
+{
+    int index = index_of(codepoint);
+
+    if (index == -1)
+    {
+        return _default;
+    }
+
+    return _glyphs[index];
+}
+
+const uint8_t *Font::coverage(const Glyph &glyph) const
+{
+    int index = index_of(glyph.codepoint);
+
+    if (index == -1 || _glyphs[index].bound != glyph.bound)
+    {
+        return nullptr;
+    }
 
-    return _default;
+    return _coverage.raw_storage() + _coverage_offsets[index];
 }
 
 Math::Recti Font::mesure(Codepoint codepoint) const
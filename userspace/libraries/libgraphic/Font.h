@@ -1,6 +1,7 @@
 #pragma once
 
 #include <libgraphic/Bitmap.h>
+#include <libutils/HashMap.h>
 #include <libutils/String.h>
 #include <libutils/Vector.h>
 #include <libutils/unicode/Codepoint.h>
@@ -52,10 +53,32 @@ struct Glyph
 class Font : public RefCounted<Font>
 {
 private:
+    // Codepoints of the basic multilingual plane are looked up in pages of
+    // 256, made only for the ones the font has glyphs on.
+    static constexpr auto GLYPH_PAGE_SIZE = 256;
+    static constexpr auto GLYPH_PAGE_COUNT = 0x10000 / GLYPH_PAGE_SIZE;
+    static constexpr uint16_t NO_GLYPH = 0xffff;
+
     RefPtr<Bitmap> _bitmap;
-    Glyph _default;
+    Glyph _default = {};
     Vector<Glyph> _glyphs;
 
+    // Where each page starts in `_bmp`, -1 if there is no glyph on it.
+    Vector<int> _pages;
+    Vector<uint16_t> _bmp;
+    // Everything past the basic multilingual plane.
+    HashMap<Codepoint, int> _astral;
+
+    // How much each pixel of each glyph is covered, a byte per pixel.
+    Vector<uint8_t> _coverage;
+    Vector<int> _coverage_offsets;
+
+    int index_of(Codepoint codepoint) const;
+
+    void build_index();
+
+    void build_coverage();
+
 public:
     const FontMetrics metrics() const
     {
@@ -66,17 +89,16 @@ public:
 
     static ResultOr<RefPtr<Font>> get(String name);
 
-    Font(RefPtr<Bitmap> bitmap, Vector<Glyph> glyphs)
-        : _bitmap(bitmap),
-          _glyphs(move(glyphs))
-    {
-        _default = glyph(U'?');
-    }
+    Font(RefPtr<Bitmap> bitmap, Vector<Glyph> glyphs);
 
     bool has(Codepoint codepoint) const;
 
     const Glyph &glyph(Codepoint codepoint) const;
 
+    // The coverage of `glyph`, row by row, or nullptr if it isn't one of
+    // this font.
+    const uint8_t *coverage(const Glyph &glyph) const;
+
     Math::Recti mesure(Codepoint codepoint) const;
 
     Math::Recti mesure(const char *string) const;
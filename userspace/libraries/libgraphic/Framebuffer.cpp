@@ -3,8 +3,10 @@
 #include <abi/Paths.h>
 
 #include <libgraphic/Framebuffer.h>
+#include <libgraphic/Spans.h>
 #include <libsystem/Result.h>
 #include <libsystem/core/Plugs.h>
+#include <libsystem/system/Memory.h>
 
 namespace Graphic
 {
@@ -41,13 +43,62 @@ Framebuffer::Framebuffer(Handle handle, RefPtr<Bitmap> bitmap)
     : _handle(handle),
       _bitmap(bitmap)
 {
+    map_scanout();
 }
 
 Framebuffer::~Framebuffer()
 {
+    unmap_scanout();
     __plug_handle_close(&_handle);
 }
 
+void Framebuffer::map_scanout()
+{
+    IOCallDisplayMapArgs map_args = {};
+    __plug_handle_call(&_handle, IOCALL_DISPLAY_MAP, &map_args);
+
+    // Not every device has memory we can write to, blit() goes through the
+    // kernel for those.
+    if (handle_has_error(&_handle))
+    {
+        return;
+    }
+
+    if (map_args.width != _bitmap->width() ||
+        map_args.height != _bitmap->height() ||
+        map_args.pitch < map_args.width * (int)sizeof(uint32_t))
+    {
+        return;
+    }
+
+    uintptr_t address = 0;
+    size_t size = 0;
+
+    if (memory_include(map_args.handle, &address, &size) != SUCCESS)
+    {
+        return;
+    }
+
+    if (size < (size_t)map_args.pitch * map_args.height)
+    {
+        memory_free(address);
+        return;
+    }
+
+    _scanout = reinterpret_cast<uint32_t *>(address);
+    _scanout_pitch = map_args.pitch;
+}
+
+void Framebuffer::unmap_scanout()
+{
+    if (_scanout)
+    {
+        memory_free(reinterpret_cast<uintptr_t>(_scanout));
+        _scanout = nullptr;
+        _scanout_pitch = 0;
+    }
+}
+
 Result Framebuffer::set_resolution(Math::Vec2i size)
 {
     auto bitmap = TRY(Bitmap::create_shared(size.x(), size.y()));
@@ -63,6 +114,10 @@ Result Framebuffer::set_resolution(Math::Vec2i size)
 
     _bitmap = bitmap;
 
+    // The pitch might have changed with the mode.
+    unmap_scanout();
+    map_scanout();
+
     return SUCCESS;
 }
 
@@ -104,14 +159,38 @@ void Framebuffer::mark_dirty_all()
     mark_dirty(_bitmap->bound());
 }
 
-void Framebuffer::blit()
+size_t Framebuffer::blit()
 {
     if (_dirty_bounds.empty())
     {
-        return;
+        return 0;
     }
 
+    // The device ignores alpha, which is the same as compositing the
+    // bitmap over black as long as it is premultiplied.
+    if (_bitmap->format() != BITMAP_PREMULTIPLIED)
+    {
+        _bitmap->convert_to(BITMAP_PREMULTIPLIED);
+    }
+
+    size_t pixels = 0;
+
     _dirty_bounds.foreach ([&](auto &bound) {
+        pixels += bound.area();
+
+        if (_scanout)
+        {
+            // The display wants blue first, swapping while copying costs
+            // about the same as the copy itself.
+            for (int y = bound.top(); y < bound.bottom(); y++)
+            {
+                auto *row = reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(_scanout) + y * _scanout_pitch);
+                swizzle_span(row + bound.x(), _bitmap->pixels() + y * _bitmap->width() + bound.x(), bound.width());
+            }
+
+            return Iteration::CONTINUE;
+        }
+
         IOCallDisplayBlitArgs args;
 
         args.buffer = reinterpret_cast<uint32_t *>(_bitmap->pixels());
@@ -134,6 +213,8 @@ void Framebuffer::blit()
     });
 
     _dirty_bounds.clear();
+
+    return pixels;
 }
 
 } // namespace Graphic
@@ -17,6 +17,15 @@ private:
 
     Vector<Math::Recti> _dirty_bounds{};
 
+    // The memory the display scans out of, if the device lets us map it.
+    // Otherwise the kernel copies the pixels over on every blit.
+    uint32_t *_scanout = nullptr;
+    int _scanout_pitch = 0;
+
+    void map_scanout();
+
+    void unmap_scanout();
+
 public:
     static ResultOr<OwnPtr<Framebuffer>> open();
 
@@ -24,6 +33,8 @@ public:
 
     Bitmap &bitmap() { return *_bitmap; }
 
+    bool mapped() { return _scanout != nullptr; }
+
     Framebuffer(Handle handle, RefPtr<Bitmap> bitmap);
 
     ~Framebuffer();
@@ -34,7 +45,8 @@ public:
 
     void mark_dirty_all();
 
-    void blit();
+    // Returns how many pixels went to the display.
+    size_t blit();
 };
 
 } // namespace Graphic
@@ -3,6 +3,7 @@
 
 #include <libgraphic/Font.h>
 #include <libgraphic/Painter.h>
+#include <libgraphic/Spans.h>
 #include <libgraphic/StackBlur.h>
 #include <libutils/Assert.h>
 #include <libutils/Random.h>
@@ -31,14 +32,38 @@ void Painter::blit_fast(Bitmap &bitmap, Math::Recti source, Math::Recti destinat
         return;
     }
 
-    for (int y = 0; y < result.destination.height(); y++)
+    Math::Recti sampled{result.source.position(), result.destination.size()};
+
+    // Parts of the source outside of the bitmap are clamped to its edges,
+    // and pixels have to be converted between formats one by one.
+    if (!bitmap.bound().contains(sampled) || bitmap.format() != _bitmap.format())
     {
-        for (int x = 0; x < result.destination.width(); x++)
+        for (int y = 0; y < result.destination.height(); y++)
         {
-            Math::Vec2i position(x, y);
+            for (int x = 0; x < result.destination.width(); x++)
+            {
+                Math::Vec2i position(x, y);
+
+                Color sample = bitmap.get_pixel(result.source.position() + position);
+                _bitmap.blend_pixel(result.destination.position() + position, sample, bitmap.format());
+            }
+        }
+
+        return;
+    }
+
+    for (int y = 0; y < result.destination.height(); y++)
+    {
+        Color *source_row = bitmap.pixels() + (sampled.y() + y) * bitmap.width() + sampled.x();
+        Color *destination_row = _bitmap.pixels() + (result.destination.y() + y) * _bitmap.width() + result.destination.x();
 
-            Color sample = bitmap.get_pixel(result.source.position() + position);
-            _bitmap.blend_pixel(result.destination.position() + position, sample);
+        if (_bitmap.format() == BITMAP_PREMULTIPLIED)
+        {
+            blend_span_premultiplied(destination_row, source_row, result.destination.width());
+        }
+        else
+        {
+            blend_span(destination_row, source_row, result.destination.width());
         }
     }
 }
@@ -52,15 +77,19 @@ void Painter::blit_scaled(Bitmap &bitmap, Math::Recti source, Math::Recti destin
         return;
     }
 
-    for (int y = 0; y < result.destination.height(); y++)
+    // Pixels are sampled by where they are in the whole destination, so
+    // the same pixel comes out however the blit is clipped.
+    auto transformed = destination.offset(_stack.origin());
+
+    for (int y = result.destination.top(); y < result.destination.bottom(); y++)
     {
-        for (int x = 0; x < result.destination.width(); x++)
+        for (int x = result.destination.left(); x < result.destination.right(); x++)
         {
-            float xx = x / (float)result.destination.width();
-            float yy = y / (float)result.destination.height();
+            float xx = (x - transformed.x()) / (float)transformed.width();
+            float yy = (y - transformed.y()) / (float)transformed.height();
 
-            Color sample = bitmap.sample(result.source, Math::Vec2f(xx, yy));
-            _bitmap.blend_pixel(result.destination.position() + Math::Vec2i(x, y), sample);
+            Color sample = bitmap.sample(source, Math::Vec2f(xx, yy));
+            _bitmap.blend_pixel({x, y}, sample, bitmap.format());
         }
     }
 }
@@ -116,23 +145,22 @@ FLATTEN void Painter::clear(Math::Recti rectangle, Color color)
         return;
     }
 
-    for (int y = 0; y < rectangle.height(); y++)
+    Color pixel = _bitmap.encode(color);
+
+    for (int y = rectangle.y(); y < rectangle.y() + rectangle.height(); y++)
     {
-        for (int x = 0; x < rectangle.width(); x++)
-        {
-            _bitmap.set_pixel_no_check(Math::Vec2i(rectangle.x() + x, rectangle.y() + y), color);
-        }
+        fill_span(_bitmap.pixels() + y * _bitmap.width() + rectangle.x(), pixel, rectangle.width());
     }
 }
 
-void Painter::fill(const Path &path, const Math::Mat3x2f &transform, Paint paint)
+void Painter::fill(const Path &path, const Math::Mat3x2f &transform, Paint paint, FillRule rule)
 {
-    _rasterizer.fill(path, transform, paint);
+    _rasterizer.fill(path, transform, paint, rule);
 }
 
-void Painter::fill(const EdgeList &edges, const Math::Mat3x2f &transform, Paint paint)
+void Painter::fill(const EdgeList &edges, const Math::Mat3x2f &transform, Paint paint, FillRule rule)
 {
-    _rasterizer.fill(edges, transform, paint);
+    _rasterizer.fill(edges, transform, paint, rule);
 }
 
 FLATTEN void Painter::fill_rectangle(Math::Recti rectangle, Color color)
@@ -144,11 +172,20 @@ FLATTEN void Painter::fill_rectangle(Math::Recti rectangle, Color color)
         return;
     }
 
-    for (int y = 0; y < rectangle.height(); y++)
+    if (_bitmap.format() == BITMAP_PREMULTIPLIED)
     {
-        for (int x = 0; x < rectangle.width(); x++)
+        Color pixel = color.premultiplied();
+
+        for (int y = rectangle.y(); y < rectangle.y() + rectangle.height(); y++)
         {
-            _bitmap.blend_pixel_no_check(Math::Vec2i(rectangle.x() + x, rectangle.y() + y), color);
+            blend_span_color_premultiplied(_bitmap.pixels() + y * _bitmap.width() + rectangle.x(), pixel, rectangle.width());
+        }
+    }
+    else
+    {
+        for (int y = rectangle.y(); y < rectangle.y() + rectangle.height(); y++)
+        {
+            blend_span_color(_bitmap.pixels() + y * _bitmap.width() + rectangle.x(), color, rectangle.width());
         }
     }
 }
@@ -211,7 +248,7 @@ void Painter::blit_circle_helper(Bitmap &bitmap, Math::Recti source, Math::Recti
             float xx = x / (float)destination.width();
             float yy = y / (float)destination.height();
 
-            Color color = bitmap.sample(source, {xx, yy});
+            Color color = bitmap.decode(bitmap.sample(source, {xx, yy}));
             double alpha = color.alphaf() * distance;
 
             plot(destination.position() + position, color.with_alpha(alpha));
@@ -492,34 +529,108 @@ FLATTEN void Painter::blit_colored(Bitmap &bitmap, Math::Recti source, Math::Rec
     }
 }
 
+void Painter::add_glyph(Font &font, const Glyph &glyph, Math::Vec2i position, Color color)
+{
+    Math::Recti destination{position - glyph.origin + _stack.origin(), glyph.bound.size()};
+    auto clipped = destination.clipped_with(_stack.clip());
+
+    if (clipped.is_empty())
+    {
+        return;
+    }
+
+    auto *coverage = font.coverage(glyph);
+
+    if (coverage == nullptr)
+    {
+        blit_colored(font.bitmap(), glyph.bound, {position - glyph.origin, glyph.bound.size()}, color);
+        return;
+    }
+
+    coverage += (clipped.y() - destination.y()) * glyph.bound.width() + (clipped.x() - destination.x());
+    _quads.push_back({clipped, coverage, glyph.bound.width()});
+}
+
+void Painter::blend_glyphs(Color color)
+{
+    if (_quads.empty())
+    {
+        return;
+    }
+
+    int top = _quads[0].destination.top();
+    int bottom = _quads[0].destination.bottom();
+
+    for (size_t i = 1; i < _quads.count(); i++)
+    {
+        top = MIN(top, _quads[i].destination.top());
+        bottom = MAX(bottom, _quads[i].destination.bottom());
+    }
+
+    Color premultiplied = color.premultiplied();
+
+    for (int y = top; y < bottom; y++)
+    {
+        Color *row = _bitmap.pixels() + y * _bitmap.width();
+
+        for (size_t i = 0; i < _quads.count(); i++)
+        {
+            auto &quad = _quads[i];
+
+            if (y < quad.destination.top() || y >= quad.destination.bottom())
+            {
+                continue;
+            }
+
+            auto *coverage = quad.coverage + (y - quad.destination.top()) * quad.stride;
+
+            if (_bitmap.format() == BITMAP_PREMULTIPLIED)
+            {
+                blend_span_mask_premultiplied(row + quad.destination.x(), premultiplied, coverage, quad.destination.width());
+            }
+            else
+            {
+                for (int x = 0; x < quad.destination.width(); x++)
+                {
+                    auto alpha = Color::div255(color.alpha() * coverage[x]);
+                    _bitmap.blend_pixel_no_check({quad.destination.x() + x, y}, color.with_alpha_byte(alpha));
+                }
+            }
+        }
+    }
+
+    _quads.clear();
+}
+
 void Painter::draw_glyph(Font &font, const Glyph &glyph, Math::Vec2i position, Color color)
 {
-    Math::Recti dest(position - glyph.origin, glyph.bound.size());
+    add_glyph(font, glyph, position, color);
+    blend_glyphs(color);
+}
 
-    // auto metrics = font.metrics();
-    // auto baseline = position.y();
-    //
-    // auto draw_metric = [&](int value, Color color) {
-    //     draw_line({position.x(), value}, {position.x() + glyph.bound.width(), value}, color);
-    // };
-    //
-    //  draw_metric(metrics.fullascend(baseline), Colors::RED);
-    //  draw_metric(metrics.ascend(baseline), Colors::ORANGE);
-    //  draw_metric(metrics.captop(baseline), Colors::BLUE);
-    //  draw_metric(baseline, Colors::MAGENTA);
-    //  draw_metric(metrics.descend(baseline), Colors::ORANGE);
-    //  draw_metric(metrics.fulldescend(baseline), Colors::RED);
+Math::Vec2i Painter::draw_text_run(Font &font, const Codepoint *codepoints, size_t count, Math::Vec2i position, Color color, int advance)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        auto &glyph = font.glyph(codepoints[i]);
+        add_glyph(font, glyph, position, color);
+        position = position + Math::Vec2i(advance ? advance : glyph.advance, 0);
+    }
 
-    blit_colored(font.bitmap(), glyph.bound, dest, color);
+    blend_glyphs(color);
+
+    return position;
 }
 
 FLATTEN void Painter::draw_string(Font &font, const char *str, Math::Vec2i position, Color color)
 {
     codepoint_foreach(reinterpret_cast<const uint8_t *>(str), [&](auto codepoint) {
         auto &glyph = font.glyph(codepoint);
-        draw_glyph(font, glyph, position, color);
+        add_glyph(font, glyph, position, color);
         position = position + Math::Vec2i(glyph.advance, 0);
     });
+
+    blend_glyphs(color);
 }
 
 void Painter::draw_string_within(Font &font, const char *str, Math::Recti container, Anchor anchor, Color color)
@@ -625,11 +736,27 @@ FLATTEN void Painter::tint(Math::Recti rectangle, Color color)
     }
 }
 
-void Painter::acrylic(Math::Recti rectangle)
+void Painter::acrylic(Math::Recti rectangle, Acrylic parameters)
+{
+    saturation(rectangle, parameters.saturation);
+    blur(rectangle, parameters.blur);
+    noise(rectangle, parameters.noise);
+}
+
+void Painter::acrylic(Math::Recti rectangle, EffectCache &cache, Acrylic parameters)
 {
-    saturation(rectangle, 0.25);
-    blur(rectangle, 16);
-    noise(rectangle, 0.05);
+    // The key is where the effect lands in the bitmap, a different clip
+    // or origin gives a different result.
+    Math::Recti bound = _stack.apply(rectangle);
+    uint32_t source = EffectCache::fingerprint(_bitmap, bound);
+
+    if (cache.restore(_bitmap, source, bound, parameters))
+    {
+        return;
+    }
+
+    acrylic(rectangle, parameters);
+    cache.store(_bitmap, source, bound, parameters);
 }
 
 } // namespace Graphic
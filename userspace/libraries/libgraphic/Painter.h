@@ -7,6 +7,7 @@
 #include <libgraphic/Icon.h>
 
 #include <libgraphic/Bitmap.h>
+#include <libgraphic/EffectCache.h>
 #include <libgraphic/rast/Rasterizer.h>
 #include <libgraphic/rast/TransformStack.h>
 
@@ -16,10 +17,21 @@ namespace Graphic
 class Painter
 {
 private:
+    // Where a glyph goes in the bitmap, clipped, and its coverage from the
+    // first pixel that is drawn.
+    struct GlyphQuad
+    {
+        Math::Recti destination;
+        const uint8_t *coverage;
+        int stride;
+    };
+
     Bitmap &_bitmap;
     TransformStack _stack;
     Rasterizer _rasterizer;
 
+    Vector<GlyphQuad> _quads;
+
 public:
     Bitmap &bitmap() const
     {
@@ -52,8 +64,8 @@ public:
     void clear(Color color);
     void clear(Math::Recti rectangle, Color color);
 
-    void fill(const Path &path, const Math::Mat3x2f &transform, Paint paint);
-    void fill(const EdgeList &edges, const Math::Mat3x2f &transform, Paint paint);
+    void fill(const Path &path, const Math::Mat3x2f &transform, Paint paint, FillRule rule = FillRule::NONZERO);
+    void fill(const EdgeList &edges, const Math::Mat3x2f &transform, Paint paint, FillRule rule = FillRule::NONZERO);
 
     void fill_rectangle(Math::Recti rectangle, Color color);
     void fill_insets(Math::Recti rectangle, Insetsi insets, Color color);
@@ -65,6 +77,13 @@ public:
     void draw_triangle(Math::Vec2i p0, Math::Vec2i p1, Math::Vec2i p2, Color color);
     void draw_rectangle_rounded(Math::Recti bound, int radius, int thickness, Color color);
     void draw_glyph(Font &font, const Glyph &glyph, Math::Vec2i position, Color color);
+
+    // Draws glyphs one after the other from `position`, on the baseline,
+    // blending them a row of the bitmap at a time. Glyphs are `advance`
+    // apart when it's given, by their own advance otherwise. Returns where
+    // the next glyph would go.
+    Math::Vec2i draw_text_run(Font &font, const Codepoint *codepoints, size_t count, Math::Vec2i position, Color color, int advance = 0);
+
     void draw_string(Font &font, const char *str, Math::Vec2i position, Color color);
     void draw_string_within(Font &font, const char *str, Math::Recti container, Anchor anchor, Color color);
 
@@ -73,7 +92,8 @@ public:
     void blur(Math::Recti rectangle, int radius);
     void saturation(Math::Recti rectangle, float value);
     void noise(Math::Recti rectangle, float opacity);
-    void acrylic(Math::Recti rectangle);
+    void acrylic(Math::Recti rectangle, Acrylic parameters = {});
+    void acrylic(Math::Recti rectangle, EffectCache &cache, Acrylic parameters = {});
     void sepia(Math::Recti rectangle, float value);
     void tint(Math::Recti rectangle, Color color);
 
@@ -86,6 +106,10 @@ private:
     void fill_circle_helper(Math::Recti bound, Math::Vec2i center, int radius, Color color);
 
     void draw_circle_helper(Math::Recti bound, Math::Vec2i center, int radius, int thickness, Color color);
+
+    void add_glyph(Font &font, const Glyph &glyph, Math::Vec2i position, Color color);
+
+    void blend_glyphs(Color color);
 };
 
 } // namespace Graphic
\ No newline at end of file
@@ -0,0 +1,875 @@
+#include <libgraphic/Spans.h>
+
+#if defined(__i386__) || defined(__x86_64__)
+#    define SPANS_X86
+#    include <cpuid.h>
+#    include <immintrin.h>
+#endif
+
+namespace Graphic
+{
+
+/* --- Scalar --------------------------------------------------------------- */
+
+static void copy_scalar(Color *destination, const Color *source, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        destination[i] = source[i];
+    }
+}
+
+static void fill_scalar(Color *destination, Color color, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        destination[i] = color;
+    }
+}
+
+static void blend_scalar(Color *destination, const Color *source, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        destination[i] = Color::blend(source[i], destination[i]);
+    }
+}
+
+static void blend_premultiplied_scalar(Color *destination, const Color *source, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        destination[i] = Color::blend_premultiplied(source[i], destination[i]);
+    }
+}
+
+static void blend_color_scalar(Color *destination, Color color, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        destination[i] = Color::blend(color, destination[i]);
+    }
+}
+
+static void blend_color_premultiplied_scalar(Color *destination, Color color, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        destination[i] = Color::blend_premultiplied(color, destination[i]);
+    }
+}
+
+static void blend_mask_premultiplied_scalar(Color *destination, Color color, const uint8_t *mask, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (mask[i] == 0)
+        {
+            continue;
+        }
+
+        Color covered = Color::from_rgba_byte(
+            Color::div255(color.red() * mask[i]),
+            Color::div255(color.green() * mask[i]),
+            Color::div255(color.blue() * mask[i]),
+            Color::div255(color.alpha() * mask[i]));
+
+        destination[i] = Color::blend_premultiplied(covered, destination[i]);
+    }
+}
+
+static void swizzle_scalar(uint32_t *destination, const Color *source, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t pixel;
+        __builtin_memcpy(&pixel, &source[i], sizeof(pixel));
+
+        destination[i] = ((pixel >> 16) & 0x000000ff) |
+                         (pixel & 0xff00ff00) |
+                         ((pixel << 16) & 0x00ff0000);
+    }
+}
+
+static const SpanKernels _scalar_kernels = {
+    "scalar",
+    copy_scalar,
+    fill_scalar,
+    blend_scalar,
+    blend_premultiplied_scalar,
+    blend_color_scalar,
+    blend_color_premultiplied_scalar,
+    blend_mask_premultiplied_scalar,
+    swizzle_scalar,
+};
+
+#ifdef SPANS_X86
+
+/* --- SSE2 ----------------------------------------------------------------- */
+
+// Pixels are red, green, blue, alpha in memory, so alpha is the top byte of
+// each 32 bits lane. Once widened to 16 bits, it is the last of each group
+// of four.
+
+#    define TARGET_SSE2 __attribute__((target("sse2")))
+
+TARGET_SSE2 static inline __m128i alpha_mask_sse2()
+{
+    return _mm_set1_epi32((int)0xff000000);
+}
+
+TARGET_SSE2 static inline bool all_set_sse2(__m128i mask)
+{
+    return _mm_movemask_epi8(mask) == 0xffff;
+}
+
+TARGET_SSE2 static inline __m128i broadcast_alpha_sse2(__m128i pixels)
+{
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+// (alpha * fg + (256 - alpha) * bg) / 256 like Color::blend does over an
+// opaque background, except that an opaque foreground counts as 256 so it
+// comes out unchanged, as it does there. Two pixels widened to 16 bits.
+TARGET_SSE2 static inline __m128i blend_half_sse2(__m128i fg, __m128i bg)
+{
+    __m128i alpha = broadcast_alpha_sse2(fg);
+    alpha = _mm_sub_epi16(alpha, _mm_cmpeq_epi16(alpha, _mm_set1_epi16(255)));
+
+    __m128i inv_alpha = _mm_sub_epi16(_mm_set1_epi16(256), alpha);
+
+    return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(fg, alpha), _mm_mullo_epi16(bg, inv_alpha)), 8);
+}
+
+TARGET_SSE2 static inline __m128i blend_opaque_sse2(__m128i fg, __m128i bg)
+{
+    __m128i zero = _mm_setzero_si128();
+
+    __m128i lo = blend_half_sse2(_mm_unpacklo_epi8(fg, zero), _mm_unpacklo_epi8(bg, zero));
+    __m128i hi = blend_half_sse2(_mm_unpackhi_epi8(fg, zero), _mm_unpackhi_epi8(bg, zero));
+
+    return _mm_or_si128(_mm_packus_epi16(lo, hi), alpha_mask_sse2());
+}
+
+// bg * (255 - alpha) / 255, rounded like Color::div255().
+TARGET_SSE2 static inline __m128i scale_half_sse2(__m128i fg, __m128i bg)
+{
+    __m128i inv_alpha = _mm_sub_epi16(_mm_set1_epi16(255), broadcast_alpha_sse2(fg));
+
+    __m128i value = _mm_add_epi16(_mm_mullo_epi16(bg, inv_alpha), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+}
+
+TARGET_SSE2 static void copy_sse2(Color *destination, const Color *source, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i + 4));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i + 8));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i + 12));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), a);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i + 4), b);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i + 8), c);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i + 12), d);
+    }
+
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i)));
+    }
+
+    copy_scalar(destination + i, source + i, count - i);
+}
+
+TARGET_SSE2 static void fill_sse2(Color *destination, Color color, size_t count)
+{
+    uint32_t packed;
+    __builtin_memcpy(&packed, &color, sizeof(packed));
+
+    __m128i pixels = _mm_set1_epi32((int)packed);
+
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), pixels);
+    }
+
+    fill_scalar(destination + i, color, count - i);
+}
+
+TARGET_SSE2 static void blend_sse2(Color *destination, const Color *source, size_t count)
+{
+    __m128i alpha_mask = alpha_mask_sse2();
+    __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i fg = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+        __m128i fg_alpha = _mm_and_si128(fg, alpha_mask);
+
+        if (all_set_sse2(_mm_cmpeq_epi32(fg_alpha, alpha_mask)))
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), fg);
+            continue;
+        }
+
+        if (all_set_sse2(_mm_cmpeq_epi32(fg_alpha, zero)))
+        {
+            continue;
+        }
+
+        __m128i bg = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination + i));
+
+        if (all_set_sse2(_mm_cmpeq_epi32(_mm_and_si128(bg, alpha_mask), alpha_mask)))
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), blend_opaque_sse2(fg, bg));
+        }
+        else
+        {
+            // Translucent background, rare enough to not be worth it.
+            blend_scalar(destination + i, source + i, 4);
+        }
+    }
+
+    blend_scalar(destination + i, source + i, count - i);
+}
+
+TARGET_SSE2 static void blend_premultiplied_sse2(Color *destination, const Color *source, size_t count)
+{
+    __m128i alpha_mask = alpha_mask_sse2();
+    __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i fg = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+
+        if (all_set_sse2(_mm_cmpeq_epi32(_mm_and_si128(fg, alpha_mask), alpha_mask)))
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), fg);
+            continue;
+        }
+
+        if (all_set_sse2(_mm_cmpeq_epi32(fg, zero)))
+        {
+            continue;
+        }
+
+        __m128i bg = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination + i));
+
+        __m128i lo = scale_half_sse2(_mm_unpacklo_epi8(fg, zero), _mm_unpacklo_epi8(bg, zero));
+        __m128i hi = scale_half_sse2(_mm_unpackhi_epi8(fg, zero), _mm_unpackhi_epi8(bg, zero));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_adds_epu8(fg, _mm_packus_epi16(lo, hi)));
+    }
+
+    blend_premultiplied_scalar(destination + i, source + i, count - i);
+}
+
+TARGET_SSE2 static void blend_color_sse2(Color *destination, Color color, size_t count)
+{
+    if (color.alpha() == 0xff)
+    {
+        fill_sse2(destination, color, count);
+        return;
+    }
+
+    if (color.alpha() == 0)
+    {
+        return;
+    }
+
+    __m128i alpha_mask = alpha_mask_sse2();
+    __m128i zero = _mm_setzero_si128();
+
+    // Everything coming from the color is the same for every pixel.
+    __m128i fg = _mm_setr_epi16(color.red(), color.green(), color.blue(), color.alpha(), color.red(), color.green(), color.blue(), color.alpha());
+    __m128i fg_term = _mm_mullo_epi16(fg, _mm_set1_epi16(color.alpha()));
+    __m128i inv_alpha = _mm_set1_epi16(256 - color.alpha());
+
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i bg = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination + i));
+
+        if (!all_set_sse2(_mm_cmpeq_epi32(_mm_and_si128(bg, alpha_mask), alpha_mask)))
+        {
+            blend_color_scalar(destination + i, color, 4);
+            continue;
+        }
+
+        __m128i lo = _mm_srli_epi16(_mm_add_epi16(fg_term, _mm_mullo_epi16(_mm_unpacklo_epi8(bg, zero), inv_alpha)), 8);
+        __m128i hi = _mm_srli_epi16(_mm_add_epi16(fg_term, _mm_mullo_epi16(_mm_unpackhi_epi8(bg, zero), inv_alpha)), 8);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_or_si128(_mm_packus_epi16(lo, hi), alpha_mask));
+    }
+
+    blend_color_scalar(destination + i, color, count - i);
+}
+
+TARGET_SSE2 static void blend_color_premultiplied_sse2(Color *destination, Color color, size_t count)
+{
+    if (color.alpha() == 0xff)
+    {
+        fill_sse2(destination, color, count);
+        return;
+    }
+
+    uint32_t packed;
+    __builtin_memcpy(&packed, &color, sizeof(packed));
+
+    __m128i fg = _mm_set1_epi32((int)packed);
+    __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i bg = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination + i));
+
+        __m128i lo = scale_half_sse2(_mm_unpacklo_epi8(fg, zero), _mm_unpacklo_epi8(bg, zero));
+        __m128i hi = scale_half_sse2(_mm_unpackhi_epi8(fg, zero), _mm_unpackhi_epi8(bg, zero));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_adds_epu8(fg, _mm_packus_epi16(lo, hi)));
+    }
+
+    blend_color_premultiplied_scalar(destination + i, color, count - i);
+}
+
+// Scales 16 bits channels by the coverage, rounding like Color::div255.
+TARGET_SSE2 static inline __m128i scale_coverage_sse2(__m128i channels, __m128i coverage)
+{
+    __m128i value = _mm_add_epi16(_mm_mullo_epi16(channels, coverage), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+}
+
+TARGET_SSE2 static void blend_mask_premultiplied_sse2(Color *destination, Color color, const uint8_t *mask, size_t count)
+{
+    uint32_t packed;
+    __builtin_memcpy(&packed, &color, sizeof(packed));
+
+    __m128i color_pixels = _mm_set1_epi32((int)packed);
+    __m128i zero = _mm_setzero_si128();
+    __m128i color_half = _mm_unpacklo_epi8(color_pixels, zero);
+
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32_t coverages;
+        __builtin_memcpy(&coverages, mask + i, sizeof(coverages));
+
+        if (coverages == 0)
+        {
+            continue;
+        }
+
+        if (coverages == 0xffffffff && color.alpha() == 0xff)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), color_pixels);
+            continue;
+        }
+
+        // Each coverage goes to the four channels of its pixel.
+        __m128i coverage = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)coverages), zero);
+        coverage = _mm_unpacklo_epi16(coverage, coverage);
+
+        __m128i fg_lo = scale_coverage_sse2(color_half, _mm_unpacklo_epi32(coverage, coverage));
+        __m128i fg_hi = scale_coverage_sse2(color_half, _mm_unpackhi_epi32(coverage, coverage));
+
+        __m128i bg = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destination + i));
+
+        __m128i lo = scale_half_sse2(fg_lo, _mm_unpacklo_epi8(bg, zero));
+        __m128i hi = scale_half_sse2(fg_hi, _mm_unpackhi_epi8(bg, zero));
+
+        __m128i fg = _mm_packus_epi16(fg_lo, fg_hi);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), _mm_adds_epu8(fg, _mm_packus_epi16(lo, hi)));
+    }
+
+    blend_mask_premultiplied_scalar(destination + i, color, mask + i, count - i);
+}
+
+// Red and blue are the only bytes set after masking, shifting each pixel
+// both ways moves one into the place of the other.
+TARGET_SSE2 static inline __m128i swizzle_pixels_sse2(__m128i pixels)
+{
+    __m128i red_blue = _mm_and_si128(pixels, _mm_set1_epi32(0x00ff00ff));
+    __m128i green_alpha = _mm_and_si128(pixels, _mm_set1_epi32((int)0xff00ff00));
+
+    return _mm_or_si128(green_alpha, _mm_or_si128(_mm_slli_epi32(red_blue, 16), _mm_srli_epi32(red_blue, 16)));
+}
+
+TARGET_SSE2 static void swizzle_sse2(uint32_t *destination, const Color *source, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i + 4));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), swizzle_pixels_sse2(a));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i + 4), swizzle_pixels_sse2(b));
+    }
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i), swizzle_pixels_sse2(pixels));
+    }
+
+    swizzle_scalar(destination + i, source + i, count - i);
+}
+
+static const SpanKernels _sse2_kernels = {
+    "sse2",
+    copy_sse2,
+    fill_sse2,
+    blend_sse2,
+    blend_premultiplied_sse2,
+    blend_color_sse2,
+    blend_color_premultiplied_sse2,
+    blend_mask_premultiplied_sse2,
+    swizzle_sse2,
+};
+
+/* --- AVX2 ----------------------------------------------------------------- */
+
+// Same as the SSE2 kernels, eight pixels at a time. Unpacking and packing
+// both work within each 128 bits half, so the pixels stay in order. What
+// is left at the end goes through the SSE2 kernels.
+
+#    define TARGET_AVX2 __attribute__((target("avx2")))
+
+TARGET_AVX2 static inline __m256i alpha_mask_avx2()
+{
+    return _mm256_set1_epi32((int)0xff000000);
+}
+
+TARGET_AVX2 static inline bool all_set_avx2(__m256i mask)
+{
+    return _mm256_movemask_epi8(mask) == -1;
+}
+
+TARGET_AVX2 static inline __m256i broadcast_alpha_avx2(__m256i pixels)
+{
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+TARGET_AVX2 static inline __m256i blend_half_avx2(__m256i fg, __m256i bg)
+{
+    __m256i alpha = broadcast_alpha_avx2(fg);
+    alpha = _mm256_sub_epi16(alpha, _mm256_cmpeq_epi16(alpha, _mm256_set1_epi16(255)));
+
+    __m256i inv_alpha = _mm256_sub_epi16(_mm256_set1_epi16(256), alpha);
+
+    return _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(fg, alpha), _mm256_mullo_epi16(bg, inv_alpha)), 8);
+}
+
+TARGET_AVX2 static inline __m256i blend_opaque_avx2(__m256i fg, __m256i bg)
+{
+    __m256i zero = _mm256_setzero_si256();
+
+    __m256i lo = blend_half_avx2(_mm256_unpacklo_epi8(fg, zero), _mm256_unpacklo_epi8(bg, zero));
+    __m256i hi = blend_half_avx2(_mm256_unpackhi_epi8(fg, zero), _mm256_unpackhi_epi8(bg, zero));
+
+    return _mm256_or_si256(_mm256_packus_epi16(lo, hi), alpha_mask_avx2());
+}
+
+TARGET_AVX2 static inline __m256i scale_half_avx2(__m256i fg, __m256i bg)
+{
+    __m256i inv_alpha = _mm256_sub_epi16(_mm256_set1_epi16(255), broadcast_alpha_avx2(fg));
+
+    __m256i value = _mm256_add_epi16(_mm256_mullo_epi16(bg, inv_alpha), _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(value, _mm256_srli_epi16(value, 8)), 8);
+}
+
+TARGET_AVX2 static void copy_avx2(Color *destination, const Color *source, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 32 <= count; i += 32)
+    {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i + 8));
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i + 16));
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i + 24));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), a);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i + 8), b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i + 16), c);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i + 24), d);
+    }
+
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i)));
+    }
+
+    copy_sse2(destination + i, source + i, count - i);
+}
+
+TARGET_AVX2 static void fill_avx2(Color *destination, Color color, size_t count)
+{
+    uint32_t packed;
+    __builtin_memcpy(&packed, &color, sizeof(packed));
+
+    __m256i pixels = _mm256_set1_epi32((int)packed);
+
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), pixels);
+    }
+
+    fill_sse2(destination + i, color, count - i);
+}
+
+TARGET_AVX2 static void blend_avx2(Color *destination, const Color *source, size_t count)
+{
+    __m256i alpha_mask = alpha_mask_avx2();
+    __m256i zero = _mm256_setzero_si256();
+
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i fg = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+        __m256i fg_alpha = _mm256_and_si256(fg, alpha_mask);
+
+        if (all_set_avx2(_mm256_cmpeq_epi32(fg_alpha, alpha_mask)))
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), fg);
+            continue;
+        }
+
+        if (all_set_avx2(_mm256_cmpeq_epi32(fg_alpha, zero)))
+        {
+            continue;
+        }
+
+        __m256i bg = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination + i));
+
+        if (all_set_avx2(_mm256_cmpeq_epi32(_mm256_and_si256(bg, alpha_mask), alpha_mask)))
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), blend_opaque_avx2(fg, bg));
+        }
+        else
+        {
+            blend_scalar(destination + i, source + i, 8);
+        }
+    }
+
+    blend_sse2(destination + i, source + i, count - i);
+}
+
+TARGET_AVX2 static void blend_premultiplied_avx2(Color *destination, const Color *source, size_t count)
+{
+    __m256i alpha_mask = alpha_mask_avx2();
+    __m256i zero = _mm256_setzero_si256();
+
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i fg = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+
+        if (all_set_avx2(_mm256_cmpeq_epi32(_mm256_and_si256(fg, alpha_mask), alpha_mask)))
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), fg);
+            continue;
+        }
+
+        if (all_set_avx2(_mm256_cmpeq_epi32(fg, zero)))
+        {
+            continue;
+        }
+
+        __m256i bg = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination + i));
+
+        __m256i lo = scale_half_avx2(_mm256_unpacklo_epi8(fg, zero), _mm256_unpacklo_epi8(bg, zero));
+        __m256i hi = scale_half_avx2(_mm256_unpackhi_epi8(fg, zero), _mm256_unpackhi_epi8(bg, zero));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_adds_epu8(fg, _mm256_packus_epi16(lo, hi)));
+    }
+
+    blend_premultiplied_sse2(destination + i, source + i, count - i);
+}
+
+TARGET_AVX2 static void blend_color_avx2(Color *destination, Color color, size_t count)
+{
+    if (color.alpha() == 0xff)
+    {
+        fill_avx2(destination, color, count);
+        return;
+    }
+
+    if (color.alpha() == 0)
+    {
+        return;
+    }
+
+    __m256i alpha_mask = alpha_mask_avx2();
+    __m256i zero = _mm256_setzero_si256();
+
+    __m256i fg = _mm256_setr_epi16(
+        color.red(), color.green(), color.blue(), color.alpha(),
+        color.red(), color.green(), color.blue(), color.alpha(),
+        color.red(), color.green(), color.blue(), color.alpha(),
+        color.red(), color.green(), color.blue(), color.alpha());
+
+    __m256i fg_term = _mm256_mullo_epi16(fg, _mm256_set1_epi16(color.alpha()));
+    __m256i inv_alpha = _mm256_set1_epi16(256 - color.alpha());
+
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i bg = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination + i));
+
+        if (!all_set_avx2(_mm256_cmpeq_epi32(_mm256_and_si256(bg, alpha_mask), alpha_mask)))
+        {
+            blend_color_scalar(destination + i, color, 8);
+            continue;
+        }
+
+        __m256i lo = _mm256_srli_epi16(_mm256_add_epi16(fg_term, _mm256_mullo_epi16(_mm256_unpacklo_epi8(bg, zero), inv_alpha)), 8);
+        __m256i hi = _mm256_srli_epi16(_mm256_add_epi16(fg_term, _mm256_mullo_epi16(_mm256_unpackhi_epi8(bg, zero), inv_alpha)), 8);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_or_si256(_mm256_packus_epi16(lo, hi), alpha_mask));
+    }
+
+    blend_color_sse2(destination + i, color, count - i);
+}
+
+TARGET_AVX2 static void blend_color_premultiplied_avx2(Color *destination, Color color, size_t count)
+{
+    if (color.alpha() == 0xff)
+    {
+        fill_avx2(destination, color, count);
+        return;
+    }
+
+    uint32_t packed;
+    __builtin_memcpy(&packed, &color, sizeof(packed));
+
+    __m256i fg = _mm256_set1_epi32((int)packed);
+    __m256i zero = _mm256_setzero_si256();
+
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i bg = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination + i));
+
+        __m256i lo = scale_half_avx2(_mm256_unpacklo_epi8(fg, zero), _mm256_unpacklo_epi8(bg, zero));
+        __m256i hi = scale_half_avx2(_mm256_unpackhi_epi8(fg, zero), _mm256_unpackhi_epi8(bg, zero));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_adds_epu8(fg, _mm256_packus_epi16(lo, hi)));
+    }
+
+    blend_color_premultiplied_sse2(destination + i, color, count - i);
+}
+
+TARGET_AVX2 static inline __m256i scale_coverage_avx2(__m256i channels, __m256i coverage)
+{
+    __m256i value = _mm256_add_epi16(_mm256_mullo_epi16(channels, coverage), _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(value, _mm256_srli_epi16(value, 8)), 8);
+}
+
+TARGET_AVX2 static void blend_mask_premultiplied_avx2(Color *destination, Color color, const uint8_t *mask, size_t count)
+{
+    uint32_t packed;
+    __builtin_memcpy(&packed, &color, sizeof(packed));
+
+    __m256i color_pixels = _mm256_set1_epi32((int)packed);
+    __m256i zero = _mm256_setzero_si256();
+    __m256i color_half = _mm256_unpacklo_epi8(color_pixels, zero);
+
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8)
+    {
+        uint64_t coverages;
+        __builtin_memcpy(&coverages, mask + i, sizeof(coverages));
+
+        if (coverages == 0)
+        {
+            continue;
+        }
+
+        if (coverages == UINT64_MAX && color.alpha() == 0xff)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), color_pixels);
+            continue;
+        }
+
+        // Unpacking works within each 128 bits half, the first half gets
+        // the coverage of pixels 0 to 3 and the second one of 4 to 7.
+        __m128i coverage = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(mask + i)), _mm_setzero_si128());
+
+        __m256i coverage_pairs = _mm256_setr_m128i(
+            _mm_unpacklo_epi16(coverage, coverage),
+            _mm_unpackhi_epi16(coverage, coverage));
+
+        __m256i fg_lo = scale_coverage_avx2(color_half, _mm256_unpacklo_epi32(coverage_pairs, coverage_pairs));
+        __m256i fg_hi = scale_coverage_avx2(color_half, _mm256_unpackhi_epi32(coverage_pairs, coverage_pairs));
+
+        __m256i bg = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(destination + i));
+
+        __m256i lo = scale_half_avx2(fg_lo, _mm256_unpacklo_epi8(bg, zero));
+        __m256i hi = scale_half_avx2(fg_hi, _mm256_unpackhi_epi8(bg, zero));
+
+        __m256i fg = _mm256_packus_epi16(fg_lo, fg_hi);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_adds_epu8(fg, _mm256_packus_epi16(lo, hi)));
+    }
+
+    blend_mask_premultiplied_sse2(destination + i, color, mask + i, count - i);
+}
+
+// SSE2 has no byte shuffle, AVX2 moves red and blue in one instruction.
+TARGET_AVX2 static void swizzle_avx2(uint32_t *destination, const Color *source, size_t count)
+{
+    __m256i shuffle = _mm256_setr_epi8(
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i + 8));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_shuffle_epi8(a, shuffle));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i + 8), _mm256_shuffle_epi8(b, shuffle));
+    }
+
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i), _mm256_shuffle_epi8(pixels, shuffle));
+    }
+
+    swizzle_sse2(destination + i, source + i, count - i);
+}
+
+static const SpanKernels _avx2_kernels = {
+    "avx2",
+    copy_avx2,
+    fill_avx2,
+    blend_avx2,
+    blend_premultiplied_avx2,
+    blend_color_avx2,
+    blend_color_premultiplied_avx2,
+    blend_mask_premultiplied_avx2,
+    swizzle_avx2,
+};
+
+/* --- CPU Features --------------------------------------------------------- */
+
+static bool cpu_has_sse2()
+{
+    unsigned eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    {
+        return false;
+    }
+
+    return edx & bit_SSE2;
+}
+
+static bool cpu_has_avx2()
+{
+    unsigned eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    {
+        return false;
+    }
+
+    if (!(ecx & bit_AVX) || !(ecx & bit_OSXSAVE))
+    {
+        return false;
+    }
+
+    // The cpu having AVX isn't enough, the kernel also has to save and
+    // restore the upper half of the ymm registers.
+    uint32_t xcr0_low, xcr0_high;
+    asm volatile("xgetbv"
+                 : "=a"(xcr0_low), "=d"(xcr0_high)
+                 : "c"(0));
+
+    if ((xcr0_low & 0b110) != 0b110)
+    {
+        return false;
+    }
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+    {
+        return false;
+    }
+
+    return ebx & bit_AVX2;
+}
+
+#endif
+
+/* --- Dispatch ------------------------------------------------------------- */
+
+const SpanKernels *span_kernels(SpanIsa isa)
+{
+    switch (isa)
+    {
+    case SpanIsa::SCALAR:
+        return &_scalar_kernels;
+
+#ifdef SPANS_X86
+    case SpanIsa::SSE2:
+        return cpu_has_sse2() ? &_sse2_kernels : nullptr;
+
+    case SpanIsa::AVX2:
+        return cpu_has_avx2() ? &_avx2_kernels : nullptr;
+#endif
+
+    default:
+        return nullptr;
+    }
+}
+
+static const SpanKernels *_best_kernels = nullptr;
+
+const SpanKernels &span_kernels()
+{
+    if (_best_kernels == nullptr)
+    {
+        const SpanKernels *kernels = span_kernels(SpanIsa::AVX2);
+
+        if (kernels == nullptr)
+        {
+            kernels = span_kernels(SpanIsa::SSE2);
+        }
+
+        if (kernels == nullptr)
+        {
+            kernels = span_kernels(SpanIsa::SCALAR);
+        }
+
+        _best_kernels = kernels;
+    }
+
+    return *_best_kernels;
+}
+
+} // namespace Graphic
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <libgraphic/Color.h>
+
+namespace Graphic
+{
+
+// Kernels working on a run of pixels within a row. The bitmap and the
+// painter hand them whole rows, so the per pixel work is only the
+// arithmetic and the kernels can go through several pixels at once.
+struct SpanKernels
+{
+    const char *name;
+
+    void (*copy)(Color *destination, const Color *source, size_t count);
+
+    void (*fill)(Color *destination, Color color, size_t count);
+
+    // Same result as Color::blend for each pixel.
+    void (*blend)(Color *destination, const Color *source, size_t count);
+
+    // Same result as Color::blend_premultiplied for each pixel.
+    void (*blend_premultiplied)(Color *destination, const Color *source, size_t count);
+
+    // Same as `blend` but every source pixel is `color`.
+    void (*blend_color)(Color *destination, Color color, size_t count);
+
+    // Same as `blend_premultiplied` but every source pixel is `color`.
+    void (*blend_color_premultiplied)(Color *destination, Color color, size_t count);
+
+    // Same as `blend_color_premultiplied` with `color` scaled by the
+    // coverage in `mask` first, 255 being fully covered.
+    void (*blend_mask_premultiplied)(Color *destination, Color color, const uint8_t *mask, size_t count);
+
+    // Copies the pixels swapping red and blue, for displays that want blue
+    // first in memory.
+    void (*swizzle)(uint32_t *destination, const Color *source, size_t count);
+};
+
+enum class SpanIsa
+{
+    SCALAR,
+    SSE2,
+    AVX2,
+};
+
+// The kernels for `isa`, or nullptr if this cpu can't run them.
+const SpanKernels *span_kernels(SpanIsa isa);
+
+// The best kernels this cpu can run, picked the first time they are needed.
+const SpanKernels &span_kernels();
+
+inline void copy_span(Color *destination, const Color *source, size_t count)
+{
+    span_kernels().copy(destination, source, count);
+}
+
+inline void fill_span(Color *destination, Color color, size_t count)
+{
+    span_kernels().fill(destination, color, count);
+}
+
+inline void blend_span(Color *destination, const Color *source, size_t count)
+{
+    span_kernels().blend(destination, source, count);
+}
+
+inline void blend_span_premultiplied(Color *destination, const Color *source, size_t count)
+{
+    span_kernels().blend_premultiplied(destination, source, count);
+}
+
+inline void blend_span_color(Color *destination, Color color, size_t count)
+{
+    span_kernels().blend_color(destination, color, count);
+}
+
+inline void blend_span_color_premultiplied(Color *destination, Color color, size_t count)
+{
+    span_kernels().blend_color_premultiplied(destination, color, count);
+}
+
+inline void blend_span_mask_premultiplied(Color *destination, Color color, const uint8_t *mask, size_t count)
+{
+    span_kernels().blend_mask_premultiplied(destination, color, mask, count);
+}
+
+inline void swizzle_span(uint32_t *destination, const Color *source, size_t count)
+{
+    span_kernels().swizzle(destination, source, count);
+}
+
+} // namespace Graphic
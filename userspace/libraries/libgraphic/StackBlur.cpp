@@ -1,4 +1,11 @@
-#include <libgraphic/Painter.h>
+#include <libgraphic/StackBlur.h>
+#include <libmath/MinMax.h>
+#include <string.h>
+
+#if defined(__i386__) || defined(__x86_64__)
+#    define STACKBLUR_X86
+#    include <immintrin.h>
+#endif
 
 namespace Graphic
 {
@@ -39,247 +46,399 @@ static unsigned char const stackblur_shr[255] = {
     24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
     24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24};
 
-void stackblur(
-    unsigned char *src,  ///< input image data
-    unsigned int w,      ///< image width
-    unsigned int h,      ///< image height
-    unsigned int radius, ///< blur intensity (should be in 2..254 range)
-    unsigned int min_x,
-    unsigned int max_x,
-    unsigned int min_y,
-    unsigned int max_y)
+static constexpr unsigned STACKBLUR_STACK_SIZE = STACKBLUR_MAX_RADIUS * 2 + 1;
+
+/* --- Scalar --------------------------------------------------------------- */
+
+// Pixels are red, green, blue, alpha in memory, only the colors are blurred.
+static inline uint32_t stackblur_channel(uint32_t pixel, int channel)
 {
-    UNUSED(h);
+    return (pixel >> (channel * 8)) & 0xff;
+}
+
+static inline uint32_t stackblur_pixel_at(const unsigned char *line, size_t step, unsigned position)
+{
+    uint32_t pixel;
+    memcpy(&pixel, line + position * step, sizeof(pixel));
+    return pixel;
+}
+
+// Blurs `length` pixels, `step` bytes apart, in place. The stack holds the
+// pixels under the kernel and the sums are updated as it slides, so the
+// radius only costs something when starting a line.
+static void stackblur_line(unsigned char *line, size_t step, unsigned length, unsigned radius, uint32_t *stack)
+{
+    unsigned last = length - 1;
+    unsigned div = radius * 2 + 1;
+    uint64_t mul_sum = stackblur_mul[radius];
+    unsigned shr_sum = stackblur_shr[radius];
 
-    unsigned int x, y, xp, yp, i;
-    unsigned int sp;
-    unsigned int stack_start;
-    unsigned char *stack_ptr;
-
-    unsigned char *src_ptr;
-    unsigned char *dst_ptr;
-
-    unsigned long sum_r;
-    unsigned long sum_g;
-    unsigned long sum_b;
-    unsigned long sum_in_r;
-    unsigned long sum_in_g;
-    unsigned long sum_in_b;
-    unsigned long sum_out_r;
-    unsigned long sum_out_g;
-    unsigned long sum_out_b;
-
-    unsigned int wm = max_x - min_x - 1;
-    unsigned int hm = max_y - min_y - 1;
-    unsigned int w4 = w * 4;
-    unsigned int div = (radius * 2) + 1;
-    unsigned int mul_sum = stackblur_mul[radius];
-    unsigned char shr_sum = stackblur_shr[radius];
-    unsigned char stack[div * 3];
+    uint32_t sum[3] = {};
+    uint32_t sum_in[3] = {};
+    uint32_t sum_out[3] = {};
 
+    uint32_t pixel = stackblur_pixel_at(line, step, 0);
+
+    for (unsigned i = 0; i <= radius; i++)
     {
-        for (y = min_y; y < max_y; y++)
+        stack[i] = pixel;
+
+        for (int c = 0; c < 3; c++)
         {
-            sum_r = sum_g = sum_b =
-                sum_in_r = sum_in_g = sum_in_b =
-                    sum_out_r = sum_out_g = sum_out_b = 0;
+            sum[c] += stackblur_channel(pixel, c) * (i + 1);
+            sum_out[c] += stackblur_channel(pixel, c);
+        }
+    }
 
-            src_ptr = src + w4 * y + (min_x * 4); // start of line (0,y)
+    for (unsigned i = 1; i <= radius; i++)
+    {
+        pixel = stackblur_pixel_at(line, step, MIN(i, last));
+        stack[i + radius] = pixel;
 
-            for (i = 0; i <= radius; i++)
-            {
-                stack_ptr = &stack[3 * i];
-                stack_ptr[0] = src_ptr[0];
-                stack_ptr[1] = src_ptr[1];
-                stack_ptr[2] = src_ptr[2];
-                sum_r += src_ptr[0] * (i + 1);
-                sum_g += src_ptr[1] * (i + 1);
-                sum_b += src_ptr[2] * (i + 1);
-                sum_out_r += src_ptr[0];
-                sum_out_g += src_ptr[1];
-                sum_out_b += src_ptr[2];
-            }
+        for (int c = 0; c < 3; c++)
+        {
+            sum[c] += stackblur_channel(pixel, c) * (radius + 1 - i);
+            sum_in[c] += stackblur_channel(pixel, c);
+        }
+    }
 
-            for (i = 1; i <= radius; i++)
-            {
-                if (i <= wm)
-                    src_ptr += 4;
-                stack_ptr = &stack[3 * (i + radius)];
-                stack_ptr[0] = src_ptr[0];
-                stack_ptr[1] = src_ptr[1];
-                stack_ptr[2] = src_ptr[2];
-                sum_r += src_ptr[0] * (radius + 1 - i);
-                sum_g += src_ptr[1] * (radius + 1 - i);
-                sum_b += src_ptr[2] * (radius + 1 - i);
-                sum_in_r += src_ptr[0];
-                sum_in_g += src_ptr[1];
-                sum_in_b += src_ptr[2];
-            }
+    unsigned sp = radius;
+    unsigned xp = MIN(radius, last);
 
-            sp = radius;
-            xp = radius;
+    for (unsigned x = 0; x < length; x++)
+    {
+        unsigned char *destination = line + x * step;
+        uint64_t alpha = destination[3];
 
-            if (xp > wm)
-            {
-                xp = wm;
-            }
+        for (int c = 0; c < 3; c++)
+        {
+            destination[c] = MIN((sum[c] * mul_sum) >> shr_sum, alpha);
+        }
 
-            src_ptr = src + 4 * (xp + y * w) + (min_x * 4);
-            dst_ptr = src + y * w4 + (min_x * 4);
-            for (x = min_x; x < max_x; x++)
-            {
-                unsigned int alpha = dst_ptr[3];
-                dst_ptr[0] = clamp((sum_r * mul_sum) >> shr_sum, 0, alpha);
-                dst_ptr[1] = clamp((sum_g * mul_sum) >> shr_sum, 0, alpha);
-                dst_ptr[2] = clamp((sum_b * mul_sum) >> shr_sum, 0, alpha);
-                dst_ptr += 4;
-
-                sum_r -= sum_out_r;
-                sum_g -= sum_out_g;
-                sum_b -= sum_out_b;
-
-                stack_start = sp + div - radius;
-                if (stack_start >= div)
-                    stack_start -= div;
-                stack_ptr = &stack[3 * stack_start];
-
-                sum_out_r -= stack_ptr[0];
-                sum_out_g -= stack_ptr[1];
-                sum_out_b -= stack_ptr[2];
-
-                if (xp < wm)
-                {
-                    src_ptr += 4;
-                    ++xp;
-                }
-
-                stack_ptr[0] = src_ptr[0];
-                stack_ptr[1] = src_ptr[1];
-                stack_ptr[2] = src_ptr[2];
-
-                sum_in_r += src_ptr[0];
-                sum_in_g += src_ptr[1];
-                sum_in_b += src_ptr[2];
-                sum_r += sum_in_r;
-                sum_g += sum_in_g;
-                sum_b += sum_in_b;
-
-                ++sp;
-                if (sp >= div)
-                    sp = 0;
-                stack_ptr = &stack[sp * 3];
-
-                sum_out_r += stack_ptr[0];
-                sum_out_g += stack_ptr[1];
-                sum_out_b += stack_ptr[2];
-                sum_in_r -= stack_ptr[0];
-                sum_in_g -= stack_ptr[1];
-                sum_in_b -= stack_ptr[2];
-            }
+        unsigned stack_start = sp + div - radius;
+
+        if (stack_start >= div)
+        {
+            stack_start -= div;
+        }
+
+        if (xp < last)
+        {
+            xp++;
+        }
+
+        uint32_t outgoing = stack[stack_start];
+        uint32_t incoming = stackblur_pixel_at(line, step, xp);
+        stack[stack_start] = incoming;
+
+        sp++;
+
+        if (sp >= div)
+        {
+            sp = 0;
         }
+
+        uint32_t middle = stack[sp];
+
+        for (int c = 0; c < 3; c++)
+        {
+            sum[c] -= sum_out[c];
+            sum_out[c] -= stackblur_channel(outgoing, c);
+            sum_in[c] += stackblur_channel(incoming, c);
+            sum[c] += sum_in[c];
+            sum_out[c] += stackblur_channel(middle, c);
+            sum_in[c] -= stackblur_channel(middle, c);
+        }
+    }
+}
+
+#ifdef STACKBLUR_X86
+
+/* --- SSE2 ----------------------------------------------------------------- */
+
+// Four lines are blurred at once, one pixel of each in a register. Widened,
+// every pixel gets a register of its own with a 32 bits sum per channel.
+
+#    define TARGET_SSE2 __attribute__((target("sse2")))
+
+static constexpr unsigned STACKBLUR_LANES = 4;
+
+TARGET_SSE2 static inline __m128i stackblur_load_sse2(const unsigned char *first, size_t lane_stride)
+{
+    if (lane_stride == sizeof(uint32_t))
+    {
+        return _mm_loadu_si128((const __m128i *)first);
     }
 
+    uint32_t pixels[STACKBLUR_LANES];
+
+    for (unsigned lane = 0; lane < STACKBLUR_LANES; lane++)
+    {
+        memcpy(&pixels[lane], first + lane * lane_stride, sizeof(uint32_t));
+    }
+
+    // Put together in registers, going through memory would stall on the
+    // wide load reading back narrow stores.
+    __m128i lo = _mm_unpacklo_epi32(_mm_cvtsi32_si128(pixels[0]), _mm_cvtsi32_si128(pixels[1]));
+    __m128i hi = _mm_unpacklo_epi32(_mm_cvtsi32_si128(pixels[2]), _mm_cvtsi32_si128(pixels[3]));
+
+    return _mm_unpacklo_epi64(lo, hi);
+}
+
+TARGET_SSE2 static inline void stackblur_store_sse2(unsigned char *first, size_t lane_stride, __m128i value)
+{
+    if (lane_stride == sizeof(uint32_t))
     {
-        for (x = min_x; x < max_x; x++)
+        _mm_storeu_si128((__m128i *)first, value);
+        return;
+    }
+
+    for (unsigned lane = 0; lane < STACKBLUR_LANES; lane++)
+    {
+        uint32_t pixel = _mm_cvtsi128_si32(value);
+        memcpy(first + lane * lane_stride, &pixel, sizeof(uint32_t));
+
+        value = _mm_srli_si128(value, 4);
+    }
+}
+
+TARGET_SSE2 static inline void stackblur_widen_sse2(__m128i pixels, __m128i *channels)
+{
+    __m128i zero = _mm_setzero_si128();
+
+    __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+    __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+
+    channels[0] = _mm_unpacklo_epi16(lo, zero);
+    channels[1] = _mm_unpackhi_epi16(lo, zero);
+    channels[2] = _mm_unpacklo_epi16(hi, zero);
+    channels[3] = _mm_unpackhi_epi16(hi, zero);
+}
+
+// (sum * mul) >> shr with a 64 bits product, like the scalar code does.
+TARGET_SSE2 static inline __m128i stackblur_divide_sse2(__m128i sum, __m128i mul, __m128i shr)
+{
+    __m128i even = _mm_srl_epi64(_mm_mul_epu32(sum, mul), shr);
+    __m128i odd = _mm_srl_epi64(_mm_mul_epu32(_mm_srli_epi64(sum, 32), mul), shr);
+
+    return _mm_or_si128(_mm_and_si128(even, _mm_set_epi32(0, -1, 0, -1)), _mm_slli_epi64(odd, 32));
+}
+
+// Same as stackblur_line() on `GROUPS` groups of four lines, `lane_stride`
+// bytes apart. Columns go sixteen at a time so every step uses a whole
+// cache line.
+template <unsigned GROUPS>
+TARGET_SSE2 static void stackblur_lines_sse2(unsigned char *first, size_t step, size_t lane_stride, unsigned length, unsigned radius)
+{
+    static constexpr unsigned COUNT = GROUPS * STACKBLUR_LANES;
+
+    __m128i stack[STACKBLUR_STACK_SIZE][GROUPS];
+
+    unsigned last = length - 1;
+    unsigned div = radius * 2 + 1;
+    size_t group_stride = lane_stride * STACKBLUR_LANES;
+
+    __m128i mul = _mm_set1_epi32(stackblur_mul[radius]);
+    __m128i shr = _mm_cvtsi32_si128(stackblur_shr[radius]);
+    __m128i color_mask = _mm_set1_epi32(0x00ffffff);
+
+    __m128i sum[COUNT];
+    __m128i sum_in[COUNT];
+    __m128i sum_out[COUNT];
+
+    for (unsigned lane = 0; lane < COUNT; lane++)
+    {
+        sum[lane] = sum_in[lane] = sum_out[lane] = _mm_setzero_si128();
+    }
+
+    __m128i channels[COUNT];
+
+    for (unsigned group = 0; group < GROUPS; group++)
+    {
+        stackblur_widen_sse2(stackblur_load_sse2(first + group * group_stride, lane_stride), channels + group * STACKBLUR_LANES);
+    }
+
+    for (unsigned i = 0; i <= radius; i++)
+    {
+        for (unsigned group = 0; group < GROUPS; group++)
         {
-            sum_r = sum_g = sum_b =
-                sum_in_r = sum_in_g = sum_in_b =
-                    sum_out_r = sum_out_g = sum_out_b = 0;
+            stack[i][group] = stackblur_load_sse2(first + group * group_stride, lane_stride);
+        }
 
-            src_ptr = src + 4 * x + min_y * w4; // x,0
-            for (i = 0; i <= radius; i++)
-            {
-                stack_ptr = &stack[i * 3];
-                stack_ptr[0] = src_ptr[0];
-                stack_ptr[1] = src_ptr[1];
-                stack_ptr[2] = src_ptr[2];
-                sum_r += src_ptr[0] * (i + 1);
-                sum_g += src_ptr[1] * (i + 1);
-                sum_b += src_ptr[2] * (i + 1);
-                sum_out_r += src_ptr[0];
-                sum_out_g += src_ptr[1];
-                sum_out_b += src_ptr[2];
-            }
-            for (i = 1; i <= radius; i++)
-            {
-                if (i <= hm)
-                    src_ptr += w4; // +stride
-
-                stack_ptr = &stack[3 * (i + radius)];
-                stack_ptr[0] = src_ptr[0];
-                stack_ptr[1] = src_ptr[1];
-                stack_ptr[2] = src_ptr[2];
-                sum_r += src_ptr[0] * (radius + 1 - i);
-                sum_g += src_ptr[1] * (radius + 1 - i);
-                sum_b += src_ptr[2] * (radius + 1 - i);
-                sum_in_r += src_ptr[0];
-                sum_in_g += src_ptr[1];
-                sum_in_b += src_ptr[2];
-            }
+        // Both sides are below 256, so a 16 bits multiply is enough.
+        __m128i weight = _mm_set1_epi32(i + 1);
 
-            sp = radius;
-            yp = radius;
+        for (unsigned lane = 0; lane < COUNT; lane++)
+        {
+            sum[lane] = _mm_add_epi32(sum[lane], _mm_mullo_epi16(channels[lane], weight));
+            sum_out[lane] = _mm_add_epi32(sum_out[lane], channels[lane]);
+        }
+    }
 
-            if (yp > hm)
-            {
-                yp = hm;
-            }
+    for (unsigned i = 1; i <= radius; i++)
+    {
+        for (unsigned group = 0; group < GROUPS; group++)
+        {
+            __m128i pixels = stackblur_load_sse2(first + MIN(i, last) * step + group * group_stride, lane_stride);
+            stack[i + radius][group] = pixels;
+            stackblur_widen_sse2(pixels, channels + group * STACKBLUR_LANES);
+        }
+
+        __m128i weight = _mm_set1_epi32(radius + 1 - i);
+
+        for (unsigned lane = 0; lane < COUNT; lane++)
+        {
+            sum[lane] = _mm_add_epi32(sum[lane], _mm_mullo_epi16(channels[lane], weight));
+            sum_in[lane] = _mm_add_epi32(sum_in[lane], channels[lane]);
+        }
+    }
+
+    unsigned sp = radius;
+    unsigned xp = MIN(radius, last);
+
+    for (unsigned x = 0; x < length; x++)
+    {
+        for (unsigned group = 0; group < GROUPS; group++)
+        {
+            unsigned char *destination = first + x * step + group * group_stride;
+            __m128i original = stackblur_load_sse2(destination, lane_stride);
+            __m128i *group_sum = sum + group * STACKBLUR_LANES;
+
+            __m128i lo = _mm_packs_epi32(stackblur_divide_sse2(group_sum[0], mul, shr), stackblur_divide_sse2(group_sum[1], mul, shr));
+            __m128i hi = _mm_packs_epi32(stackblur_divide_sse2(group_sum[2], mul, shr), stackblur_divide_sse2(group_sum[3], mul, shr));
+            __m128i blurred = _mm_packus_epi16(lo, hi);
+
+            // Colors stay under the alpha of their pixel, which is left as is.
+            __m128i alpha = _mm_srli_epi32(original, 24);
+            alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 8));
+            alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+
+            blurred = _mm_min_epu8(blurred, alpha);
+            blurred = _mm_or_si128(_mm_and_si128(blurred, color_mask), _mm_andnot_si128(color_mask, original));
+
+            stackblur_store_sse2(destination, lane_stride, blurred);
+        }
+
+        unsigned stack_start = sp + div - radius;
+
+        if (stack_start >= div)
+        {
+            stack_start -= div;
+        }
+
+        if (xp < last)
+        {
+            xp++;
+        }
 
-            src_ptr = src + 4 * (x + yp * w) + min_y * w4;
-            dst_ptr = src + 4 * x + min_y * w4;
+        sp++;
 
-            for (y = min_y; y < max_y; y++)
+        if (sp >= div)
+        {
+            sp = 0;
+        }
+
+        for (unsigned group = 0; group < GROUPS; group++)
+        {
+            __m128i outgoing[STACKBLUR_LANES];
+            stackblur_widen_sse2(stack[stack_start][group], outgoing);
+
+            __m128i pixels = stackblur_load_sse2(first + xp * step + group * group_stride, lane_stride);
+            stack[stack_start][group] = pixels;
+
+            __m128i incoming[STACKBLUR_LANES];
+            stackblur_widen_sse2(pixels, incoming);
+
+            __m128i middle[STACKBLUR_LANES];
+            stackblur_widen_sse2(stack[sp][group], middle);
+
+            for (unsigned i = 0; i < STACKBLUR_LANES; i++)
             {
-                unsigned int alpha = dst_ptr[3];
-                dst_ptr[0] = clamp((sum_r * mul_sum) >> shr_sum, 0, alpha);
-                dst_ptr[1] = clamp((sum_g * mul_sum) >> shr_sum, 0, alpha);
-                dst_ptr[2] = clamp((sum_b * mul_sum) >> shr_sum, 0, alpha);
-                dst_ptr += w4;
-
-                sum_r -= sum_out_r;
-                sum_g -= sum_out_g;
-                sum_b -= sum_out_b;
-
-                stack_start = sp + div - radius;
-                if (stack_start >= div)
-                    stack_start -= div;
-                stack_ptr = &stack[3 * stack_start];
-
-                sum_out_r -= stack_ptr[0];
-                sum_out_g -= stack_ptr[1];
-                sum_out_b -= stack_ptr[2];
-
-                if (yp < hm)
-                {
-                    src_ptr += w4; // stride
-                    ++yp;
-                }
-
-                stack_ptr[0] = src_ptr[0];
-                stack_ptr[1] = src_ptr[1];
-                stack_ptr[2] = src_ptr[2];
-
-                sum_in_r += src_ptr[0];
-                sum_in_g += src_ptr[1];
-                sum_in_b += src_ptr[2];
-                sum_r += sum_in_r;
-                sum_g += sum_in_g;
-                sum_b += sum_in_b;
-
-                ++sp;
-                if (sp >= div)
-                    sp = 0;
-                stack_ptr = &stack[sp * 3];
-
-                sum_out_r += stack_ptr[0];
-                sum_out_g += stack_ptr[1];
-                sum_out_b += stack_ptr[2];
-                sum_in_r -= stack_ptr[0];
-                sum_in_g -= stack_ptr[1];
-                sum_in_b -= stack_ptr[2];
+                unsigned lane = group * STACKBLUR_LANES + i;
+
+                sum[lane] = _mm_sub_epi32(sum[lane], sum_out[lane]);
+                sum_out[lane] = _mm_sub_epi32(sum_out[lane], outgoing[i]);
+                sum_in[lane] = _mm_add_epi32(sum_in[lane], incoming[i]);
+                sum[lane] = _mm_add_epi32(sum[lane], sum_in[lane]);
+                sum_out[lane] = _mm_add_epi32(sum_out[lane], middle[i]);
+                sum_in[lane] = _mm_sub_epi32(sum_in[lane], middle[i]);
             }
         }
     }
 }
 
+#endif
+
+/* --- Passes --------------------------------------------------------------- */
+
+void stackblur(
+    unsigned char *src,
+    unsigned int w,
+    unsigned int h,
+    unsigned int radius,
+    unsigned int min_x,
+    unsigned int max_x,
+    unsigned int min_y,
+    unsigned int max_y,
+    SpanIsa isa)
+{
+    UNUSED(h);
+
+    if (min_x >= max_x || min_y >= max_y)
+    {
+        return;
+    }
+
+    radius = MIN(radius, STACKBLUR_MAX_RADIUS);
+
+    size_t stride = w * 4;
+    unsigned width = max_x - min_x;
+    unsigned height = max_y - min_y;
+    unsigned char *origin = src + min_y * stride + min_x * 4;
+
+    uint32_t stack[STACKBLUR_STACK_SIZE];
+
+#ifdef STACKBLUR_X86
+    bool vectorized = isa != SpanIsa::SCALAR && span_kernels(SpanIsa::SSE2) != nullptr;
+#else
+    UNUSED(isa);
+#endif
+
+    // Lines that don't make a group of four go through the scalar code.
+    unsigned row = 0;
+
+#ifdef STACKBLUR_X86
+    for (; vectorized && row + STACKBLUR_LANES <= height; row += STACKBLUR_LANES)
+    {
+        stackblur_lines_sse2<1>(origin + row * stride, 4, stride, width, radius);
+    }
+#endif
+
+    for (; row < height; row++)
+    {
+        stackblur_line(origin + row * stride, 4, width, radius, stack);
+    }
+
+    // Neighbouring columns are next to each other in memory, the pixels of
+    // four of them are a single load.
+    unsigned column = 0;
+
+#ifdef STACKBLUR_X86
+    for (; vectorized && column + STACKBLUR_LANES * 4 <= width; column += STACKBLUR_LANES * 4)
+    {
+        stackblur_lines_sse2<4>(origin + column * 4, stride, 4, height, radius);
+    }
+
+    for (; vectorized && column + STACKBLUR_LANES <= width; column += STACKBLUR_LANES)
+    {
+        stackblur_lines_sse2<1>(origin + column * 4, stride, 4, height, radius);
+    }
+#endif
+
+    for (; column < width; column++)
+    {
+        stackblur_line(origin + column * 4, stride, height, radius, stack);
+    }
+}
+
 } // namespace Graphic
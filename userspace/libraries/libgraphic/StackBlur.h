@@ -1,16 +1,25 @@
 #pragma once
 
+#include <libgraphic/Spans.h>
+
 namespace Graphic
 {
 
+static constexpr unsigned STACKBLUR_MAX_RADIUS = 254;
+
+// Blurs the pixels between min and max in place, rows first, then columns.
+// The work per pixel doesn't depend on the radius. The alpha isn't blurred
+// and colors are kept under it, so premultiplied pixels stay premultiplied.
+// Groups of four lines go through `isa`, at most, when the cpu has it.
 void stackblur(
     unsigned char *src,  ///< input image data
     unsigned int w,      ///< image width
     unsigned int h,      ///< image height
-    unsigned int radius, ///< blur intensity (should be in 2..254 range)
+    unsigned int radius, ///< blur intensity (clamped to STACKBLUR_MAX_RADIUS)
     unsigned int minX,
     unsigned int maxX,
     unsigned int minY,
-    unsigned int maxY);
+    unsigned int maxY,
+    SpanIsa isa = SpanIsa::AVX2);
 
-};
\ No newline at end of file
+} // namespace Graphic
@@ -20,7 +20,14 @@ ResultOr<RefPtr<Graphic::Bitmap>> Graphic::Png::load(IO::Reader &reader)
     if (bitmap_or_result.success())
     {
         auto bitmap = bitmap_or_result.unwrap();
-        memcpy(bitmap->pixels(), decoded_data, sizeof(Color) * decoded_width * decoded_height);
+        Color *pixels = bitmap->pixels();
+
+        // Png stores straight alpha.
+        for (size_t i = 0; i < decoded_width * decoded_height; i++)
+        {
+            pixels[i] = decoded_data[i].premultiplied();
+        }
+
         return bitmap;
     }
     else
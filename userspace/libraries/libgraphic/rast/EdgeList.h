@@ -66,6 +66,12 @@ public:
         return Math::Recti::from_two_point(_min, _max + Math::Vec2i{1});
     }
 
+    // Where the edges are, without rounding out to whole pixels.
+    Math::Rectf extent() const
+    {
+        return Math::Rectf::from_two_point(_min, _max);
+    }
+
     Vector<Math::Edgef> const &edges() const
     {
         return _edges;
@@ -2,6 +2,7 @@
 
 #include <libgraphic/Bitmap.h>
 #include <libgraphic/Color.h>
+#include <libgraphic/Spans.h>
 #include <libmath/Mat3x2.h>
 #include <libsystem/Logger.h>
 #include <libutils/Array.h>
@@ -23,11 +24,20 @@ struct Fill
     Color color = Colors::BLACK;
 };
 
+enum class GradientShape
+{
+    // Along the x axis.
+    LINEAR,
+    // Away from (0.5, 0.5), reaching 1 at 0.5 from it.
+    RADIAL,
+};
+
 struct Gradient
 {
     Optional<Math::Mat3x2f> transfom;
     Array<GradientStop, MAX_GRADIENT_STOPS> stops;
     size_t count;
+    GradientShape shape = GradientShape::LINEAR;
 };
 
 struct Texture
@@ -38,61 +48,173 @@ struct Texture
 
 using Paint = Utils::Variant<Fill, Gradient, Texture>;
 
-static inline ALWAYS_INLINE Color sample(Paint &paint, Math::Vec2f p)
+// A paint ready to be evaluated along a span of pixels, for one fill whose
+// edges lie within `bound`. Colors come out premultiplied.
+class Shader
 {
-    Color result = Colors::CYAN;
-
-    paint.visit(Utils::Visitor{
-        [&](Fill &fill) {
-            result = fill.color;
-        },
-        [&](Gradient &gradient) {
-            if (gradient.transfom.present())
+private:
+    // Gradients are looked up in a table instead of searching for their
+    // stops and dividing at every pixel.
+    static constexpr auto GRADIENT_LUT_SIZE = 256;
+
+    enum class Kind
+    {
+        CONSTANT,
+        LINEAR,
+        RADIAL,
+        TEXTURE,
+    };
+
+    Kind _kind = Kind::CONSTANT;
+    Color _color = Colors::TRANSPARENT;
+
+    // From the center of a pixel to where it is in the paint.
+    Math::Mat3x2f _transform = Math::Mat3x2f::identity();
+
+    Array<Color, GRADIENT_LUT_SIZE> _lut;
+    RefPtr<Bitmap> _bitmap;
+
+    void build_lut(const Gradient &gradient)
+    {
+        if (gradient.count == 0)
+        {
+            for (size_t i = 0; i < GRADIENT_LUT_SIZE; i++)
             {
-                p = gradient.transfom.unwrap().apply(p);
+                _lut[i] = Colors::BLACK;
             }
 
-            float v = p.x();
+            return;
+        }
+
+        size_t stop = 0;
 
-            if (gradient.count == 0)
+        for (size_t i = 0; i < GRADIENT_LUT_SIZE; i++)
+        {
+            float v = i / (float)(GRADIENT_LUT_SIZE - 1);
+
+            while (stop + 1 < gradient.count && gradient.stops[stop + 1].value <= v)
             {
-                result = Colors::BLACK;
+                stop++;
             }
-            else if (gradient.count == 1 || v <= gradient.stops[0].value)
+
+            auto &s0 = gradient.stops[stop];
+
+            if (stop + 1 == gradient.count || v <= s0.value)
             {
-                result = gradient.stops[0].color;
+                _lut[i] = s0.color.premultiplied();
             }
-            else if (v >= gradient.stops[gradient.count - 1].value)
+            else
             {
-                result = gradient.stops[gradient.count - 1].color;
+                auto &s1 = gradient.stops[stop + 1];
+                _lut[i] = Color::lerp(s0.color, s1.color, (v - s0.value) / (s1.value - s0.value)).premultiplied();
             }
-            else
+        }
+    }
+
+    ALWAYS_INLINE Color lookup(float v) const
+    {
+        return _lut[clamp((int)(v * (GRADIENT_LUT_SIZE - 1) + 0.5f), 0, GRADIENT_LUT_SIZE - 1)];
+    }
+
+public:
+    bool constant() const { return _kind == Kind::CONSTANT; }
+
+    Color color() const { return _color; }
+
+    Shader(Paint &paint, Math::Rectf bound)
+    {
+        // Gradients and textures are spread over the bound of the edges.
+        float width = MAX(bound.width(), 1.0f);
+        float height = MAX(bound.height(), 1.0f);
+
+        auto normalize = Math::Mat3x2f{
+            1.0f / width,
+            0.0f,
+            0.0f,
+            1.0f / height,
+            (0.5f - bound.left()) / width,
+            (0.5f - bound.top()) / height,
+        };
+
+        auto to_paint = [&](const Optional<Math::Mat3x2f> &transform) {
+            if (!transform.present())
             {
-                for (size_t i = 0; i + 1 < gradient.count; i++)
-                {
-                    GradientStop s0 = gradient.stops[i];
-                    GradientStop s1 = gradient.stops[i + 1];
-
-                    if (s0.value <= v && v < s1.value)
-                    {
-                        float localv = ((v - s0.value) / (s1.value - s0.value));
-                        result = Color::lerp(s0.color, s1.color, localv);
-                        break;
-                    }
-                }
+                return normalize;
             }
-        },
-        [&](Texture &texture) {
-            if (texture.transfom.present())
+
+            auto &m = transform.unwrap();
+
+            return Math::Mat3x2f{
+                normalize[0] * m[0],
+                normalize[0] * m[1],
+                normalize[3] * m[2],
+                normalize[3] * m[3],
+                normalize[4] * m[0] + normalize[5] * m[2] + m[4],
+                normalize[4] * m[1] + normalize[5] * m[3] + m[5],
+            };
+        };
+
+        paint.visit(Utils::Visitor{
+            [&](Fill &fill) {
+                _color = fill.color.premultiplied();
+            },
+            [&](Gradient &gradient) {
+                _kind = gradient.shape == GradientShape::RADIAL ? Kind::RADIAL : Kind::LINEAR;
+                _transform = to_paint(gradient.transfom);
+                build_lut(gradient);
+            },
+            [&](Texture &texture) {
+                _kind = Kind::TEXTURE;
+                _transform = to_paint(texture.transfom);
+                _bitmap = texture.bitmap;
+            },
+        });
+    }
+
+    // Evaluates `count` pixels of row `y` starting at `x`. Where the paint
+    // is along the row moves by a constant step, so nothing is divided.
+    void shade(Color *destination, int x, int y, size_t count) const
+    {
+        auto p = _transform.apply(Math::Vec2f{(float)x, (float)y});
+        auto step = Math::Vec2f{_transform[0], _transform[1]};
+
+        switch (_kind)
+        {
+        case Kind::CONSTANT:
+            fill_span(destination, _color, count);
+            break;
+
+        case Kind::LINEAR:
+            for (size_t i = 0; i < count; i++)
             {
-                p = texture.transfom.unwrap().apply(p);
+                destination[i] = lookup(p.x());
+                p += step;
             }
+            break;
 
-            result = texture.bitmap->sample(p);
-        },
-    });
+        case Kind::RADIAL:
+        {
+            // The center of the bound is 0 and its edges are 1.
+            auto d = (p - Math::Vec2f{0.5f, 0.5f}) * 2;
+            step = step * 2;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                destination[i] = lookup(sqrtf(d.x() * d.x() + d.y() * d.y()));
+                d += step;
+            }
+            break;
+        }
 
-    return result;
-}
+        case Kind::TEXTURE:
+            for (size_t i = 0; i < count; i++)
+            {
+                destination[i] = Bitmap::convert(_bitmap->sample(p), _bitmap->format(), BITMAP_PREMULTIPLIED);
+                p += step;
+            }
+            break;
+        }
+    }
+};
 
 } // namespace Graphic
@@ -9,7 +9,11 @@ namespace Graphic
 Rasterizer::Rasterizer(Bitmap &bitmap, TransformStack &stack)
     : _bitmap{bitmap}, _stack{stack}
 {
-    _scanline.resize(_bitmap.width());
+    // Spans can end right after the last pixel, which puts deltas one
+    // and two pixels further.
+    _coverage.resize(_bitmap.width() + 2);
+    _mask.resize(_bitmap.width());
+    _shades.resize(_bitmap.width());
 }
 
 void Rasterizer::clear()
@@ -23,12 +27,7 @@ void Rasterizer::flatten(const Path &path, const Math::Mat3x2f &transform)
     {
         for (size_t i = 0; i < subpath.length(); i++)
         {
-            auto curve = subpath.curves(i);
-
-            curve = Math::Mat3x2f::translation(_stack.origin()).apply(curve);
-            curve = transform.apply(curve);
-
-            _edges.append(curve);
+            _edges.append(transform.apply(subpath.curves(i)));
         }
 
         if (!subpath.closed())
@@ -45,99 +44,260 @@ void Rasterizer::flatten(const EdgeList &edges, const Math::Mat3x2f &transform)
 {
     for (auto &edge : edges.edges())
     {
+        // Each edge on its own, the list doesn't have to be one polyline.
+        _edges.begin();
         _edges.append(transform.apply(edge.start()));
         _edges.append(transform.apply(edge.end()));
     }
 }
 
-void Rasterizer::rasterize(Paint &paint)
+void Rasterizer::build_edges(Math::Recti bound)
 {
-    auto line = [&](float start, float end) {
-        for (float x = start; x < end; x += 1.0f / 4)
+    int first = bound.top() * SUBSCANLINES;
+    int last = bound.bottom() * SUBSCANLINES;
+
+    _active_edges.clear();
+    _buckets.resize(last - first);
+
+    for (int i = 0; i < last - first; i++)
+    {
+        _buckets[i] = -1;
+    }
+
+    for (auto &edge : _edges.edges())
+    {
+        auto start = edge.start();
+        auto end = edge.end();
+        int winding = 1;
+
+        if (start.y() > end.y())
         {
-            if ((int)x < (int)_scanline.count())
-            {
-                _scanline[(int)x] += 1;
-            }
+            swap(start, end);
+            winding = -1;
         }
-    };
 
-    auto scanline = [&](int start, int end, float y) {
-        _actives_edges.clear();
+        // Subscanline `s` goes through (s + 0.5) / SUBSCANLINES.
+        int top = clamp(ceilf(start.y() * SUBSCANLINES - 0.5f), first, last);
+        int bottom = clamp(ceilf(end.y() * SUBSCANLINES - 0.5f), first, last);
 
-        for (auto &edge : _edges.edges())
+        if (top >= bottom)
         {
-            if (y >= edge.min_y() && y < edge.max_y())
-            {
-                _actives_edges.push_back(edge);
-            }
+            continue;
         }
 
-        _actives_edges.sort([&](Math::Edgef &a, Math::Edgef &b) { return a.intersection_y(y).x() - b.intersection_y(y).x(); });
+        float slope = (end.x() - start.x()) / (end.y() - start.y());
+        float y = (top + 0.5f) / SUBSCANLINES;
 
-        bool odd_even = true;
+        _active_edges.push_back({
+            start.x() + (y - start.y()) * slope,
+            slope / SUBSCANLINES,
+            top,
+            bottom,
+            winding,
+            _buckets[top - first],
+        });
 
-        for (size_t i = 0; i + 1 < _actives_edges.count(); i++)
-        {
-            auto &a = _actives_edges[i];
-            auto &b = _actives_edges[i + 1];
+        _buckets[top - first] = _active_edges.count() - 1;
+    }
+}
 
-            float seg_start = MAX(a.intersection_y(y).x(), start);
-            float seg_end = MIN(b.intersection_y(y).x(), end);
+// Adds the coverage of [start, end) on the current subscanline. The pixels
+// at both ends get a part of it and the ones in between all of it, which
+// are deltas on the two pixels around each end.
+void Rasterizer::accumulate(float start, float end)
+{
+    if (start >= end)
+    {
+        return;
+    }
 
-            if (odd_even)
-            {
-                line(seg_start, seg_end);
-            }
+    constexpr float WEIGHT = 1.0f / SUBSCANLINES;
+
+    int start_pixel = (int)start;
+    float start_fraction = start - start_pixel;
+
+    _coverage[start_pixel] += WEIGHT * (1 - start_fraction);
+    _coverage[start_pixel + 1] += WEIGHT * start_fraction;
+
+    int end_pixel = (int)end;
+    float end_fraction = end - end_pixel;
+
+    _coverage[end_pixel] -= WEIGHT * (1 - end_fraction);
+    _coverage[end_pixel + 1] -= WEIGHT * end_fraction;
+}
+
+void Rasterizer::fill_row(const Shader &shader, int y, int start, int end)
+{
+    float coverage = 0;
+
+    // Only the part of the row that is covered gets shaded.
+    int first = end;
+    int last = start;
+
+    for (int x = start; x < end; x++)
+    {
+        coverage += _coverage[x];
+        _coverage[x] = 0;
 
-            odd_even = !odd_even;
+        _mask[x] = clamp(coverage, 0, 1) * 255 + 0.5f;
+
+        if (_mask[x] != 0)
+        {
+            first = MIN(first, x);
+            last = x + 1;
         }
-    };
+    }
 
-    auto bound = _stack.clip();
+    _coverage[end] = 0;
+    _coverage[end + 1] = 0;
 
-    for (int y = bound.top(); y < bound.bottom(); y++)
+    if (first >= last)
     {
-        for (int i = bound.left(); i < bound.right(); i++)
+        return;
+    }
+
+    auto *row = _bitmap.pixels() + y * _bitmap.width();
+
+    if (shader.constant() && _bitmap.format() == BITMAP_PREMULTIPLIED)
+    {
+        blend_span_mask_premultiplied(row + first, shader.color(), _mask.raw_storage() + first, last - first);
+        return;
+    }
+
+    shader.shade(_shades.raw_storage() + first, first, y, last - first);
+
+    for (int x = first; x < last; x++)
+    {
+        auto shade = _shades[x];
+        auto mask = _mask[x];
+
+        if (mask != 255)
         {
-            _scanline[i] = 0;
+            _shades[x] = Color::from_rgba_byte(
+                Color::div255(shade.red() * mask),
+                Color::div255(shade.green() * mask),
+                Color::div255(shade.blue() * mask),
+                Color::div255(shade.alpha() * mask));
         }
+    }
 
-        for (float yy = (y - 0.5f); yy < (y + 0.5f); yy += 1.0f / 4)
+    if (_bitmap.format() == BITMAP_PREMULTIPLIED)
+    {
+        blend_span_premultiplied(row + first, _shades.raw_storage() + first, last - first);
+    }
+    else
+    {
+        for (int x = first; x < last; x++)
         {
-            scanline(bound.left(), bound.right(), yy + 0.5f);
+            _bitmap.blend_pixel_no_check({x, y}, _shades[x], BITMAP_PREMULTIPLIED);
         }
+    }
+}
 
-        for (int i = bound.left(); i < bound.right(); i++)
+// Edges are put in buckets by the subscanline they start on, then the
+// scanlines go from the top of the path to its bottom with the edges they
+// cross. Each one moves its crossing by a constant step from one
+// subscanline to the next, and stays about where it was in the list.
+void Rasterizer::rasterize(Paint &paint, FillRule rule)
+{
+    auto bound = _edges.bound().clipped_with(_stack.clip());
+
+    if (bound.is_empty())
+    {
+        return;
+    }
+
+    Shader shader{paint, _edges.extent()};
+
+    build_edges(bound);
+    _actives.clear();
+
+    auto inside = [rule](int winding) {
+        return rule == FillRule::EVENODD ? (winding & 1) != 0 : winding != 0;
+    };
+
+    int first = bound.top() * SUBSCANLINES;
+
+    for (int y = bound.top(); y < bound.bottom(); y++)
+    {
+        for (int s = y * SUBSCANLINES; s < (y + 1) * SUBSCANLINES; s++)
         {
-            Math::Vec2f p = {
-                (i - _edges.bound().left()) / (float)_edges.bound().width(),
-                (y - _edges.bound().top()) / (float)_edges.bound().height(),
-            };
+            size_t kept = 0;
+
+            for (size_t i = 0; i < _actives.count(); i++)
+            {
+                if (_active_edges[_actives[i]].bottom > s)
+                {
+                    _actives[kept++] = _actives[i];
+                }
+            }
+
+            _actives.resize(kept);
+
+            for (int edge = _buckets[s - first]; edge != -1; edge = _active_edges[edge].next)
+            {
+                _actives.push_back(edge);
+            }
+
+            for (size_t i = 1; i < _actives.count(); i++)
+            {
+                int edge = _actives[i];
+                float x = _active_edges[edge].x;
 
-            auto color = sample(paint, p);
-            auto alpha = clamp((_scanline[i] / 16.0f), 0, 1);
+                size_t j = i;
 
-            if (alpha >= 0.003f)
+                while (j > 0 && _active_edges[_actives[j - 1]].x > x)
+                {
+                    _actives[j] = _actives[j - 1];
+                    j--;
+                }
+
+                _actives[j] = edge;
+            }
+
+            // Going from left to right, each edge crossed adds its winding.
+            int winding = 0;
+            float start = 0;
+
+            for (size_t i = 0; i < _actives.count(); i++)
+            {
+                auto &edge = _active_edges[_actives[i]];
+
+                bool was_inside = inside(winding);
+                winding += edge.winding;
+
+                if (!was_inside && inside(winding))
+                {
+                    start = edge.x;
+                }
+                else if (was_inside && !inside(winding))
+                {
+                    accumulate(clamp(start, bound.left(), bound.right()), clamp(edge.x, bound.left(), bound.right()));
+                }
+            }
+
+            for (size_t i = 0; i < _actives.count(); i++)
             {
-                _bitmap.blend_pixel_no_check({i, y}, color.with_alpha(color.alphaf() * alpha));
+                _active_edges[_actives[i]].x += _active_edges[_actives[i]].step;
             }
         }
+
+        fill_row(shader, y, bound.left(), bound.right());
     }
 }
 
-void FLATTEN Rasterizer::fill(const Path &path, const Math::Mat3x2f &transform, Paint paint)
+void FLATTEN Rasterizer::fill(const Path &path, const Math::Mat3x2f &transform, Paint paint, FillRule rule)
 {
     clear();
     flatten(path, transform * Math::Mat3x2f::translation(_stack.origin()));
-    rasterize(paint);
+    rasterize(paint, rule);
 }
 
-void FLATTEN Rasterizer::fill(const EdgeList &edges, const Math::Mat3x2f &transform, Paint paint)
+void FLATTEN Rasterizer::fill(const EdgeList &edges, const Math::Mat3x2f &transform, Paint paint, FillRule rule)
 {
     clear();
     flatten(edges, transform * Math::Mat3x2f::translation(_stack.origin()));
-    rasterize(paint);
+    rasterize(paint, rule);
 }
 
 } // namespace Graphic
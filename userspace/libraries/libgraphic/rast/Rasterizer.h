@@ -9,6 +9,16 @@
 namespace Graphic
 {
 
+// Which parts of a path are inside of it, from how many times its edges go
+// around them.
+enum class FillRule
+{
+    // Anything its edges go around, whichever way.
+    NONZERO,
+    // Anything its edges go around an odd number of times.
+    EVENODD,
+};
+
 struct RasterizeState
 {
     Math::Vec2i origin;
@@ -24,29 +34,65 @@ private:
     static constexpr auto TOLERANCE = 0.25f;
     static constexpr auto MAX_DEPTH = 8;
 
+    // Rows are sampled this many times, along a row coverage is exact.
+    static constexpr auto SUBSCANLINES = 4;
+
+    // An edge as the scanlines go through it, from top to bottom.
+    struct ActiveEdge
+    {
+        // Where the edge crosses the current subscanline.
+        float x;
+        // How much x moves from one subscanline to the next.
+        float step;
+
+        int top;
+        int bottom;
+
+        // +1 going down, -1 going up.
+        int winding;
+
+        // The next edge starting on the same subscanline.
+        int next;
+    };
+
     Bitmap &_bitmap;
     TransformStack &_stack;
 
     EdgeList _edges;
-    Vector<Math::Edgef> _actives_edges;
-    Vector<uint16_t> _scanline;
+
+    Vector<ActiveEdge> _active_edges;
+    // The first edge of each subscanline of the bound, -1 if there is none.
+    Vector<int> _buckets;
+    Vector<int> _actives;
+
+    // Coverage deltas for the current row, their running sum is how much
+    // of each pixel is covered.
+    Vector<float> _coverage;
+    Vector<uint8_t> _mask;
+    Vector<Color> _shades;
 
     void clear();
 
+    void build_edges(Math::Recti bound);
+
+    void accumulate(float start, float end);
+
+    void fill_row(const Shader &shader, int y, int start, int end);
+
     void flatten(const Path &path, const Math::Mat3x2f &transform);
 
     void flatten(const EdgeList &edges, const Math::Mat3x2f &transform);
 
-    void rasterize(Paint &paint);
+    void rasterize(Paint &paint, FillRule rule);
 
 public:
     Bitmap &bitmap() const { return _bitmap; }
 
     Rasterizer(Bitmap &bitmap, TransformStack &stack);
 
-    void fill(const Path &path, const Math::Mat3x2f &transform, Paint paint);
+    void fill(const Path &path, const Math::Mat3x2f &transform, Paint paint, FillRule rule = FillRule::NONZERO);
 
-    void fill(const EdgeList &edges, const Math::Mat3x2f &transform, Paint paint);
+    void fill(const EdgeList &edges, const Math::Mat3x2f &transform, Paint paint, FillRule rule = FillRule::NONZERO);
 };
 
 } // namespace Graphic
@@ -9,25 +9,31 @@
 namespace Graphic::Svg
 {
 
-void render_node(Painter &rast, Xml::Node &node, Math::Mat3x2f transformation, Color fillcolor)
+void render_node(Painter &rast, Xml::Node &node, Math::Mat3x2f transformation, Color fillcolor, FillRule fillrule)
 {
     for (auto child : node.children())
     {
         Color current = fillcolor;
+        FillRule rule = fillrule;
 
         if (child.attributes().has_key("fill"))
         {
             current = Color::parse(child.attributes()["fill"]);
         }
 
+        if (child.attributes().has_key("fill-rule"))
+        {
+            rule = child.attributes()["fill-rule"] == "evenodd" ? FillRule::EVENODD : FillRule::NONZERO;
+        }
+
         if (child.name() == "path")
         {
             auto path = Graphic::Path::parse(child.attributes()["d"].cstring());
-            rast.fill(path, transformation, Graphic::Fill{current});
+            rast.fill(path, transformation, Graphic::Fill{current}, rule);
         }
         else if (child.name() == "g")
         {
-            render_node(rast, child, transformation, current);
+            render_node(rast, child, transformation, current, rule);
         }
         else
         {
@@ -80,7 +86,7 @@ ResultOr<RefPtr<Graphic::Bitmap>> render(IO::Reader &reader, int size_hint)
     bitmap->filtering(BitmapFiltering::NEAREST);
     Painter painter{*bitmap};
 
-    render_node(painter, doc.root(), Math::Mat3x2f::scale(scale), Colors::BLACK);
+    render_node(painter, doc.root(), Math::Mat3x2f::scale(scale), Colors::BLACK, FillRule::NONZERO);
 
     return bitmap;
 }
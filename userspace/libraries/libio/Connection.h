@@ -38,6 +38,24 @@ public:
         return _handle->write(buffer, size);
     }
 
+    ResultOr<size_t> readv(const IOVector *vectors, size_t count) override
+    {
+        if (!_handle)
+            return ERR_STREAM_CLOSED;
+
+        return _handle->readv(vectors, count);
+    }
+
+    // Write all the buffers with a single syscall, the kernel keeps them
+    // together as long as the other end has room for them.
+    ResultOr<size_t> writev(const IOVector *vectors, size_t count) override
+    {
+        if (!_handle)
+            return ERR_STREAM_CLOSED;
+
+        return _handle->writev(vectors, count);
+    }
+
     bool closed()
     {
         return _handle == nullptr;
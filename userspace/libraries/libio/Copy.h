@@ -4,6 +4,7 @@
 #include <libutils/Slice.h>
 #include <libutils/Vector.h>
 
+#include <libio/Handle.h>
 #include <libio/MemoryReader.h>
 #include <libio/MemoryWriter.h>
 
@@ -64,6 +65,83 @@ static inline Result copy(Reader &from, Writer &to)
     } while (1);
 }
 
+template <typename T>
+concept RawReader = IsBaseOf<Reader, T>::value &&IsBaseOf<RawHandle, T>::value;
+
+template <typename T>
+concept RawWriter = IsBaseOf<Writer, T>::value &&IsBaseOf<RawHandle, T>::value;
+
+constexpr size_t COPY_SPLICE_SIZE = 1024 * 1024;
+
+// When both ends are kernel handles the data is spliced by the kernel and
+// never goes through our memory. If the nodes don't support it we fallback
+// to copying through a buffer.
+static inline Result copy(RawReader auto &from, RawWriter auto &to, size_t n)
+{
+    if (!from.handle() || !to.handle())
+    {
+        return copy((Reader &)from, (Writer &)to, n);
+    }
+
+    size_t remaining = n;
+
+    while (remaining > 0)
+    {
+        auto spliced = from.handle()->splice(*to.handle(), MIN(COPY_SPLICE_SIZE, remaining));
+
+        if (!spliced.success())
+        {
+            if (remaining == n)
+            {
+                return copy((Reader &)from, (Writer &)to, n);
+            }
+
+            return spliced.result();
+        }
+
+        if (spliced.unwrap() == 0)
+        {
+            break;
+        }
+
+        remaining -= spliced.unwrap();
+    }
+
+    return to.flush();
+}
+
+static inline Result copy(RawReader auto &from, RawWriter auto &to)
+{
+    if (!from.handle() || !to.handle())
+    {
+        return copy((Reader &)from, (Writer &)to);
+    }
+
+    bool first = true;
+
+    while (true)
+    {
+        auto spliced = from.handle()->splice(*to.handle(), COPY_SPLICE_SIZE);
+
+        if (!spliced.success())
+        {
+            if (first)
+            {
+                return copy((Reader &)from, (Writer &)to);
+            }
+
+            return spliced.result();
+        }
+
+        if (spliced.unwrap() == 0)
+        {
+            return to.flush();
+        }
+
+        first = false;
+    }
+}
+
 static inline ResultOr<Slice> read_all(Reader &reader)
 {
     MemoryWriter memory;
@@ -5,14 +5,18 @@ namespace IO
 
 Result Directory::read_entries()
 {
-    DirectoryEntry entry;
+    DirectoryEntry entries[32];
 
-    auto read = TRY(_handle->read(&entry, sizeof(entry)));
+    auto listed = TRY(_handle->list(entries, ARRAY_LENGTH(entries)));
 
-    while (read > 0)
+    while (listed > 0)
     {
-        _entries.push_back({entry.name, entry.stat});
-        read = TRY(_handle->read(&entry, sizeof(entry)));
+        for (size_t i = 0; i < listed; i++)
+        {
+            _entries.push_back({entries[i].name, entries[i].stat});
+        }
+
+        listed = TRY(_handle->list(entries, ARRAY_LENGTH(entries)));
     }
 
     _entries.sort([](auto &left, auto &right) {
@@ -36,6 +36,26 @@ ResultOr<size_t> File::write(const void *buffer, size_t size)
     return _handle->write(buffer, size);
 }
 
+ResultOr<size_t> File::readv(const IOVector *vectors, size_t count)
+{
+    return _handle->readv(vectors, count);
+}
+
+ResultOr<size_t> File::writev(const IOVector *vectors, size_t count)
+{
+    return _handle->writev(vectors, count);
+}
+
+ResultOr<size_t> File::read_at(size_t offset, void *buffer, size_t size)
+{
+    return _handle->pread(buffer, size, offset);
+}
+
+ResultOr<size_t> File::write_at(size_t offset, const void *buffer, size_t size)
+{
+    return _handle->pwrite(buffer, size, offset);
+}
+
 ResultOr<size_t> File::call(IOCall call, void *args)
 {
     return _handle->call(call, args);
@@ -36,6 +36,15 @@ public:
 
     ResultOr<size_t> write(const void *buffer, size_t size) override;
 
+    ResultOr<size_t> readv(const IOVector *vectors, size_t count) override;
+
+    ResultOr<size_t> writev(const IOVector *vectors, size_t count) override;
+
+    // Positional variants, they don't use nor move the current position.
+    ResultOr<size_t> read_at(size_t offset, void *buffer, size_t size);
+
+    ResultOr<size_t> write_at(size_t offset, const void *buffer, size_t size);
+
     ResultOr<size_t> call(IOCall call, void *args);
 
     ResultOr<size_t> seek(SeekFrom from) override;
@@ -60,6 +60,48 @@ public:
         return data_read;
     }
 
+    ResultOr<size_t> readv(const IOVector *vectors, size_t count)
+    {
+        size_t data_read = 0;
+        _result = TRY(hj_handle_readv(_handle, vectors, count, &data_read));
+        return data_read;
+    }
+
+    ResultOr<size_t> writev(const IOVector *vectors, size_t count)
+    {
+        size_t data_written = 0;
+        _result = TRY(hj_handle_writev(_handle, vectors, count, &data_written));
+        return data_written;
+    }
+
+    ResultOr<size_t> pread(void *buffer, size_t size, ssize64_t offset)
+    {
+        size_t data_read = 0;
+        _result = TRY(hj_handle_pread(_handle, buffer, size, &offset, &data_read));
+        return data_read;
+    }
+
+    ResultOr<size_t> pwrite(const void *buffer, size_t size, ssize64_t offset)
+    {
+        size_t data_written = 0;
+        _result = TRY(hj_handle_pwrite(_handle, buffer, size, &offset, &data_written));
+        return data_written;
+    }
+
+    ResultOr<size_t> list(DirectoryEntry *entries, size_t count)
+    {
+        size_t listed = 0;
+        _result = TRY(hj_handle_list(_handle, entries, count, &listed));
+        return listed;
+    }
+
+    ResultOr<size_t> splice(Handle &destination, size_t size)
+    {
+        size_t data_spliced = 0;
+        _result = TRY(hj_handle_splice(_handle, destination.id(), size, &data_spliced));
+        return data_spliced;
+    }
+
     ResultOr<size_t> write(const void *buffer, size_t size)
     {
         size_t data_written = 0;
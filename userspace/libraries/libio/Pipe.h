@@ -11,17 +11,38 @@ struct Pipe
     RefPtr<Handle> reader;
     RefPtr<Handle> writer;
 
-    static ResultOr<Pipe> create()
+    // A capacity of zero keeps the kernel default.
+    static ResultOr<Pipe> create(size_t capacity = 0)
     {
         int reader_handle = HANDLE_INVALID_ID;
         int writer_handle = HANDLE_INVALID_ID;
 
         TRY(hj_create_pipe(&reader_handle, &writer_handle));
 
-        return Pipe{
+        Pipe pipe{
             make<Handle>(reader_handle),
             make<Handle>(writer_handle),
         };
+
+        if (capacity != 0)
+        {
+            TRY(pipe.resize(capacity));
+        }
+
+        return pipe;
+    }
+
+    Result resize(size_t capacity)
+    {
+        IOCallPipeCapacityArgs args{capacity};
+        return writer->call(IOCALL_PIPE_SET_CAPACITY, &args);
+    }
+
+    ResultOr<size_t> capacity()
+    {
+        IOCallPipeCapacityArgs args{};
+        TRY(writer->call(IOCALL_PIPE_GET_CAPACITY, &args));
+        return args.capacity;
     }
 };
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <abi/Handle.h>
 #include <libio/Seek.h>
 
 namespace IO
@@ -10,6 +11,26 @@ struct Reader
     virtual ~Reader() {}
 
     virtual ResultOr<size_t> read(void *buffer, size_t size) = 0;
+
+    // Fill the buffers one after the other, readers backed by a handle
+    // override this to do it with a single syscall.
+    virtual ResultOr<size_t> readv(const IOVector *vectors, size_t count)
+    {
+        size_t read = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t read_in_vector = TRY(this->read(vectors[i].buffer, vectors[i].size));
+            read += read_in_vector;
+
+            if (read_in_vector < vectors[i].size)
+            {
+                break;
+            }
+        }
+
+        return read;
+    }
 };
 
 template <typename T>
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <abi/Handle.h>
 #include <libio/Seek.h>
 
 namespace IO
@@ -11,6 +12,24 @@ struct Writer
 
     virtual ResultOr<size_t> write(const void *buffer, size_t size) = 0;
 
+    virtual ResultOr<size_t> writev(const IOVector *vectors, size_t count)
+    {
+        size_t written = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t written_in_vector = TRY(this->write(vectors[i].buffer, vectors[i].size));
+            written += written_in_vector;
+
+            if (written_in_vector < vectors[i].size)
+            {
+                break;
+            }
+        }
+
+        return written;
+    }
+
     virtual Result flush() { return SUCCESS; }
 };
 
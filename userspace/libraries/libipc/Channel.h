@@ -0,0 +1,381 @@
+#pragma once
+
+#include <libasync/Invoker.h>
+#include <libasync/Notifier.h>
+#include <libio/Connection.h>
+#include <libipc/Ring.h>
+#include <libutils/Callback.h>
+
+namespace IPC
+{
+
+// Sent by both ends when a channel is opened. The ring is the shared memory
+// object the sender will write its messages to, or HANDLE_INVALID_ID if it
+// only wants to talk through the connection.
+struct Handshake
+{
+    uint32_t magic;
+    int ring;
+};
+
+// A message stream over a connection. When both ends offer a ring during the
+// handshake, messages go through shared memory and the connection only
+// carries doorbells: a single byte sent when the other end had read
+// everything and might be waiting for more, or when it was waiting for room
+// in a full ring and we just read some. Either way the end woken up checks
+// both of its rings.
+class Channel :
+    public IO::Reader,
+    public IO::Writer,
+    public IO::RawHandle
+{
+private:
+    static constexpr uint32_t HANDSHAKE_MAGIC = 0x52435049;
+
+    struct Lifetime : public RefCounted<Lifetime>
+    {
+        bool alive = true;
+    };
+
+    IO::Connection _connection;
+    bool _negotiated = false;
+
+    OwnPtr<Ring> _send;
+    OwnPtr<Ring> _receive;
+
+    Callback<void()> _on_receive;
+    OwnPtr<Async::Notifier> _notifier;
+    OwnPtr<Async::Invoker> _invoker;
+    bool _dispatching = false;
+    RefPtr<Lifetime> _lifetime = make<Lifetime>();
+
+    NONCOPYABLE(Channel);
+    NONMOVABLE(Channel);
+
+    Result negotiate()
+    {
+        if (_negotiated)
+        {
+            return SUCCESS;
+        }
+
+        _negotiated = true;
+
+        Handshake handshake{};
+        auto read_result = _connection.read(&handshake, sizeof(Handshake));
+
+        if (!read_result.success() ||
+            read_result.unwrap() != sizeof(Handshake) ||
+            handshake.magic != HANDSHAKE_MAGIC)
+        {
+            _send = nullptr;
+            _connection.close();
+            return ERR_STREAM_CLOSED;
+        }
+
+        if (_send == nullptr || handshake.ring == HANDLE_INVALID_ID)
+        {
+            _send = nullptr;
+            return SUCCESS;
+        }
+
+        auto receive_or_result = Ring::include(handshake.ring);
+
+        if (!receive_or_result.success())
+        {
+            // The other end is already using its ring, we can't fallback.
+            _send = nullptr;
+            _connection.close();
+            return receive_or_result.result();
+        }
+
+        _receive = receive_or_result.unwrap();
+
+        return SUCCESS;
+    }
+
+    Result ring_doorbell()
+    {
+        if (_send->publish())
+        {
+            uint8_t doorbell = 0;
+            TRY(_connection.write(&doorbell, sizeof(doorbell)));
+        }
+
+        return SUCCESS;
+    }
+
+    Result ring_room_doorbell()
+    {
+        if (_receive->room_requested())
+        {
+            uint8_t doorbell = 0;
+            TRY(_connection.write(&doorbell, sizeof(doorbell)));
+        }
+
+        return SUCCESS;
+    }
+
+    // Only call this when the connection is readable or when there is
+    // nothing else to do, it blocks until the other end rings.
+    Result wait_for_doorbell()
+    {
+        uint8_t doorbells[64];
+        size_t read = TRY(_connection.read(doorbells, sizeof(doorbells)));
+
+        if (read == 0)
+        {
+            return ERR_STREAM_CLOSED;
+        }
+
+        return SUCCESS;
+    }
+
+    Result wait_for_room()
+    {
+        while (_send->writable() == 0)
+        {
+            if (_send->closed())
+            {
+                return ERR_STREAM_CLOSED;
+            }
+
+            if (!_send->request_room())
+            {
+                continue;
+            }
+
+            // This might as well be the doorbell of our own incoming ring.
+            TRY(wait_for_doorbell());
+            invoke_later_if_pending();
+        }
+
+        return SUCCESS;
+    }
+
+    void invoke_later_if_pending()
+    {
+        if (!_dispatching && _invoker && !_receive->empty())
+        {
+            _invoker->invoke_later();
+        }
+    }
+
+    void dispatch()
+    {
+        auto lifetime = _lifetime;
+        _dispatching = true;
+
+        // The callback might close or even destroy the channel.
+        while (lifetime->alive && shared() && !_receive->empty())
+        {
+            _on_receive();
+        }
+
+        if (lifetime->alive)
+        {
+            _dispatching = false;
+        }
+    }
+
+public:
+    RefPtr<IO::Handle> handle() override { return _connection.handle(); }
+
+    bool closed() { return _connection.closed(); }
+
+    bool shared() { return _send != nullptr && _receive != nullptr; }
+
+    Channel(IO::Connection connection, bool shared = true) : _connection{connection}
+    {
+        if (shared)
+        {
+            auto send_or_result = Ring::create();
+
+            if (send_or_result.success())
+            {
+                _send = send_or_result.unwrap();
+            }
+        }
+
+        Handshake handshake{
+            HANDSHAKE_MAGIC,
+            _send ? _send->handle() : HANDLE_INVALID_ID,
+        };
+
+        if (!_connection.write(&handshake, sizeof(Handshake)).success())
+        {
+            _send = nullptr;
+            _connection.close();
+        }
+    }
+
+    ~Channel()
+    {
+        _lifetime->alive = false;
+        close();
+    }
+
+    // Call `callback` each time a message can be read without blocking.
+    void on_receive(Callback<void()> callback)
+    {
+        _on_receive = callback;
+
+        _invoker = own<Async::Invoker>([this]() {
+            dispatch();
+        });
+
+        _notifier = own<Async::Notifier>(_connection, POLL_READ, [this]() {
+            if (!_negotiated)
+            {
+                // Wait for the next wakeup if there is nothing behind the handshake.
+                if (negotiate() != SUCCESS)
+                {
+                    _on_receive();
+                }
+
+                return;
+            }
+
+            if (!shared())
+            {
+                _on_receive();
+                return;
+            }
+
+            if (wait_for_doorbell() != SUCCESS)
+            {
+                // Let the callback see the error once everything is read.
+                auto lifetime = _lifetime;
+                dispatch();
+
+                if (lifetime->alive)
+                {
+                    _on_receive();
+                }
+
+                return;
+            }
+
+            dispatch();
+        });
+    }
+
+    ResultOr<size_t> read(void *buffer, size_t size) override
+    {
+        if (closed())
+        {
+            return ERR_STREAM_CLOSED;
+        }
+
+        TRY(negotiate());
+
+        if (!shared())
+        {
+            return _connection.read(buffer, size);
+        }
+
+        size_t read = 0;
+
+        while (read < size)
+        {
+            read += _receive->read(reinterpret_cast<uint8_t *>(buffer) + read, size - read);
+
+            // Before blocking below, the producer might be waiting for us.
+            TRY(ring_room_doorbell());
+
+            // The producer doesn't ring for what it published while we were
+            // reading, so only block once the ring is empty after our tail
+            // store.
+            if (read < size && _receive->empty())
+            {
+                if (_receive->closed())
+                {
+                    return ERR_STREAM_CLOSED;
+                }
+
+                TRY(wait_for_doorbell());
+            }
+        }
+
+        // We may have eaten the doorbell of the messages that follow.
+        invoke_later_if_pending();
+
+        return read;
+    }
+
+    ResultOr<size_t> readv(const IOVector *vectors, size_t count) override
+    {
+        if (closed())
+        {
+            return ERR_STREAM_CLOSED;
+        }
+
+        TRY(negotiate());
+
+        if (!shared())
+        {
+            return _connection.readv(vectors, count);
+        }
+
+        return Reader::readv(vectors, count);
+    }
+
+    ResultOr<size_t> write(const void *buffer, size_t size) override
+    {
+        IOVector vector{const_cast<void *>(buffer), size};
+        return writev(&vector, 1);
+    }
+
+    // In shared mode the buffers are published all at once, so the other
+    // end sees a whole message unless it is larger than the ring.
+    ResultOr<size_t> writev(const IOVector *vectors, size_t count) override
+    {
+        if (closed())
+        {
+            return ERR_STREAM_CLOSED;
+        }
+
+        TRY(negotiate());
+
+        if (!shared())
+        {
+            return _connection.writev(vectors, count);
+        }
+
+        size_t written = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            auto buffer = reinterpret_cast<const uint8_t *>(vectors[i].buffer);
+            size_t written_in_vector = 0;
+
+            while (written_in_vector < vectors[i].size)
+            {
+                written_in_vector += _send->write(buffer + written_in_vector, vectors[i].size - written_in_vector);
+
+                if (written_in_vector < vectors[i].size)
+                {
+                    TRY(ring_doorbell());
+                    TRY(wait_for_room());
+                }
+            }
+
+            written += written_in_vector;
+        }
+
+        TRY(ring_doorbell());
+
+        return written;
+    }
+
+    void close()
+    {
+        _notifier = nullptr;
+        _invoker = nullptr;
+        _send = nullptr;
+        _receive = nullptr;
+        _connection.close();
+    }
+};
+
+} // namespace IPC
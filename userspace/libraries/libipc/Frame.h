@@ -0,0 +1,82 @@
+#pragma once
+
+#include <libio/Reader.h>
+#include <libio/Writer.h>
+#include <libutils/ResultOr.h>
+
+namespace IPC
+{
+
+// Every message goes on the wire as a header followed by `size` bytes of
+// payload, so the receiver knows how much to read before looking at it.
+struct FrameHeader
+{
+    uint32_t type;
+    uint32_t size;
+};
+
+// Refuse anything bigger, a broken peer shouldn't make us allocate.
+static constexpr size_t FRAME_MAX_SIZE = 16 * 1024 * 1024;
+
+inline Result read_exactly(IO::Reader &reader, void *buffer, size_t size)
+{
+    size_t read = 0;
+
+    // Usually a single read, unless the message didn't fit in the
+    // buffer of the channel in one go.
+    while (read < size)
+    {
+        size_t read_this_time = TRY(reader.read(reinterpret_cast<uint8_t *>(buffer) + read, size - read));
+
+        if (read_this_time == 0)
+        {
+            return ERR_STREAM_CLOSED;
+        }
+
+        read += read_this_time;
+    }
+
+    return SUCCESS;
+}
+
+inline ResultOr<FrameHeader> read_frame_header(IO::Reader &reader)
+{
+    FrameHeader header{};
+    TRY(read_exactly(reader, &header, sizeof(FrameHeader)));
+
+    if (header.size > FRAME_MAX_SIZE)
+    {
+        return ERR_INVALID_DATA;
+    }
+
+    return header;
+}
+
+// The header and all the parts are handed to the writer at once, which is a
+// single syscall on a connection and a single publish on a shared ring.
+inline Result write_frame(IO::Writer &writer, uint32_t type, const IOVector *parts, size_t count)
+{
+    assert(count < IOVECTOR_MAX);
+
+    FrameHeader header{type, 0};
+    IOVector vectors[IOVECTOR_MAX];
+
+    vectors[0] = {&header, sizeof(FrameHeader)};
+
+    for (size_t i = 0; i < count; i++)
+    {
+        header.size += parts[i].size;
+        vectors[i + 1] = parts[i];
+    }
+
+    size_t written = TRY(writer.writev(vectors, count + 1));
+
+    if (written != sizeof(FrameHeader) + header.size)
+    {
+        return ERR_STREAM_CLOSED;
+    }
+
+    return SUCCESS;
+}
+
+} // namespace IPC
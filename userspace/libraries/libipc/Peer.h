@@ -1,34 +1,95 @@
 #pragma once
 
-#include <libasync/Notifier.h>
-#include <libio/Connection.h>
 #include <libio/Socket.h>
+#include <libipc/Channel.h>
 #include <libutils/Callback.h>
+#include <libutils/Optional.h>
 #include <libutils/ResultOr.h>
+#include <libutils/Vector.h>
 
 namespace IPC
 {
 
+// Messages carry a `request` id. A request gets a new one and the other
+// end copies it into the response, anything else leaves it at zero. This
+// lets many requests be in flight on the same connection, each response
+// completes its own request from the event loop.
 template <typename Protocol>
 struct Peer
 {
     using MessageType = typename Protocol::Message;
+    using RequestCallback = Callback<void(ResultOr<MessageType>)>;
 
 private:
-    IO::Connection _connection;
-    OwnPtr<Async::Notifier> _notifier;
+    struct PendingRequest
+    {
+        uint32_t id;
+        RequestCallback callback;
+    };
+
+    Channel _channel;
+    Protocol _protocol;
+
+    uint32_t _next_request = 1;
+    Vector<PendingRequest> _pending;
+
+    uint32_t allocate_request()
+    {
+        uint32_t id = _next_request++;
+
+        if (_next_request == 0)
+        {
+            _next_request = 1;
+        }
+
+        return id;
+    }
+
+    void dispatch(MessageType &message)
+    {
+        if (message.request != 0)
+        {
+            // Responses usually come back in order, so this is the first one.
+            for (size_t i = 0; i < _pending.count(); i++)
+            {
+                if (_pending[i].id == message.request)
+                {
+                    auto callback = move(_pending[i].callback);
+                    _pending.remove_index(i);
+                    callback(move(message));
+                    return;
+                }
+            }
+        }
+
+        handle_message(message);
+    }
+
+    void fail_pending_requests(Result result)
+    {
+        while (_pending.any())
+        {
+            auto callback = move(_pending[0].callback);
+            _pending.remove_index(0);
+            callback(result);
+        }
+    }
 
 public:
-    bool connected() { return !_connection.closed(); }
+    bool connected() { return !_channel.closed(); }
+
+    bool shared() { return _channel.shared(); }
 
-    Peer(IO::Connection connection) : _connection{connection}
+    size_t pending_requests() { return _pending.count(); }
+
+    Peer(IO::Connection connection, bool shared = true) : _channel{connection, shared}
     {
-        _notifier = own<Async::Notifier>(_connection, POLL_READ, [this]() {
-            auto result_or_message = Protocol::decode_message(_connection);
+        _channel.on_receive([this]() {
+            auto result_or_message = _protocol.decode_message(_channel);
 
             if (result_or_message.success())
             {
-                handle_message(result_or_message.unwrap());
+                dispatch(result_or_message.unwrap());
             }
             else
             {
@@ -39,12 +100,14 @@ public:
 
     virtual ~Peer()
     {
+        // Whoever made the requests is likely going away with us.
+        _pending.clear();
         close();
     }
 
     Result send(const MessageType &message)
     {
-        auto result = Protocol::encode_message(_connection, message);
+        auto result = _protocol.encode_message(_channel, message);
 
         if (result != SUCCESS)
         {
@@ -56,7 +119,7 @@ public:
 
     ResultOr<MessageType> receive()
     {
-        auto result_or_message = Protocol::decode_message(_connection);
+        auto result_or_message = _protocol.decode_message(_channel);
 
         if (!result_or_message.success())
         {
@@ -66,33 +129,61 @@ public:
         return result_or_message;
     }
 
-    template <typename TPredicate>
-    ResultOr<MessageType> send_and_wait_for(MessageType message, TPredicate predicate)
+    // Send the request and return right away, `callback` is called from the
+    // event loop with the response or with an error if the peer goes away.
+    Result request(MessageType message, RequestCallback callback)
+    {
+        if (!connected())
+        {
+            return ERR_STREAM_CLOSED;
+        }
+
+        message.request = allocate_request();
+        _pending.push_back({message.request, callback});
+
+        // On failure, close() already failed the request.
+        return send(message);
+    }
+
+    // Block until the response arrives. Other messages and responses to
+    // other requests are dispatched as they come in the meantime.
+    ResultOr<MessageType> request_and_wait(MessageType message)
     {
-        TRY(send(message));
+        Optional<ResultOr<MessageType>> response;
 
-        auto response = TRY(receive());
+        TRY(request(message, [&](ResultOr<MessageType> result) {
+            response = move(result);
+        }));
 
-        while (!predicate(response))
+        while (!response.present())
         {
-            handle_message(message);
-            response = TRY(receive());
+            auto result_or_message = receive();
+
+            if (!result_or_message.success())
+            {
+                fail_pending_requests(result_or_message.result());
+                break;
+            }
+
+            dispatch(result_or_message.unwrap());
         }
 
-        return response;
+        return response.unwrap();
     }
 
     void close()
     {
-        if (_connection.closed())
+        if (_channel.closed())
         {
+            fail_pending_requests(ERR_STREAM_CLOSED);
             return;
         }
 
         handle_disconnect();
 
-        _notifier = nullptr;
-        _connection.close();
+        _channel.close();
+
+        fail_pending_requests(ERR_STREAM_CLOSED);
     }
 
     virtual void handle_message(const MessageType &) {}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <abi/Handle.h>
+#include <assert.h>
+#include <libmath/MinMax.h>
+#include <libsystem/system/Memory.h>
+#include <libutils/OwnPtr.h>
+#include <libutils/ResultOr.h>
+#include <string.h>
+
+namespace IPC
+{
+
+// Lives at the start of the shared memory object, followed by the data.
+// head is only written by the producer and tail only by the consumer, both
+// are free running counters wrapped using the capacity mask. waiting is set
+// by the producer when the ring is full and cleared by the consumer once it
+// made some room.
+struct RingHeader
+{
+    uint32_t head;
+    uint32_t tail;
+    uint32_t capacity;
+    uint32_t closed;
+    uint32_t waiting;
+};
+
+// A single producer, single consumer byte ring in memory shared between
+// two processes.
+class Ring
+{
+private:
+    uintptr_t _address = 0;
+    int _handle = HANDLE_INVALID_ID;
+    RingHeader *_header = nullptr;
+    uint8_t *_data = nullptr;
+    uint32_t _mask = 0;
+
+    // Bytes written by the producer but not visible to the consumer yet.
+    uint32_t _head = 0;
+
+    NONCOPYABLE(Ring);
+    NONMOVABLE(Ring);
+
+    uint32_t load(uint32_t &value) { return __atomic_load_n(&value, __ATOMIC_SEQ_CST); }
+
+    void store(uint32_t &value, uint32_t new_value) { __atomic_store_n(&value, new_value, __ATOMIC_SEQ_CST); }
+
+    static bool valid_capacity(size_t capacity) { return capacity != 0 && (capacity & (capacity - 1)) == 0; }
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    static ResultOr<OwnPtr<Ring>> create(size_t capacity = DEFAULT_CAPACITY)
+    {
+        if (!valid_capacity(capacity))
+        {
+            return ERR_INVALID_ARGUMENT;
+        }
+
+        uintptr_t address = 0;
+        TRY(memory_alloc(sizeof(RingHeader) + capacity, &address));
+
+        int handle = HANDLE_INVALID_ID;
+        auto result = memory_get_handle(address, &handle);
+
+        if (result != SUCCESS)
+        {
+            memory_free(address);
+            return result;
+        }
+
+        auto header = reinterpret_cast<RingHeader *>(address);
+        header->head = 0;
+        header->tail = 0;
+        header->capacity = capacity;
+        header->closed = false;
+        header->waiting = false;
+
+        return own<Ring>(address, handle, capacity);
+    }
+
+    static ResultOr<OwnPtr<Ring>> include(int handle)
+    {
+        uintptr_t address = 0;
+        size_t size = 0;
+        TRY(memory_include(handle, &address, &size));
+
+        if (size < sizeof(RingHeader))
+        {
+            memory_free(address);
+            return ERR_INVALID_DATA;
+        }
+
+        // Read once, the other end could change it under our feet.
+        auto header = reinterpret_cast<RingHeader *>(address);
+        uint32_t capacity = __atomic_load_n(&header->capacity, __ATOMIC_SEQ_CST);
+
+        if (!valid_capacity(capacity) || size < sizeof(RingHeader) + capacity)
+        {
+            memory_free(address);
+            return ERR_INVALID_DATA;
+        }
+
+        return own<Ring>(address, handle, capacity);
+    }
+
+    Ring(uintptr_t address, int handle, uint32_t capacity)
+        : _address{address},
+          _handle{handle},
+          _header{reinterpret_cast<RingHeader *>(address)},
+          _data{reinterpret_cast<uint8_t *>(address + sizeof(RingHeader))},
+          _mask{capacity - 1},
+          _head{_header->head}
+    {
+        assert(valid_capacity(capacity));
+    }
+
+    ~Ring()
+    {
+        close();
+        memory_free(_address);
+    }
+
+    int handle() { return _handle; }
+
+    size_t capacity() { return _mask + 1; }
+
+    bool closed() { return load(_header->closed); }
+
+    void close() { store(_header->closed, true); }
+
+    /* --- Producer --------------------------------------------------------- */
+
+    // Clamped so a misbehaving consumer can't make us write past the data,
+    // a tail ahead of our head leaves no room at all.
+    size_t writable()
+    {
+        size_t used = _head - load(_header->tail);
+        return used > capacity() ? 0 : capacity() - used;
+    }
+
+    // Copy as much as possible into the ring, it only becomes visible to
+    // the consumer after publish().
+    size_t write(const void *buffer, size_t size)
+    {
+        size_t written = MIN(size, writable());
+        size_t offset = _head & _mask;
+        size_t first = MIN(written, capacity() - offset);
+
+        memcpy(_data + offset, buffer, first);
+        memcpy(_data, reinterpret_cast<const uint8_t *>(buffer) + first, written - first);
+
+        _head += written;
+
+        return written;
+    }
+
+    // Returns true if the consumer had already read everything that was
+    // published before, in which case it might be waiting for a doorbell.
+    bool publish()
+    {
+        uint32_t published = _header->head;
+
+        if (published == _head)
+        {
+            return false;
+        }
+
+        store(_header->head, _head);
+
+        return load(_header->tail) == published;
+    }
+
+    // Asks the consumer to ring once it made some room. Returns false if
+    // there is already some, then the caller must not wait for the doorbell.
+    bool request_room()
+    {
+        store(_header->waiting, true);
+
+        // Checked after the store, so either we see the room or the
+        // consumer sees the request.
+        return writable() == 0;
+    }
+
+    /* --- Consumer --------------------------------------------------------- */
+
+    // Clamped so a misbehaving producer can't make us read past the data.
+    size_t readable() { return MIN(load(_header->head) - _header->tail, capacity()); }
+
+    bool empty() { return readable() == 0; }
+
+    size_t read(void *buffer, size_t size)
+    {
+        uint32_t tail = _header->tail;
+
+        size_t read = MIN(size, readable());
+        size_t offset = tail & _mask;
+        size_t first = MIN(read, capacity() - offset);
+
+        memcpy(buffer, _data + offset, first);
+        memcpy(reinterpret_cast<uint8_t *>(buffer) + first, _data, read - first);
+
+        store(_header->tail, tail + read);
+
+        return read;
+    }
+
+    // Returns true once after the producer asked for room, call it after
+    // reading and ring the producer if it does.
+    bool room_requested()
+    {
+        if (!load(_header->waiting))
+        {
+            return false;
+        }
+
+        return __atomic_exchange_n(&_header->waiting, false, __ATOMIC_SEQ_CST);
+    }
+};
+
+} // namespace IPC
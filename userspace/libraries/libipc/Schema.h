@@ -0,0 +1,167 @@
+#pragma once
+
+#include <libipc/Frame.h>
+
+namespace IPC
+{
+
+/* --- Layouts -------------------------------------------------------------- */
+
+template <typename T>
+struct MemberPointer;
+
+template <typename TClass, typename TMember>
+struct MemberPointer<TMember TClass::*>
+{
+    using Class = TClass;
+    using Member = TMember;
+};
+
+template <typename T>
+struct ArrayTraits;
+
+template <typename TElement, size_t N>
+struct ArrayTraits<TElement[N]>
+{
+    using Element = TElement;
+    static constexpr size_t CAPACITY = N;
+};
+
+// The payload goes on the wire as is.
+struct Whole
+{
+    template <typename T>
+    static size_t wire_size(const T &)
+    {
+        return sizeof(T);
+    }
+
+    template <typename T>
+    static bool valid(const T &, size_t size)
+    {
+        return size == sizeof(T);
+    }
+};
+
+// The payload ends with a fixed capacity array of which only the first
+// `payload.*TCount` elements are used, the rest is left out of the frame.
+// The array has to be the last member of the payload.
+template <auto TCount, auto TArray>
+struct Trailing
+{
+    using Payload = typename MemberPointer<decltype(TCount)>::Class;
+    using Array = typename MemberPointer<decltype(TArray)>::Member;
+
+    static constexpr size_t CAPACITY = ArrayTraits<Array>::CAPACITY;
+    static constexpr size_t ELEMENT_SIZE = sizeof(typename ArrayTraits<Array>::Element);
+
+    static size_t offset(const Payload &payload)
+    {
+        return reinterpret_cast<const uint8_t *>(&(payload.*TArray)) - reinterpret_cast<const uint8_t *>(&payload);
+    }
+
+    static size_t wire_size(const Payload &payload)
+    {
+        size_t count = payload.*TCount;
+        return offset(payload) + (count < CAPACITY ? count : CAPACITY) * ELEMENT_SIZE;
+    }
+
+    static bool valid(const Payload &payload, size_t size)
+    {
+        return size >= offset(payload) &&
+               (size_t)(payload.*TCount) <= CAPACITY &&
+               size == wire_size(payload);
+    }
+};
+
+/* --- Schema --------------------------------------------------------------- */
+
+// Ties a message type to the member of the message union carrying its
+// payload. Types without an entry have no payload.
+template <auto TType, auto TMember, typename TLayout = Whole>
+struct Entry
+{
+    using Payload = typename MemberPointer<decltype(TMember)>::Member;
+
+    static constexpr uint32_t TYPE = TType;
+
+    template <typename TMessage>
+    static IOVector vector(const TMessage &message)
+    {
+        auto &payload = message.*TMember;
+        return {const_cast<Payload *>(&payload), TLayout::wire_size(payload)};
+    }
+
+    // The payload is read straight into the message, the caller keeps
+    // looking at the bytes that came out of the channel.
+    template <typename TMessage>
+    static Result read(IO::Reader &reader, TMessage &message, size_t size)
+    {
+        auto &payload = message.*TMember;
+
+        if (size > sizeof(Payload))
+        {
+            return ERR_INVALID_DATA;
+        }
+
+        TRY(read_exactly(reader, &payload, size));
+
+        if (!TLayout::valid(payload, size))
+        {
+            return ERR_INVALID_DATA;
+        }
+
+        return SUCCESS;
+    }
+};
+
+// Describes how a protocol whose messages are a tagged union goes on the
+// wire. Each frame only carries the member of the union that is in use, so
+// a small message doesn't pay for the largest one.
+//
+//     using FooSchema = IPC::Schema<
+//         FooMessage,
+//         IPC::Entry<FOO_HELLO, &FooMessage::hello>,
+//         IPC::Entry<FOO_DATA, &FooMessage::data, IPC::Trailing<&FooData::count, &FooData::items>>>;
+//
+template <typename TMessage, typename... TEntries>
+struct Schema
+{
+    using Message = TMessage;
+
+    static IOVector vector(const TMessage &message)
+    {
+        IOVector vector{nullptr, 0};
+        uint32_t type = message.type;
+
+        ((type == TEntries::TYPE ? (vector = TEntries::vector(message), true) : false) || ...);
+
+        return vector;
+    }
+
+    static size_t wire_size(const TMessage &message)
+    {
+        return sizeof(FrameHeader) + vector(message).size;
+    }
+
+    static Result write(IO::Writer &writer, const TMessage &message)
+    {
+        auto payload = vector(message);
+        return write_frame(writer, message.type, &payload, payload.size > 0 ? 1 : 0);
+    }
+
+    static Result read(IO::Reader &reader, TMessage &message)
+    {
+        auto header = TRY(read_frame_header(reader));
+
+        message.type = static_cast<decltype(message.type)>(header.type);
+
+        Result result = header.size == 0 ? SUCCESS : ERR_INVALID_DATA;
+
+        ((header.type == TEntries::TYPE ? (result = TEntries::read(reader, message, header.size), true) : false) || ...);
+
+        return result;
+    }
+};
+
+} // namespace IPC
@@ -0,0 +1,359 @@
+#pragma once
+
+#include <libjson/Value.h>
+#include <libutils/ResultOr.h>
+#include <libutils/String.h>
+#include <libutils/Vector.h>
+#include <string.h>
+
+namespace Json
+{
+
+// A compact encoding of Json values for talking between processes. Each
+// value is a one byte tag followed by its payload, lengths and integers are
+// LEB128 varints. Object keys are interned: the first occurrence of a key is
+// written in full and every following one refers to it by index.
+enum BinaryTag : uint8_t
+{
+    BINARY_NIL,
+    BINARY_TRUE,
+    BINARY_FALSE,
+    BINARY_INTEGER,
+    BINARY_DOUBLE,
+    BINARY_STRING,
+    BINARY_ARRAY,
+    BINARY_OBJECT,
+};
+
+static constexpr size_t BINARY_MAX_DEPTH = 64;
+
+// Past that many distinct keys, new ones are written in full every time.
+static constexpr size_t BINARY_MAX_INTERNED_KEYS = 64;
+
+class BinaryWriter
+{
+private:
+    Vector<uint8_t> _buffer;
+    Vector<String> _keys;
+
+    void append(const void *data, size_t size)
+    {
+        size_t offset = _buffer.count();
+        _buffer.resize(offset + size);
+        memcpy(_buffer.raw_storage() + offset, data, size);
+    }
+
+public:
+    const uint8_t *data() const { return _buffer.raw_storage(); }
+
+    size_t size() const { return _buffer.count(); }
+
+    void clear()
+    {
+        _buffer.clear();
+        _keys.clear();
+    }
+
+    void write_byte(uint8_t byte)
+    {
+        _buffer.push_back(byte);
+    }
+
+    void write_varint(uint64_t value)
+    {
+        uint8_t bytes[10];
+        size_t count = 0;
+
+        do
+        {
+            bytes[count] = value & 0x7f;
+            value >>= 7;
+
+            if (value != 0)
+            {
+                bytes[count] |= 0x80;
+            }
+
+            count++;
+        } while (value != 0);
+
+        append(bytes, count);
+    }
+
+    void write_string(const String &string)
+    {
+        write_varint(string.length());
+        append(string.cstring(), string.length());
+    }
+
+    // Zero means a new key follows, anything else is one plus the index of
+    // a key already written.
+    void write_key(const String &key)
+    {
+        for (size_t i = 0; i < _keys.count(); i++)
+        {
+            if (_keys[i] == key)
+            {
+                write_varint(i + 1);
+                return;
+            }
+        }
+
+        write_varint(0);
+        write_string(key);
+
+        if (_keys.count() < BINARY_MAX_INTERNED_KEYS)
+        {
+            _keys.push_back(key);
+        }
+    }
+
+    void write(const Value &value)
+    {
+        if (value.is(STRING))
+        {
+            write_byte(BINARY_STRING);
+            write_string(value.as_string());
+        }
+        else if (value.is(INTEGER))
+        {
+            // Zigzag so small negative numbers stay small.
+            int64_t integer = value.as_integer();
+            write_byte(BINARY_INTEGER);
+            write_varint(((uint64_t)integer << 1) ^ (uint64_t)(integer >> 63));
+        }
+#ifndef __KERNEL__
+        else if (value.is(DOUBLE))
+        {
+            double number = value.as_double();
+            write_byte(BINARY_DOUBLE);
+            append(&number, sizeof(number));
+        }
+#endif
+        else if (value.is(OBJECT))
+        {
+            write_byte(BINARY_OBJECT);
+            write_varint(value.length());
+
+            value.as_object().foreach([&](auto &key, auto &child) {
+                write_key(key);
+                write(child);
+
+                return Iteration::CONTINUE;
+            });
+        }
+        else if (value.is(ARRAY))
+        {
+            write_byte(BINARY_ARRAY);
+            write_varint(value.length());
+
+            for (size_t i = 0; i < value.length(); i++)
+            {
+                write(value.get(i));
+            }
+        }
+        else if (value.is(TRUE))
+        {
+            write_byte(BINARY_TRUE);
+        }
+        else if (value.is(FALSE))
+        {
+            write_byte(BINARY_FALSE);
+        }
+        else
+        {
+            write_byte(BINARY_NIL);
+        }
+    }
+};
+
+class BinaryReader
+{
+private:
+    const uint8_t *_data;
+    size_t _size;
+    size_t _offset = 0;
+    Vector<String> _keys;
+
+public:
+    bool ended() const { return _offset >= _size; }
+
+    BinaryReader(const void *data, size_t size)
+        : _data{reinterpret_cast<const uint8_t *>(data)},
+          _size{size}
+    {
+    }
+
+    ResultOr<uint8_t> read_byte()
+    {
+        if (ended())
+        {
+            return ERR_INVALID_DATA;
+        }
+
+        return _data[_offset++];
+    }
+
+    ResultOr<uint64_t> read_varint()
+    {
+        uint64_t value = 0;
+
+        for (size_t shift = 0; shift < 64; shift += 7)
+        {
+            uint8_t byte = TRY(read_byte());
+            value |= (uint64_t)(byte & 0x7f) << shift;
+
+            if (!(byte & 0x80))
+            {
+                return value;
+            }
+        }
+
+        return ERR_INVALID_DATA;
+    }
+
+    ResultOr<String> read_string()
+    {
+        uint64_t length = TRY(read_varint());
+
+        if (length > _size - _offset)
+        {
+            return ERR_INVALID_DATA;
+        }
+
+        String string{reinterpret_cast<const char *>(_data + _offset), (size_t)length};
+        _offset += length;
+
+        return string;
+    }
+
+    ResultOr<String> read_key()
+    {
+        uint64_t index = TRY(read_varint());
+
+        if (index == 0)
+        {
+            auto key = TRY(read_string());
+
+            if (_keys.count() < BINARY_MAX_INTERNED_KEYS)
+            {
+                _keys.push_back(key);
+            }
+
+            return key;
+        }
+
+        if (index > _keys.count())
+        {
+            return ERR_INVALID_DATA;
+        }
+
+        return _keys[index - 1];
+    }
+
+    ResultOr<Value> read(size_t depth = 0)
+    {
+        if (depth > BINARY_MAX_DEPTH)
+        {
+            return ERR_INVALID_DATA;
+        }
+
+        uint8_t tag = TRY(read_byte());
+
+        switch (tag)
+        {
+        case BINARY_NIL:
+            return Value{nullptr};
+
+        case BINARY_TRUE:
+            return Value{true};
+
+        case BINARY_FALSE:
+            return Value{false};
+
+        case BINARY_INTEGER:
+        {
+            uint64_t zigzag = TRY(read_varint());
+            return Value{(int64_t)((zigzag >> 1) ^ -(zigzag & 1))};
+        }
+
+#ifndef __KERNEL__
+        case BINARY_DOUBLE:
+        {
+            double number;
+
+            if (sizeof(number) > _size - _offset)
+            {
+                return ERR_INVALID_DATA;
+            }
+
+            memcpy(&number, _data + _offset, sizeof(number));
+            _offset += sizeof(number);
+
+            return Value{number};
+        }
+#endif
+
+        case BINARY_STRING:
+            return Value{TRY(read_string())};
+
+        case BINARY_ARRAY:
+        {
+            uint64_t count = TRY(read_varint());
+
+            // Every element takes at least one byte.
+            if (count > _size - _offset)
+            {
+                return ERR_INVALID_DATA;
+            }
+
+            Value::Array array;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                array.push_back(TRY(read(depth + 1)));
+            }
+
+            return Value{move(array)};
+        }
+
+        case BINARY_OBJECT:
+        {
+            uint64_t count = TRY(read_varint());
+
+            if (count > _size - _offset)
+            {
+                return ERR_INVALID_DATA;
+            }
+
+            Value::Object object;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                auto key = TRY(read_key());
+                object[key] = TRY(read(depth + 1));
+            }
+
+            return Value{move(object)};
+        }
+
+        default:
+            return ERR_INVALID_DATA;
+        }
+    }
+};
+
+inline ResultOr<Value> decode_binary(const void *data, size_t size)
+{
+    BinaryReader reader{data, size};
+    auto value = TRY(reader.read());
+
+    if (!reader.ended())
+    {
+        return ERR_INVALID_DATA;
+    }
+
+    return value;
+}
+
+} // namespace Json
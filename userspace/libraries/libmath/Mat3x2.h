@@ -188,8 +188,8 @@ public:
             _m[0] * other[1] + _m[1] * other[3],
             _m[2] * other[0] + _m[3] * other[2],
             _m[2] * other[1] + _m[3] * other[3],
-            _m[4] * other[1] + _m[5] * other[3] + other[5],
             _m[4] * other[0] + _m[5] * other[2] + other[4],
+            _m[4] * other[1] + _m[5] * other[3] + other[5],
         };
     }
 };
@@ -42,7 +42,7 @@ public:
         auto x1 = MAX(a.x(), b.x());
         auto y1 = MAX(a.y(), b.y());
 
-        return {x0, y0, x1 - x0, y1 - y0};
+        return Rect(Vec2<Scalar>{x0, y0}, Vec2<Scalar>{x1 - x0, y1 - y0});
     }
 
     auto x() const { return _x; }
@@ -113,7 +113,7 @@ public:
     {
     }
 
-    bool operator==(const Rect &other)
+    bool operator==(const Rect &other) const
     {
         return _x == other._x &&
                _y == other._y &&
@@ -121,7 +121,7 @@ public:
                _height == other._height;
     }
 
-    bool operator!=(const Rect &other)
+    bool operator!=(const Rect &other) const
     {
         return !(*this == other);
     }
@@ -446,7 +446,7 @@ public:
     bool contains(Rect other) const
     {
         return left() <= other.left() && right() >= other.right() &&
-               right() <= other.top() && bottom() >= other.bottom();
+               top() <= other.top() && bottom() >= other.bottom();
     }
 
     Border contains(Insets<Scalar> spacing, Vec2<Scalar> position) const
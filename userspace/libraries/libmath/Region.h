@@ -0,0 +1,369 @@
+#pragma once
+
+#include <libmath/Rect.h>
+#include <libutils/Vector.h>
+
+namespace Math
+{
+
+// A set of pixels made out of rectangles, kept in bands. Bands go from top
+// to bottom without overlapping, every rectangle of a band has the same top
+// and bottom, and they are sorted from left to right without touching each
+// other. Neighbouring bands with the same spans are merged into one. The
+// representation of a set of pixels is unique, so the number of rectangles
+// stays small however many operations the region went through.
+template <typename Scalar>
+struct Region
+{
+private:
+    Vector<Rect<Scalar>> _rects;
+
+    enum class Operation
+    {
+        MERGE,
+        CLIP,
+        REMOVE,
+    };
+
+    struct Span
+    {
+        Scalar left;
+        Scalar right;
+    };
+
+    static bool keep(Operation operation, bool in_a, bool in_b)
+    {
+        switch (operation)
+        {
+        case Operation::MERGE:
+            return in_a || in_b;
+
+        case Operation::CLIP:
+            return in_a && in_b;
+
+        default:
+            return in_a && !in_b;
+        }
+    }
+
+    static size_t band_end(const Vector<Rect<Scalar>> &rects, size_t start)
+    {
+        size_t end = start;
+
+        while (end < rects.count() && rects[end].top() == rects[start].top())
+        {
+            end++;
+        }
+
+        return end;
+    }
+
+    // Both bands are sorted from left to right, so are their edges, which
+    // are walked in order as the x axis is swept.
+    static void combine_spans(
+        Operation operation,
+        const Rect<Scalar> *a, size_t a_count,
+        const Rect<Scalar> *b, size_t b_count,
+        Vector<Span> &spans)
+    {
+        spans.clear();
+
+        size_t a_edge = 0;
+        size_t b_edge = 0;
+
+        auto edge = [](const Rect<Scalar> *rects, size_t index) {
+            return index % 2 == 0 ? rects[index / 2].left() : rects[index / 2].right();
+        };
+
+        bool in_span = false;
+        Scalar span_left = 0;
+
+        while (a_edge < a_count * 2 || b_edge < b_count * 2)
+        {
+            Scalar x;
+
+            if (b_edge == b_count * 2 || (a_edge < a_count * 2 && edge(a, a_edge) <= edge(b, b_edge)))
+            {
+                x = edge(a, a_edge);
+            }
+            else
+            {
+                x = edge(b, b_edge);
+            }
+
+            while (a_edge < a_count * 2 && edge(a, a_edge) == x)
+            {
+                a_edge++;
+            }
+
+            while (b_edge < b_count * 2 && edge(b, b_edge) == x)
+            {
+                b_edge++;
+            }
+
+            // An odd number of edges behind us means we are inside.
+            bool inside = keep(operation, a_edge % 2 == 1, b_edge % 2 == 1);
+
+            if (inside && !in_span)
+            {
+                span_left = x;
+                in_span = true;
+            }
+            else if (!inside && in_span)
+            {
+                spans.push_back({span_left, x});
+                in_span = false;
+            }
+        }
+    }
+
+    void append_band(Scalar top, Scalar bottom, const Vector<Span> &spans, size_t &last_band)
+    {
+        if (spans.empty())
+        {
+            return;
+        }
+
+        // Grow the band above if it ends where this one starts and covers
+        // the same spans.
+        if (last_band < _rects.count() &&
+            _rects[last_band].bottom() == top &&
+            _rects.count() - last_band == spans.count())
+        {
+            bool same = true;
+
+            for (size_t i = 0; i < spans.count(); i++)
+            {
+                auto &rect = _rects[last_band + i];
+
+                if (rect.left() != spans[i].left || rect.right() != spans[i].right)
+                {
+                    same = false;
+                    break;
+                }
+            }
+
+            if (same)
+            {
+                for (size_t i = last_band; i < _rects.count(); i++)
+                {
+                    _rects[i] = {_rects[i].x(), _rects[i].y(), _rects[i].width(), bottom - _rects[i].y()};
+                }
+
+                return;
+            }
+        }
+
+        last_band = _rects.count();
+
+        for (size_t i = 0; i < spans.count(); i++)
+        {
+            _rects.push_back({spans[i].left, top, spans[i].right - spans[i].left, bottom - top});
+        }
+    }
+
+    // Sweeps the y axis from band edge to band edge, between two edges
+    // the spans of both regions don't change and can be combined.
+    static Region combine(Operation operation, const Region &a, const Region &b)
+    {
+        Region result;
+        Vector<Span> spans;
+
+        size_t last_band = 0;
+
+        size_t a_band = 0;
+        size_t b_band = 0;
+
+        Scalar y = MIN(
+            a._rects.empty() ? b._rects[0].top() : a._rects[0].top(),
+            b._rects.empty() ? a._rects[0].top() : b._rects[0].top());
+
+        while (a_band < a._rects.count() || b_band < b._rects.count())
+        {
+            size_t a_end = a_band < a._rects.count() ? band_end(a._rects, a_band) : a_band;
+            size_t b_end = b_band < b._rects.count() ? band_end(b._rects, b_band) : b_band;
+
+            bool in_a = a_band < a._rects.count() && a._rects[a_band].top() <= y;
+            bool in_b = b_band < b._rects.count() && b._rects[b_band].top() <= y;
+
+            // The next place where either region changes.
+            Scalar next = 0;
+            bool has_next = false;
+
+            auto consider = [&](Scalar value) {
+                if (value > y && (!has_next || value < next))
+                {
+                    next = value;
+                    has_next = true;
+                }
+            };
+
+            if (a_band < a._rects.count())
+            {
+                consider(in_a ? a._rects[a_band].bottom() : a._rects[a_band].top());
+            }
+
+            if (b_band < b._rects.count())
+            {
+                consider(in_b ? b._rects[b_band].bottom() : b._rects[b_band].top());
+            }
+
+            if (!has_next)
+            {
+                break;
+            }
+
+            if (in_a || in_b)
+            {
+                combine_spans(
+                    operation,
+                    in_a ? &a._rects[a_band] : nullptr, in_a ? a_end - a_band : 0,
+                    in_b ? &b._rects[b_band] : nullptr, in_b ? b_end - b_band : 0,
+                    spans);
+
+                result.append_band(y, next, spans, last_band);
+            }
+
+            y = next;
+
+            if (in_a && a._rects[a_band].bottom() == y)
+            {
+                a_band = a_end;
+            }
+
+            if (in_b && b._rects[b_band].bottom() == y)
+            {
+                b_band = b_end;
+            }
+        }
+
+        return result;
+    }
+
+public:
+    const Vector<Rect<Scalar>> &rects() const { return _rects; }
+
+    size_t count() const { return _rects.count(); }
+
+    bool is_empty() const { return _rects.empty(); }
+
+    Region() {}
+
+    Region(Rect<Scalar> rect)
+    {
+        if (!rect.is_empty())
+        {
+            _rects.push_back(rect);
+        }
+    }
+
+    Rect<Scalar> bound() const
+    {
+        if (is_empty())
+        {
+            return Rect<Scalar>::empty();
+        }
+
+        Scalar left = _rects[0].left();
+        Scalar right = _rects[0].right();
+
+        for (size_t i = 1; i < _rects.count(); i++)
+        {
+            left = MIN(left, _rects[i].left());
+            right = MAX(right, _rects[i].right());
+        }
+
+        return {left, _rects[0].top(), right - left, _rects[_rects.count() - 1].bottom() - _rects[0].top()};
+    }
+
+    bool contains(Vec2<Scalar> position) const
+    {
+        for (size_t i = 0; i < _rects.count(); i++)
+        {
+            if (_rects[i].contains(position))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool colide_with(Rect<Scalar> rect) const
+    {
+        for (size_t i = 0; i < _rects.count(); i++)
+        {
+            if (_rects[i].colide_with(rect))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    Region merged_with(const Region &other) const
+    {
+        if (is_empty())
+        {
+            return other;
+        }
+
+        if (other.is_empty())
+        {
+            return *this;
+        }
+
+        return combine(Operation::MERGE, *this, other);
+    }
+
+    Region clipped_with(const Region &other) const
+    {
+        if (is_empty() || other.is_empty())
+        {
+            return {};
+        }
+
+        return combine(Operation::CLIP, *this, other);
+    }
+
+    Region without(const Region &other) const
+    {
+        if (is_empty() || other.is_empty())
+        {
+            return *this;
+        }
+
+        return combine(Operation::REMOVE, *this, other);
+    }
+
+    Region offset(Vec2<Scalar> offset) const
+    {
+        Region result = *this;
+
+        for (size_t i = 0; i < result._rects.count(); i++)
+        {
+            result._rects[i] = result._rects[i].offset(offset);
+        }
+
+        return result;
+    }
+
+    void add(const Region &other) { *this = merged_with(other); }
+
+    void clip(const Region &other) { *this = clipped_with(other); }
+
+    void remove(const Region &other) { *this = without(other); }
+
+    void clear() { _rects.clear(); }
+
+    template <typename Callback>
+    Iteration foreach(Callback callback) const
+    {
+        return _rects.foreach(callback);
+    }
+};
+
+using Regioni = Region<int>;
+
+} // namespace Math
@@ -1,18 +1,39 @@
-#include <libio/Copy.h>
-#include <libio/MemoryWriter.h>
 #include <libsettings/Protocol.h>
+#include <string.h>
 
 namespace Settings
 {
 
+enum MessageFlag : uint8_t
+{
+    // The path and the payload use the binary encoding.
+    MESSAGE_BINARY = 1 << 0,
+
+    // The sender can decode binary messages.
+    MESSAGE_ACCEPTS_BINARY = 1 << 1,
+};
+
+// Follows the frame header, the path and the payload make up the rest of
+// the frame.
 struct MessageHeader
 {
-    Message::Type type;
-    size_t path_length;
-    size_t payload_length;
+    uint8_t flags;
+    uint32_t request;
+    uint32_t path_length;
 };
 
-Result Protocol::encode_message(IO::Connection &connection, const Message &message)
+static Result write_message(IO::Writer &writer, Message::Type type, MessageHeader &header, const char *path, const char *payload, size_t payload_length)
+{
+    IOVector parts[] = {
+        {&header, sizeof(MessageHeader)},
+        {const_cast<char *>(path), header.path_length},
+        {const_cast<char *>(payload), payload_length},
+    };
+
+    return IPC::write_frame(writer, type, parts, ARRAY_LENGTH(parts));
+}
+
+Result Protocol::encode_text(IO::Writer &writer, const Message &message)
 {
     String path_buffer = "";
 
@@ -32,49 +53,131 @@ Result Protocol::encode_message(IO::Connection &connection, const Message &messa
         payload_buffer = pretty.finalize();
     }
 
-    MessageHeader header;
-    header.type = message.type;
+    MessageHeader header{};
+    header.flags = MESSAGE_ACCEPTS_BINARY;
+    header.request = message.request;
     header.path_length = path_buffer.length();
-    header.payload_length = payload_buffer.length();
 
-    TRY(connection.write(&header, sizeof(MessageHeader)));
+    return write_message(writer, message.type, header, path_buffer.cstring(), payload_buffer.cstring(), payload_buffer.length());
+}
+
+Result Protocol::encode_binary(IO::Writer &writer, const Message &message)
+{
+    _writer.clear();
 
-    if (path_buffer.length())
+    if (message.path.present())
     {
-        TRY(connection.write(path_buffer.cstring(), path_buffer.length()));
+        auto &path = message.path.unwrap();
+        _writer.write_string(path.domain);
+        _writer.write_string(path.bundle);
+        _writer.write_string(path.key);
     }
 
-    if (payload_buffer.length())
+    size_t path_length = _writer.size();
+
+    if (message.payload.present())
     {
-        TRY(connection.write(payload_buffer.cstring(), payload_buffer.length()));
+        _writer.write(message.payload.unwrap());
     }
 
-    return SUCCESS;
+    MessageHeader header{};
+    header.flags = MESSAGE_BINARY | MESSAGE_ACCEPTS_BINARY;
+    header.request = message.request;
+    header.path_length = path_length;
+
+    auto data = reinterpret_cast<const char *>(_writer.data());
+
+    return write_message(writer, message.type, header, data, data + path_length, _writer.size() - path_length);
+}
+
+Result Protocol::encode_message(IO::Writer &writer, const Message &message)
+{
+    if (_binary)
+    {
+        return encode_binary(writer, message);
+    }
+    else
+    {
+        return encode_text(writer, message);
+    }
 }
 
-ResultOr<Message> Protocol::decode_message(IO::Connection &connection)
+static ResultOr<Path> decode_binary_path(const char *buffer, size_t size)
 {
-    MessageHeader header;
+    Json::BinaryReader reader{buffer, size};
 
-    TRY(connection.read(&header, sizeof(header)));
+    Path path;
+    path.domain = TRY(reader.read_string());
+    path.bundle = TRY(reader.read_string());
+    path.key = TRY(reader.read_string());
+
+    if (!reader.ended())
+    {
+        return ERR_INVALID_DATA;
+    }
+
+    return path;
+}
+
+ResultOr<Message> Protocol::decode_message(IO::Reader &reader)
+{
+    auto frame = TRY(IPC::read_frame_header(reader));
+
+    if (frame.size < sizeof(MessageHeader))
+    {
+        return ERR_INVALID_DATA;
+    }
+
+    _buffer.resize(frame.size);
+    TRY(IPC::read_exactly(reader, _buffer.raw_storage(), frame.size));
+
+    MessageHeader header{};
+    memcpy(&header, _buffer.raw_storage(), sizeof(MessageHeader));
+
+    size_t remaining = frame.size - sizeof(MessageHeader);
+
+    if (header.path_length > remaining)
+    {
+        return ERR_INVALID_DATA;
+    }
+
+    if (header.flags & MESSAGE_ACCEPTS_BINARY)
+    {
+        _binary = true;
+    }
 
     Message message;
-    message.type = header.type;
+    message.type = static_cast<Message::Type>(frame.type);
+    message.request = header.request;
+
+    size_t payload_length = remaining - header.path_length;
+
+    const char *path_buffer = _buffer.raw_storage() + sizeof(MessageHeader);
+    const char *payload_buffer = path_buffer + header.path_length;
+
+    if (header.flags & MESSAGE_BINARY)
+    {
+        if (header.path_length > 0)
+        {
+            message.path = TRY(decode_binary_path(path_buffer, header.path_length));
+        }
+
+        if (payload_length > 0)
+        {
+            message.payload = TRY(Json::decode_binary(payload_buffer, payload_length));
+        }
+
+        return message;
+    }
 
     if (header.path_length > 0)
     {
-        IO::MemoryWriter memory;
-        TRY(IO::copy(connection, memory, header.path_length));
-        String str = memory.string();
-        message.path = Path::parse(str);
+        message.path = Path::parse(path_buffer, header.path_length);
     }
 
-    if (header.payload_length > 0)
+    if (payload_length > 0)
     {
-        IO::MemoryWriter memory;
-        TRY(IO::copy(connection, memory, header.payload_length));
-        String str = memory.string();
-        message.payload = Json::parse(str);
+        message.payload = Json::parse(payload_buffer, payload_length);
     }
 
     return message;
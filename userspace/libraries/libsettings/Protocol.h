@@ -1,6 +1,8 @@
 #pragma once
 
+#include <libipc/Frame.h>
 #include <libipc/Peer.h>
+#include <libjson/Binary.h>
 #include <libjson/Json.h>
 
 #include <libsettings/Path.h>
@@ -23,17 +25,35 @@ struct Message
     };
 
     Type type;
+
+    // Set on requests and copied into their response, zero otherwise.
+    uint32_t request = 0;
+
     Optional<Path> path;
     Optional<Json::Value> payload;
 };
 
-struct Protocol
+// Every message says whether its sender can read the binary encoding, the
+// first ones go out as text and we switch once the other end said it can.
+class Protocol
 {
+private:
+    bool _binary = false;
+    Json::BinaryWriter _writer;
+    Vector<char> _buffer;
+
+    Result encode_text(IO::Writer &writer, const Message &message);
+
+    Result encode_binary(IO::Writer &writer, const Message &message);
+
+public:
     using Message = Settings::Message;
 
-    static Result encode_message(IO::Connection &connection, const Message &message);
+    bool binary() { return _binary; }
+
+    Result encode_message(IO::Writer &writer, const Message &message);
 
-    static ResultOr<Message> decode_message(IO::Connection &connection);
+    ResultOr<Message> decode_message(IO::Reader &reader);
 };
 
 } // namespace Settings
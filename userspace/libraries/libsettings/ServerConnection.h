@@ -11,23 +11,16 @@ class ServerConnection : public IPC::Peer<Protocol>
 public:
     Callback<void(const Path &path, const Json::Value &value)> on_notify;
 
-    static OwnPtr<ServerConnection> open()
+    static OwnPtr<ServerConnection> open(bool shared = true)
     {
         auto connection = IO::Socket::connect("/Session/settings.ipc");
-        return own<ServerConnection>(connection.unwrap());
+        return own<ServerConnection>(connection.unwrap(), shared);
     }
 
-    ServerConnection(IO::Connection connection) : Peer{move(connection)}
+    ServerConnection(IO::Connection connection, bool shared = true) : Peer{move(connection), shared}
     {
     }
 
-    ResultOr<Message> request(Message message, Message::Type expected)
-    {
-        return send_and_wait_for(message, [&](const Message &incoming) {
-            return incoming.type == expected;
-        });
-    }
-
     void handle_message(const Message &message) override
     {
         if (message.type == Message::SERVER_NOTIFY)
@@ -65,7 +65,7 @@ void Service::register_watcher(Watcher &watcher)
         message.type = Message::CLIENT_WATCH;
         message.path = watcher.path();
 
-        server().request(message, Message::SERVER_ACK);
+        server().request(message, [](auto) {});
     }
 
     _watchers.push_back(&watcher);
@@ -82,10 +82,21 @@ void Service::unregister_watcher(Watcher &watcher)
         message.type = Message::CLIENT_UNWATCH;
         message.path = watcher.path();
 
-        server().request(message, Message::SERVER_ACK);
+        server().request(message, [](auto) {});
     }
 }
 
+static Optional<Json::Value> value_of(ResultOr<Message> &result_or_response)
+{
+    if (!result_or_response.success() ||
+        result_or_response.unwrap().type != Message::SERVER_VALUE)
+    {
+        return {};
+    }
+
+    return result_or_response.unwrap().payload;
+}
+
 Optional<Json::Value> Service::read(const Path path)
 {
     Message message;
@@ -93,14 +104,9 @@ Optional<Json::Value> Service::read(const Path path)
     message.type = Message::CLIENT_READ;
     message.path = path;
 
-    auto result_or_response = server().request(message, Message::SERVER_VALUE);
-
-    if (!result_or_response.success())
-    {
-        return {};
-    }
+    auto result_or_response = server().request_and_wait(message);
 
-    return result_or_response.unwrap().payload;
+    return value_of(result_or_response);
 }
 
 bool Service::write(const Path path, Json::Value value)
@@ -111,14 +117,15 @@ bool Service::write(const Path path, Json::Value value)
     message.path = path;
     message.payload = value;
 
-    auto result = server().request(message, Message::SERVER_ACK);
+    // The server only acknowledges writes, there is nothing to wait for.
+    auto result = server().request(message, [](auto) {});
 
-    if (result.success())
+    if (result == SUCCESS)
     {
         notify_watchers(path, value);
     }
 
-    return result.success();
+    return result == SUCCESS;
 }
 
 } // namespace Settings
\ No newline at end of file
@@ -45,7 +45,7 @@ public:
     {
         if (!_value.present())
         {
-            _value = _service->read(_path);
+            _value = _service->read(_path).unwrap_or(nullptr);
         }
 
         return _value.unwrap();
@@ -23,6 +23,11 @@ private:
         return _buckets[hash % BUCKET_COUNT];
     }
 
+    const Vector<Item> &bucket(uint32_t hash) const
+    {
+        return _buckets[hash % BUCKET_COUNT];
+    }
+
     Item *item_by_key(const TKey &key)
     {
         return item_by_key(key, hash<TKey>(key));
@@ -30,10 +35,15 @@ private:
 
     Item *item_by_key(const TKey &key, uint32_t hash)
     {
-        Item *result = nullptr;
+        return const_cast<Item *>(static_cast<const HashMap *>(this)->item_by_key(key, hash));
+    }
+
+    const Item *item_by_key(const TKey &key, uint32_t hash) const
+    {
+        const Item *result = nullptr;
         auto &b = bucket(hash);
 
-        b.foreach ([&](Item &item) {
+        b.foreach ([&](const Item &item) {
             if (item.hash == hash && item.key == key)
             {
                 result = &item;
@@ -81,7 +91,10 @@ public:
 
     void clear()
     {
-        _buckets.clear();
+        _buckets.foreach ([](auto &bucket) {
+            bucket.clear();
+            return Iteration::CONTINUE;
+        });
     }
 
     void remove_key(TKey &key)
@@ -109,6 +122,13 @@ public:
         return item_by_key(key) != nullptr;
     }
 
+    // The value of `key`, or nullptr if there is none.
+    const TValue *lookup(const TKey &key) const
+    {
+        auto *item = item_by_key(key, hash<TKey>(key));
+        return item ? &item->value : nullptr;
+    }
+
     bool has_value(const TValue &value)
     {
         bool result = false;
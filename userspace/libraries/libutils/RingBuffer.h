@@ -3,6 +3,7 @@
 #include <assert.h>
 #include <string.h>
 
+#include <libmath/MinMax.h>
 #include <libutils/Move.h>
 
 template <typename T>
@@ -29,7 +30,7 @@ public:
                                           _used(other._used)
     {
         _buffer = new T[other._size];
-        memcpy(_buffer, other._buffer, other._size);
+        memcpy(_buffer, other._buffer, other._size * sizeof(T));
     }
 
     RingBuffer(RingBuffer &&other)
@@ -83,6 +84,37 @@ public:
         return _used;
     }
 
+    size_t capacity() const
+    {
+        return _size;
+    }
+
+    // Change the capacity while keeping the content, this fails if the
+    // content doesn't fit in the new capacity.
+    bool resize(size_t size)
+    {
+        if (size < _used || size == 0)
+        {
+            return false;
+        }
+
+        T *buffer = new T[size];
+        size_t used = read(buffer, _used);
+
+        if (_buffer)
+        {
+            delete[] _buffer;
+        }
+
+        _buffer = buffer;
+        _size = size;
+        _used = used;
+        _head = used % size;
+        _tail = 0;
+
+        return true;
+    }
+
     void put(T c)
     {
         assert(!full());
@@ -96,7 +128,7 @@ public:
     {
         assert(!empty());
 
-        char c = _buffer[_tail];
+        T c = _buffer[_tail];
         _tail = (_tail + 1) % (_size);
         _used--;
 
@@ -112,27 +144,40 @@ public:
 
     size_t read(T *buffer, size_t size)
     {
-        size_t read = 0;
+        size_t read = MIN(size, _used);
 
-        while (!empty() && read < size)
+        if (read == 0)
         {
-            buffer[read] = get();
-            read++;
+            return 0;
         }
 
+        // The content wraps around the end of the buffer at most once.
+        size_t first = MIN(read, _size - _tail);
+        memcpy(buffer, _buffer + _tail, first * sizeof(T));
+        memcpy(buffer + first, _buffer, (read - first) * sizeof(T));
+
+        _tail = (_tail + read) % _size;
+        _used -= read;
+
         return read;
     }
 
     size_t write(const T *buffer, size_t size)
     {
-        size_t written = 0;
+        size_t written = MIN(size, _size - _used);
 
-        while (!full() && written < size)
+        if (written == 0)
         {
-            put(buffer[written]);
-            written++;
+            return 0;
         }
 
+        size_t first = MIN(written, _size - _head);
+        memcpy(_buffer + _head, buffer, first * sizeof(T));
+        memcpy(_buffer, buffer + first, (written - first) * sizeof(T));
+
+        _head = (_head + written) % _size;
+        _used += written;
+
         return written;
     }
 };
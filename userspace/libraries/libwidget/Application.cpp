@@ -4,6 +4,7 @@
 #include <libio/Format.h>
 #include <libio/Socket.h>
 #include <libio/Streams.h>
+#include <libmath/MinMax.h>
 #include <libsystem/process/Process.h>
 #include <libsystem/utils/Hexdump.h>
 #include <libwidget/Application.h>
@@ -53,25 +54,21 @@ Application::Application()
             }
         });
 
-    _connection = IO::Socket::connect("/Session/compositor.ipc").unwrap();
-
-    _connection_notifier = own<Async::Notifier>(_connection, POLL_READ, [this]() {
-        CompositorMessage message = {};
-        auto read_result = _connection.read(&message, sizeof(CompositorMessage));
+    _events_invoker = own<Async::Invoker>([this]() {
+        dispatch_pending_events();
+    });
 
-        if (!read_result.success())
-        {
-            IO::logln("Connection to the compositor closed {}!", read_result.description());
-            this->exit(PROCESS_FAILURE);
-        }
+    _connection = own<IPC::Channel>(IO::Socket::connect("/Session/compositor.ipc").unwrap());
 
-        size_t message_size = read_result.unwrap();
+    _connection->on_receive([this]() {
+        CompositorMessage message = {};
+        auto read_result = CompositorSchema::read(*_connection, message);
 
-        if (message_size != sizeof(CompositorMessage))
+        if (read_result != SUCCESS)
         {
-            IO::logln("Got a message with an invalid size from compositor {} != {}!", sizeof(CompositorMessage), message_size);
-            hexdump(&message, message_size);
+            IO::logln("Connection to the compositor closed {}!", get_result_description(read_result));
             this->exit(PROCESS_FAILURE);
+            return;
         }
 
         do_message(message);
@@ -93,19 +90,49 @@ Application::~Application() {}
 
 void Application::send_message(CompositorMessage message)
 {
-    _connection.write(&message, sizeof(message));
+    CompositorSchema::write(*_connection, message);
 }
 
 void Application::do_message(const CompositorMessage &message)
 {
     if (message.type == COMPOSITOR_MESSAGE_EVENT_WINDOW)
     {
-        Window *window = get_window(message.event_window.id);
+        // Dispatched once every message that arrived is read, so motions
+        // that piled up while we were busy are handled only once.
+        size_t count = MIN(message.event_window.count, WINDOW_EVENTS_MAX);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            auto &event = message.event_window.events[i];
+
+            if (!_pending_events.empty() &&
+                _pending_events.peek_back().window == message.event_window.id &&
+                event_coalesce(_pending_events.peek_back().event, event))
+            {
+                continue;
+            }
+
+            _pending_events.push_back({message.event_window.id, event});
+        }
+
+        _events_invoker->invoke_later();
+    }
+    else if (message.type == COMPOSITOR_MESSAGE_FRAME_DONE)
+    {
+        Window *window = get_window(message.frame_done.id);
 
         if (window)
         {
-            Event copy = message.event_window.event;
-            window->dispatch_event(&copy);
+            window->frame_done(message.frame_done.frame);
+        }
+    }
+    else if (message.type == COMPOSITOR_MESSAGE_MOUSE_POSITION)
+    {
+        // The compositor answers in order, so this is for the oldest request.
+        if (_mouse_position_requests.any())
+        {
+            auto callback = _mouse_position_requests.pop();
+            callback(message.mouse_position.position);
         }
     }
     else if (message.type == COMPOSITOR_MESSAGE_CHANGED_RESOLUTION)
@@ -132,26 +159,41 @@ void Application::do_message(const CompositorMessage &message)
     }
 }
 
+void Application::dispatch_pending_events()
+{
+    auto pending_events = move(_pending_events);
+
+    for (size_t i = 0; i < pending_events.count(); i++)
+    {
+        Window *window = get_window(pending_events[i].window);
+
+        if (window)
+        {
+            window->dispatch_event(&pending_events[i].event);
+        }
+    }
+}
+
 ResultOr<CompositorMessage> Application::wait_for_message(CompositorMessageType expected_message)
 {
     Vector<CompositorMessage> pendings;
 
     CompositorMessage message{};
-    TRY(_connection.read(&message, sizeof(message)));
+    TRY(CompositorSchema::read(*_connection, message));
 
     while (message.type != expected_message)
     {
         pendings.push_back(move(message));
-        auto result = _connection.read(&message, sizeof(CompositorMessage));
+        auto result = CompositorSchema::read(*_connection, message);
 
-        if (!result.success())
+        if (result != SUCCESS)
         {
             pendings.foreach ([&](auto &message) {
                 do_message(message);
                 return Iteration::CONTINUE;
             });
 
-            return result.result();
+            return result;
         }
     }
 
@@ -204,25 +246,32 @@ void Application::hide_window(Window *window)
     exit_if_all_windows_are_closed();
 }
 
-void Application::flip_window(Window *window, Math::Recti dirty)
+void Application::flip_window(Window *window, const Vector<Math::Recti> &dirty)
 {
     assert(_windows.contains(window));
+    assert(dirty.count() <= WINDOW_DIRTY_MAX);
 
     CompositorMessage message = {
         .type = COMPOSITOR_MESSAGE_FLIP_WINDOW,
         .flip_window = {
             .id = window->handle(),
+            .frame = window->frame(),
             .frontbuffer = window->frontbuffer_handle(),
             .frontbuffer_size = window->frontbuffer_size(),
-            .backbuffer = window->backbuffer_handle(),
-            .backbuffer_size = window->backbuffer_size(),
-            .dirty = dirty,
             .bound = window->bound_on_screen(),
+            .dirty_count = dirty.count(),
+            .dirty = {},
         },
     };
 
+    for (size_t i = 0; i < dirty.count(); i++)
+    {
+        message.flip_window.dirty[i] = dirty[i];
+    }
+
+    // Don't wait, the window is told with a frame done message once the
+    // compositor presented it.
     send_message(message);
-    wait_for_ack();
 }
 
 void Application::move_window(Window *window, Math::Vec2i position)
@@ -256,26 +305,40 @@ void Application::window_change_cursor(Window *window, CursorState state)
 }
 
 Math::Vec2i Application::mouse_position()
+{
+    Optional<Math::Vec2i> position;
+
+    mouse_position([&](Math::Vec2i new_position) {
+        position = new_position;
+    });
+
+    // Everything that comes before the answer is handled as usual instead
+    // of being held back until we got it.
+    while (!position.present())
+    {
+        CompositorMessage message{};
+
+        if (CompositorSchema::read(*_connection, message) != SUCCESS)
+        {
+            _mouse_position_requests.clear();
+            return Math::Vec2i::zero();
+        }
+
+        do_message(message);
+    }
+
+    return position.unwrap();
+}
+
+void Application::mouse_position(Callback<void(Math::Vec2i)> callback)
 {
     CompositorMessage message = {
         .type = COMPOSITOR_MESSAGE_GET_MOUSE_POSITION,
         .mouse_position = {},
     };
 
+    _mouse_position_requests.push_back(callback);
     send_message(message);
-
-    auto result_or_mouse_position = wait_for_message(COMPOSITOR_MESSAGE_MOUSE_POSITION);
-
-    if (result_or_mouse_position.success())
-    {
-        auto mouse_position = result_or_mouse_position.unwrap();
-
-        return mouse_position.mouse_position.position;
-    }
-    else
-    {
-        return Math::Vec2i::zero();
-    }
 }
 
 void Application::goodbye()
@@ -391,8 +454,7 @@ void Application::exit(int exit_value)
 
     goodbye();
 
-    _connection_notifier = nullptr;
-    _connection.close();
+    _connection->close();
 
     loop().exit(exit_value);
 }
@@ -1,8 +1,8 @@
 #pragma once
 
-#include <libasync/Notifier.h>
+#include <libasync/Invoker.h>
 #include <libasync/Source.h>
-#include <libio/Connection.h>
+#include <libipc/Channel.h>
 #include <libsettings/Setting.h>
 #include <libwidget/Window.h>
 
@@ -15,9 +15,17 @@ class Application :
     public Async::Source
 {
 private:
+    struct PendingEvent
+    {
+        int window;
+        Event event;
+    };
+
     Vector<Window *> _windows;
-    IO::Connection _connection;
-    OwnPtr<Async::Notifier> _connection_notifier;
+    Vector<PendingEvent> _pending_events;
+    Vector<Callback<void(Math::Vec2i)>> _mouse_position_requests;
+    OwnPtr<Async::Invoker> _events_invoker;
+    OwnPtr<IPC::Channel> _connection;
     OwnPtr<Settings::Setting> _setting_theme;
     OwnPtr<Settings::Setting> _setting_wireframe;
     bool _wireframe = false;
@@ -25,6 +33,7 @@ private:
 
     void send_message(CompositorMessage message);
     void do_message(const CompositorMessage &message);
+    void dispatch_pending_events();
     ResultOr<CompositorMessage> wait_for_message(CompositorMessageType expected_message);
     void hide_all_windows();
     void uninitialized();
@@ -45,7 +54,7 @@ public:
 
     void hide_window(Window *window);
 
-    void flip_window(Window *window, Math::Recti bound);
+    void flip_window(Window *window, const Vector<Math::Recti> &dirty);
 
     void move_window(Window *window, Math::Vec2i position);
 
@@ -53,6 +62,8 @@ public:
 
     Math::Vec2i mouse_position();
 
+    void mouse_position(Callback<void(Math::Vec2i)> callback);
+
     void add_window(Window *window);
 
     void remove_window(Window *window);
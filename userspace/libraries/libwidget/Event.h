@@ -49,6 +49,7 @@ struct Event
 
         WINDOW_CLOSING,
         WINDOW_RESIZED,
+        WINDOW_FRAME_DONE,
 
         WIDGET_DISABLE,
         WIDGET_ENABLE,
@@ -90,4 +91,31 @@ using EventHandler = Callback<void(Event *)>;
      ((::Widget::Event *)(__event))->type == ::Widget::Event::MOUSE_BUTTON_RELEASE || \
      ((::Widget::Event *)(__event))->type == ::Widget::Event::MOUSE_DOUBLE_CLICK)
 
+// Fold `event` into `previous` if it only continues a motion or a scroll,
+// returns false if it has to be delivered on its own.
+static inline bool event_coalesce(Event &previous, const Event &event)
+{
+    if (previous.type != event.type ||
+        previous.mouse.buttons != event.mouse.buttons)
+    {
+        return false;
+    }
+
+    if (event.type == Event::MOUSE_MOVE)
+    {
+        previous.mouse.position = event.mouse.position;
+        previous.mouse.position_on_screen = event.mouse.position_on_screen;
+        return true;
+    }
+
+    if (event.type == Event::MOUSE_SCROLL &&
+        previous.mouse.position == event.mouse.position)
+    {
+        previous.mouse.scroll += event.mouse.scroll;
+        return true;
+    }
+
+    return false;
+}
+
 } // namespace Widget
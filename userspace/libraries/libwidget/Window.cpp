@@ -10,6 +10,20 @@
 namespace Widget
 {
 
+static void merge_region(Vector<Math::Recti> &regions, Math::Recti region)
+{
+    for (size_t i = 0; i < regions.count(); i++)
+    {
+        if (regions[i].colide_with(region))
+        {
+            regions[i] = regions[i].merged_with(region);
+            return;
+        }
+    }
+
+    regions.push_back(region);
+}
+
 void Window::toggle_maximise()
 {
     if (_is_maximised == true)
@@ -67,8 +81,10 @@ Window::Window(WindowFlag flags)
 
     _flags = flags;
 
-    frontbuffer = Graphic::Bitmap::create_shared(250, 250).unwrap();
-    backbuffer = Graphic::Bitmap::create_shared(250, 250).unwrap();
+    for (auto &buffer : _buffers)
+    {
+        buffer.bitmap = Graphic::Bitmap::create_shared(250, 250).unwrap();
+    }
 
     _update_invoker = own<Async::Invoker>([this] { update(); });
 
@@ -115,16 +131,7 @@ void Window::should_repaint(Math::Recti rectangle)
 
     _update_invoker->invoke_later();
 
-    for (size_t i = 0; i < _dirty_paint.count(); i++)
-    {
-        if (_dirty_paint[i].colide_with(rectangle))
-        {
-            _dirty_paint[i] = _dirty_paint[i].merged_with(rectangle);
-            return;
-        }
-    }
-
-    _dirty_paint.push_back(rectangle);
+    merge_region(_dirty_paint, rectangle);
 }
 
 void Window::repaint(Graphic::Painter &painter, Math::Recti rectangle)
@@ -154,54 +161,137 @@ void Window::repaint(Graphic::Painter &painter, Math::Recti rectangle)
     painter.pop();
 }
 
-void Window::flip(Math::Recti region)
+void Window::flip()
 {
-    frontbuffer->copy_from(*backbuffer, region);
+    Vector<Math::Recti> dirty{};
+
+    _painted.foreach ([&](Math::Recti &rect) {
+        if (dirty.count() < WINDOW_DIRTY_MAX)
+        {
+            dirty.push_back(rect);
+        }
+        else
+        {
+            dirty[WINDOW_DIRTY_MAX - 1] = dirty[WINDOW_DIRTY_MAX - 1].merged_with(rect);
+        }
+
+        for (size_t i = 0; i < WINDOW_SWAPCHAIN_SIZE; i++)
+        {
+            if (i != _back)
+            {
+                merge_region(_buffers[i].outdated, rect);
+            }
+        }
+
+        return Iteration::CONTINUE;
+    });
+
+    _painted.clear();
 
-    swap(frontbuffer, backbuffer);
+    _latest = _back;
+    _frame++;
+    _frame_pending = true;
 
-    Application::the().flip_window(this, region);
+    // The compositor might still be showing the front buffer, so paint the
+    // next frame in the one which is neither shown nor waiting to be.
+    for (size_t i = 0; i < WINDOW_SWAPCHAIN_SIZE; i++)
+    {
+        if (i != _front && i != _latest)
+        {
+            _back = i;
+            break;
+        }
+    }
+
+    Application::the().flip_window(this, dirty);
 }
 
 void Window::update()
 {
+    // Stay at most one frame ahead of the compositor, the damage keeps
+    // piling up until the pending frame is presented.
+    if (_frame_pending && !_painted.empty())
+    {
+        return;
+    }
+
     if (_dirty_layout)
     {
         relayout();
     }
 
-    Math::Recti repaited_regions = Math::Recti::empty();
+    if (_dirty_paint.empty())
+    {
+        return;
+    }
+
+    auto &back = _buffers[_back];
+
+    back.outdated.foreach ([&](Math::Recti &rect) {
+        back.bitmap->copy_from(*_buffers[_latest].bitmap, rect);
+        return Iteration::CONTINUE;
+    });
 
-    Graphic::Painter painter{*backbuffer};
+    back.outdated.clear();
+
+    Graphic::Painter painter{*back.bitmap};
 
     _dirty_paint.foreach ([&](Math::Recti &rect) {
         repaint(painter, rect);
-
-        if (repaited_regions.is_empty())
-        {
-            repaited_regions = rect;
-        }
-        else
-        {
-            repaited_regions = rect.merged_with(repaited_regions);
-        }
+        merge_region(_painted, rect);
 
         return Iteration::CONTINUE;
     });
 
     _dirty_paint.clear();
 
-    flip(repaited_regions);
+    if (!_frame_pending)
+    {
+        flip();
+    }
+}
+
+void Window::frame_done(unsigned int frame)
+{
+    if (!_frame_pending || frame != _frame)
+    {
+        return;
+    }
+
+    _frame_pending = false;
+    _front = _latest;
+
+    if (!_painted.empty())
+    {
+        flip();
+    }
+
+    if (_dirty_layout || !_dirty_paint.empty())
+    {
+        _update_invoker->invoke_later();
+    }
+
+    Event event = {};
+    event.type = Event::WINDOW_FRAME_DONE;
+    dispatch_event(&event);
 }
 
 void Window::change_framebuffer_if_needed()
 {
+    auto &frontbuffer = _buffers[_front].bitmap;
+
     if (bound().width() > frontbuffer->width() ||
         bound().height() > frontbuffer->height() ||
         bound().area() < frontbuffer->bound().area() * 0.75)
     {
-        frontbuffer = Graphic::Bitmap::create_shared(bound().width(), bound().height()).unwrap();
-        backbuffer = Graphic::Bitmap::create_shared(bound().width(), bound().height()).unwrap();
+        // Everything gets repainted after this.
+        for (auto &buffer : _buffers)
+        {
+            buffer.bitmap = Graphic::Bitmap::create_shared(bound().width(), bound().height()).unwrap();
+            buffer.outdated.clear();
+        }
+
+        _painted.clear();
     }
 }
 
@@ -214,16 +304,32 @@ void Window::show()
 
     _visible = true;
 
+    // The compositor forgot about the frame pending when we were hidden.
+    _frame_pending = false;
+    _painted.clear();
+
     change_framebuffer_if_needed();
 
     relayout();
 
-    Graphic::Painter painter{*backbuffer};
+    auto &back = _buffers[_back];
+
+    Graphic::Painter painter{*back.bitmap};
     repaint(painter, bound());
 
-    frontbuffer->copy_from(*backbuffer, bound());
+    for (size_t i = 0; i < WINDOW_SWAPCHAIN_SIZE; i++)
+    {
+        _buffers[i].outdated.clear();
+
+        if (i != _back)
+        {
+            _buffers[i].outdated.push_back(bound());
+        }
+    }
 
-    swap(frontbuffer, backbuffer);
+    _front = _back;
+    _latest = _back;
+    _back = (_back + 1) % WINDOW_SWAPCHAIN_SIZE;
 
     Application::the().show_window(this);
 }
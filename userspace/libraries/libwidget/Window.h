@@ -42,11 +42,27 @@ private:
 
     CursorState cursor_state = CURSOR_DEFAULT;
 
-    RefPtr<Graphic::Bitmap> frontbuffer;
-    RefPtr<Graphic::Bitmap> backbuffer;
+    struct Buffer
+    {
+        RefPtr<Graphic::Bitmap> bitmap;
+
+        // Painted in the other buffers since this one was painted last.
+        Vector<Math::Recti> outdated;
+    };
+
+    // The compositor shows the front buffer while the latest flip waits for
+    // the next repaint, meanwhile the next frame is painted in the back buffer.
+    Buffer _buffers[WINDOW_SWAPCHAIN_SIZE];
+    size_t _front = 0;
+    size_t _back = 1;
+    size_t _latest = 0;
+
+    unsigned int _frame = 0;
+    bool _frame_pending = false;
 
     bool _dirty_layout;
     Vector<Math::Recti> _dirty_paint{};
+    Vector<Math::Recti> _painted{};
 
     EventHandler _handlers[EventType::__COUNT];
 
@@ -64,13 +80,15 @@ private:
 public:
     int handle() { return this->_handle; }
 
-    int frontbuffer_handle() const { return frontbuffer->handle(); }
+    int frontbuffer_handle() const { return _buffers[_latest].bitmap->handle(); }
+
+    Math::Vec2i frontbuffer_size() const { return _buffers[_latest].bitmap->size(); }
 
-    Math::Vec2i frontbuffer_size() const { return frontbuffer->size(); }
+    int backbuffer_handle() const { return _buffers[_back].bitmap->handle(); }
 
-    int backbuffer_handle() const { return backbuffer->handle(); }
+    Math::Vec2i backbuffer_size() const { return _buffers[_back].bitmap->size(); }
 
-    Math::Vec2i backbuffer_size() const { return backbuffer->size(); }
+    unsigned int frame() const { return _frame; }
 
     WindowFlag flags() { return _flags; }
 
@@ -182,10 +200,12 @@ public:
 
     void repaint(Graphic::Painter &painter, Math::Recti rectangle);
 
-    void flip(Math::Recti region);
+    void flip();
 
     void update();
 
+    void frame_done(unsigned int frame);
+
     void should_relayout();
 
     void should_repaint(Math::Recti rectangle);
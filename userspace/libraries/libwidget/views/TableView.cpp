@@ -162,7 +162,7 @@ void Table::paint(Graphic::Painter &painter, const Math::Recti &)
         }
     }
 
-    painter.acrylic(header_bound());
+    painter.acrylic(header_bound(), _header_cache);
     painter.fill_rectangle(header_bound(), color(THEME_BACKGROUND).with_alpha(0.5));
 
     for (int column = 0; column < column_count; column++)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <libgraphic/EffectCache.h>
 #include <libutils/String.h>
 
 #include <libwidget/Elements.h>
@@ -22,6 +23,10 @@ private:
 
     String _empty_message{"No data to display"};
 
+    // The acrylic under the header only has to be done again when what
+    // is under it changes.
+    Graphic::EffectCache _header_cache;
+
     Math::Recti scrollbar_bound() const;
     Math::Recti header_bound() const;
     Math::Recti list_bound() const;
@@ -0,0 +1,134 @@
+#include <libgraphic/Painter.h>
+#include <stdlib.h>
+
+#include "tests/Driver.h"
+
+static constexpr int FONT_TEST_GLYPH_WIDTH = 4;
+static constexpr int FONT_TEST_GLYPH_HEIGHT = 6;
+static constexpr int FONT_TEST_GLYPH_COUNT = 4;
+
+static constexpr Codepoint FONT_TEST_ASTRAL = 0x1F600;
+
+struct FontTestFont
+{
+    Graphic::Color pixels[FONT_TEST_GLYPH_WIDTH * FONT_TEST_GLYPH_COUNT * FONT_TEST_GLYPH_HEIGHT];
+    RefPtr<Graphic::Font> font;
+
+    FontTestFont()
+    {
+        int width = FONT_TEST_GLYPH_WIDTH * FONT_TEST_GLYPH_COUNT;
+
+        for (int y = 0; y < FONT_TEST_GLYPH_HEIGHT; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                uint8_t value = (x * 61 + y * 37) & 0xff;
+                pixels[y * width + x] = Graphic::Color::from_rgb_byte(value, value, value);
+            }
+        }
+
+        auto bitmap = Graphic::Bitmap::create_static(width, FONT_TEST_GLYPH_HEIGHT, pixels);
+
+        Vector<Graphic::Glyph> glyphs;
+
+        auto add = [&](Codepoint codepoint, int index) {
+            glyphs.push_back({
+                codepoint,
+                {index * FONT_TEST_GLYPH_WIDTH, 0, FONT_TEST_GLYPH_WIDTH, FONT_TEST_GLYPH_HEIGHT},
+                {0, FONT_TEST_GLYPH_HEIGHT - 1},
+                FONT_TEST_GLYPH_WIDTH + 1,
+            });
+        };
+
+        add(U'A', 0);
+        add(U'?', 1);
+        add(0x3A9, 2);
+        add(FONT_TEST_ASTRAL, 3);
+        glyphs.push_back({});
+
+        font = make<Graphic::Font>(bitmap, glyphs);
+    }
+};
+
+TEST(font_finds_glyphs_by_codepoint)
+{
+    FontTestFont test;
+    auto &font = *test.font;
+
+    Assert::is_true(font.has(U'A'));
+    Assert::is_true(font.has(0x3A9));
+    Assert::is_true(font.has(FONT_TEST_ASTRAL));
+    Assert::is_false(font.has(U'B'));
+    Assert::is_false(font.has(0x3AA));
+    Assert::is_false(font.has(FONT_TEST_ASTRAL + 1));
+
+    Assert::equal(font.glyph(U'A').bound.x(), 0);
+    Assert::equal(font.glyph(0x3A9).bound.x(), 2 * FONT_TEST_GLYPH_WIDTH);
+    Assert::equal(font.glyph(FONT_TEST_ASTRAL).bound.x(), 3 * FONT_TEST_GLYPH_WIDTH);
+
+    // Anything else is drawn as a question mark.
+    Assert::equal(font.glyph(U'B').codepoint, U'?');
+    Assert::not_null(font.coverage(font.glyph(U'B')));
+}
+
+TEST(painter_draws_text_runs_like_blending_each_pixel)
+{
+    FontTestFont test;
+    auto &font = *test.font;
+
+    constexpr int WIDTH = 32;
+    constexpr int HEIGHT = 10;
+
+    Graphic::Color pixels[WIDTH * HEIGHT];
+    Graphic::Color expected[WIDTH * HEIGHT];
+
+    for (int i = 0; i < WIDTH * HEIGHT; i++)
+    {
+        pixels[i] = Graphic::Color::from_rgb_byte(i * 3, 80, 160);
+        expected[i] = pixels[i];
+    }
+
+    auto bitmap = Graphic::Bitmap::create_static(WIDTH, HEIGHT, pixels);
+    auto reference = Graphic::Bitmap::create_static(WIDTH, HEIGHT, expected);
+
+    // Cuts through the second glyph and the top row of all of them.
+    Math::Recti clip{0, 3, 7, 6};
+    Math::Vec2i position{1, 8};
+    auto color = Graphic::Color::from_rgba_byte(250, 20, 40, 200);
+
+    Codepoint text[] = {U'A', U'B', FONT_TEST_ASTRAL};
+
+    Graphic::Painter painter{*bitmap};
+    painter.clip(clip);
+    auto end = painter.draw_text_run(font, text, 3, position, color);
+
+    Assert::equal(end.x(), position.x() + 3 * (FONT_TEST_GLYPH_WIDTH + 1));
+
+    for (auto codepoint : text)
+    {
+        auto &glyph = font.glyph(codepoint);
+
+        for (int y = 0; y < glyph.bound.height(); y++)
+        {
+            for (int x = 0; x < glyph.bound.width(); x++)
+            {
+                Math::Vec2i pixel = position - glyph.origin + Math::Vec2i{x, y};
+
+                if (clip.contains(pixel))
+                {
+                    auto coverage = font.bitmap().get_pixel(glyph.bound.position() + Math::Vec2i{x, y}).red();
+                    reference->blend_pixel(pixel, color.with_alpha_byte(Graphic::Color::div255(color.alpha() * coverage)));
+                }
+            }
+        }
+
+        position = position + Math::Vec2i{glyph.advance, 0};
+    }
+
+    for (int i = 0; i < WIDTH * HEIGHT; i++)
+    {
+        Assert::lower_equal(abs(pixels[i].red() - expected[i].red()), 1);
+        Assert::lower_equal(abs(pixels[i].green() - expected[i].green()), 1);
+        Assert::lower_equal(abs(pixels[i].blue() - expected[i].blue()), 1);
+    }
+}
@@ -0,0 +1,89 @@
+#include <libgraphic/Painter.h>
+#include <string.h>
+
+#include "tests/Driver.h"
+
+static constexpr int PAINTER_TEST_WIDTH = 120;
+static constexpr int PAINTER_TEST_HEIGHT = 80;
+
+static constexpr int PAINTER_TEST_SOURCE_SIZE = 37;
+
+struct PainterTestCanvas
+{
+    Vector<Graphic::Color> pixels;
+    RefPtr<Graphic::Bitmap> bitmap;
+
+    PainterTestCanvas()
+    {
+        pixels.resize(PAINTER_TEST_WIDTH * PAINTER_TEST_HEIGHT);
+        bitmap = Graphic::Bitmap::create_static(PAINTER_TEST_WIDTH, PAINTER_TEST_HEIGHT, pixels.raw_storage());
+        Graphic::Painter{*bitmap}.clear(Graphic::Colors::WHITE);
+    }
+
+    bool same_as(PainterTestCanvas &other)
+    {
+        return memcmp(pixels.raw_storage(), other.pixels.raw_storage(), PAINTER_TEST_WIDTH * PAINTER_TEST_HEIGHT * sizeof(Graphic::Color)) == 0;
+    }
+};
+
+TEST(painter_blit_scaled_samples_the_same_however_clipped)
+{
+    Vector<Graphic::Color> source_pixels;
+    source_pixels.resize(PAINTER_TEST_SOURCE_SIZE * PAINTER_TEST_SOURCE_SIZE);
+
+    for (int y = 0; y < PAINTER_TEST_SOURCE_SIZE; y++)
+    {
+        for (int x = 0; x < PAINTER_TEST_SOURCE_SIZE; x++)
+        {
+            source_pixels[y * PAINTER_TEST_SOURCE_SIZE + x] = Graphic::Color::from_rgb_byte(x * 7, y * 7, (x + y) * 3);
+        }
+    }
+
+    auto source = Graphic::Bitmap::create_static(PAINTER_TEST_SOURCE_SIZE, PAINTER_TEST_SOURCE_SIZE, source_pixels.raw_storage());
+
+    Math::Recti clip{30, 20, 40, 25};
+    Math::Recti destination{3, 4, 90, 70};
+
+    PainterTestCanvas whole;
+    Graphic::Painter whole_painter{*whole.bitmap};
+    whole_painter.blit(*source, source->bound(), destination);
+
+    PainterTestCanvas clipped;
+    Graphic::Painter clipped_painter{*clipped.bitmap};
+    clipped_painter.push();
+    clipped_painter.transform({2, 1});
+    clipped_painter.clip(clip.offset({-2, -1}));
+    clipped_painter.blit(*source, source->bound(), destination.offset({-2, -1}));
+    clipped_painter.pop();
+
+    for (int y = clip.top(); y < clip.bottom(); y++)
+    {
+        for (int x = clip.left(); x < clip.right(); x++)
+        {
+            auto expected = whole.pixels[y * PAINTER_TEST_WIDTH + x];
+            auto actual = clipped.pixels[y * PAINTER_TEST_WIDTH + x];
+
+            Assert::equal(actual.red(), expected.red());
+            Assert::equal(actual.green(), expected.green());
+            Assert::equal(actual.blue(), expected.blue());
+        }
+    }
+}
+
+TEST(painter_fills_paths_at_the_origin_once)
+{
+    auto path = Graphic::Path::parse("M12,2A10,10 0 1,1 2,12A10,10 0 0,1 12,2M12,6L6,18H18Z");
+
+    PainterTestCanvas moved;
+    Graphic::Painter moved_painter{*moved.bitmap};
+    moved_painter.fill(path, Math::Mat3x2f::scale(3) * Math::Mat3x2f::translation({20, 10}), Graphic::Fill{Graphic::Colors::BLUE});
+
+    PainterTestCanvas transformed;
+    Graphic::Painter transformed_painter{*transformed.bitmap};
+    transformed_painter.push();
+    transformed_painter.transform({20, 10});
+    transformed_painter.fill(path, Math::Mat3x2f::scale(3), Graphic::Fill{Graphic::Colors::BLUE});
+    transformed_painter.pop();
+
+    Assert::is_true(moved.same_as(transformed));
+}
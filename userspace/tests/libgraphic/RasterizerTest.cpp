@@ -0,0 +1,186 @@
+#include <libgraphic/rast/Rasterizer.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tests/Driver.h"
+
+static constexpr int RASTERIZER_TEST_SIZE = 16;
+
+static constexpr auto RASTERIZER_TEST_BACKGROUND = Graphic::Color::from_rgb_byte(0, 0, 0);
+static constexpr auto RASTERIZER_TEST_COLOR = Graphic::Color::from_rgb_byte(255, 255, 255);
+
+static uint32_t packed(Graphic::Color color)
+{
+    uint32_t value;
+    memcpy(&value, &color, sizeof(value));
+    return value;
+}
+
+static void add_rectangle(Graphic::EdgeList &edges, float left, float top, float right, float bottom)
+{
+    edges.begin();
+    edges.append(Math::Vec2f{left, top});
+    edges.append(Math::Vec2f{right, top});
+    edges.append(Math::Vec2f{right, bottom});
+    edges.append(Math::Vec2f{left, bottom});
+    edges.append(Math::Vec2f{left, top});
+    edges.end();
+}
+
+struct RasterizerTestCanvas
+{
+    Graphic::Color pixels[RASTERIZER_TEST_SIZE * RASTERIZER_TEST_SIZE];
+    RefPtr<Graphic::Bitmap> bitmap;
+    Graphic::TransformStack stack{Math::Recti{RASTERIZER_TEST_SIZE, RASTERIZER_TEST_SIZE}};
+
+    RasterizerTestCanvas()
+    {
+        for (auto &pixel : pixels)
+        {
+            pixel = RASTERIZER_TEST_BACKGROUND;
+        }
+
+        bitmap = Graphic::Bitmap::create_static(RASTERIZER_TEST_SIZE, RASTERIZER_TEST_SIZE, pixels);
+    }
+
+    void fill(const Graphic::EdgeList &edges,
+              Graphic::FillRule rule = Graphic::FillRule::NONZERO,
+              Graphic::Paint paint = Graphic::Fill{RASTERIZER_TEST_COLOR})
+    {
+        Graphic::Rasterizer rasterizer{*bitmap, stack};
+        rasterizer.fill(edges, Math::Mat3x2f::identity(), paint, rule);
+    }
+
+    Graphic::Color at(int x, int y)
+    {
+        return pixels[y * RASTERIZER_TEST_SIZE + x];
+    }
+};
+
+TEST(rasterizer_fills_pixel_aligned_rectangles_exactly)
+{
+    RasterizerTestCanvas canvas;
+
+    Graphic::EdgeList edges;
+    add_rectangle(edges, 2, 3, 10, 7);
+    canvas.fill(edges);
+
+    for (int y = 0; y < RASTERIZER_TEST_SIZE; y++)
+    {
+        for (int x = 0; x < RASTERIZER_TEST_SIZE; x++)
+        {
+            bool inside = x >= 2 && x < 10 && y >= 3 && y < 7;
+            auto expected = inside ? RASTERIZER_TEST_COLOR : RASTERIZER_TEST_BACKGROUND;
+
+            Assert::equal(packed(canvas.at(x, y)), packed(expected));
+        }
+    }
+}
+
+TEST(rasterizer_covers_partial_pixels)
+{
+    RasterizerTestCanvas canvas;
+
+    Graphic::EdgeList edges;
+    add_rectangle(edges, 2.25, 4, 5.5, 8);
+    canvas.fill(edges);
+
+    // Coverage along a row is exact, only rounding to a byte is lost.
+    Assert::lower_equal(abs(canvas.at(2, 5).red() - 191), 1);
+    Assert::equal(canvas.at(3, 5).red(), 255);
+    Assert::equal(canvas.at(4, 5).red(), 255);
+    Assert::lower_equal(abs(canvas.at(5, 5).red() - 128), 1);
+    Assert::equal(canvas.at(6, 5).red(), 0);
+}
+
+TEST(rasterizer_leaves_holes_with_even_odd)
+{
+    RasterizerTestCanvas canvas;
+
+    Graphic::EdgeList edges;
+    add_rectangle(edges, 1, 1, 15, 15);
+    add_rectangle(edges, 5, 5, 11, 11);
+    canvas.fill(edges, Graphic::FillRule::EVENODD);
+
+    Assert::equal(packed(canvas.at(2, 2)), packed(RASTERIZER_TEST_COLOR));
+    Assert::equal(packed(canvas.at(8, 8)), packed(RASTERIZER_TEST_BACKGROUND));
+    Assert::equal(packed(canvas.at(12, 12)), packed(RASTERIZER_TEST_COLOR));
+}
+
+TEST(rasterizer_follows_the_winding_with_nonzero)
+{
+    // Both going the same way, the inner one is filled.
+    RasterizerTestCanvas same;
+
+    Graphic::EdgeList same_edges;
+    add_rectangle(same_edges, 1, 1, 15, 15);
+    add_rectangle(same_edges, 5, 5, 11, 11);
+    same.fill(same_edges, Graphic::FillRule::NONZERO);
+
+    Assert::equal(packed(same.at(2, 2)), packed(RASTERIZER_TEST_COLOR));
+    Assert::equal(packed(same.at(8, 8)), packed(RASTERIZER_TEST_COLOR));
+
+    // Going the other way, it's a hole.
+    RasterizerTestCanvas opposite;
+
+    Graphic::EdgeList opposite_edges;
+    add_rectangle(opposite_edges, 1, 1, 15, 15);
+    add_rectangle(opposite_edges, 11, 5, 5, 11);
+    opposite.fill(opposite_edges, Graphic::FillRule::NONZERO);
+
+    Assert::equal(packed(opposite.at(2, 2)), packed(RASTERIZER_TEST_COLOR));
+    Assert::equal(packed(opposite.at(8, 8)), packed(RASTERIZER_TEST_BACKGROUND));
+}
+
+TEST(rasterizer_shades_gradients_along_the_bound)
+{
+    RasterizerTestCanvas canvas;
+
+    Graphic::Gradient gradient{};
+    gradient.stops[0] = {RASTERIZER_TEST_BACKGROUND, 0};
+    gradient.stops[1] = {RASTERIZER_TEST_COLOR, 1};
+    gradient.count = 2;
+
+    Graphic::EdgeList edges;
+    add_rectangle(edges, 0, 0, 16, 16);
+    canvas.fill(edges, Graphic::FillRule::NONZERO, gradient);
+
+    for (int x = 0; x < RASTERIZER_TEST_SIZE; x++)
+    {
+        // Pixels are sampled at their center.
+        int expected = (x + 0.5f) / RASTERIZER_TEST_SIZE * 255;
+
+        Assert::lower_equal(abs(canvas.at(x, 3).red() - expected), 2);
+        Assert::equal(packed(canvas.at(x, 3)), packed(canvas.at(x, 12)));
+    }
+
+    RasterizerTestCanvas radial;
+    gradient.shape = Graphic::GradientShape::RADIAL;
+    radial.fill(edges, Graphic::FillRule::NONZERO, gradient);
+
+    Assert::lower_equal(radial.at(7, 7).red(), 32);
+    Assert::equal(packed(radial.at(7, 7)), packed(radial.at(8, 8)));
+    Assert::equal(packed(radial.at(0, 7)), packed(radial.at(15, 8)));
+    Assert::greater_equal(radial.at(0, 7).red(), 224);
+}
+
+TEST(rasterizer_stays_within_the_clip)
+{
+    RasterizerTestCanvas canvas;
+    canvas.stack.clip(Math::Recti{4, 4, 4, 4});
+
+    Graphic::EdgeList edges;
+    add_rectangle(edges, -8, -8, 24, 24);
+    canvas.fill(edges);
+
+    for (int y = 0; y < RASTERIZER_TEST_SIZE; y++)
+    {
+        for (int x = 0; x < RASTERIZER_TEST_SIZE; x++)
+        {
+            bool inside = x >= 4 && x < 8 && y >= 4 && y < 8;
+            auto expected = inside ? RASTERIZER_TEST_COLOR : RASTERIZER_TEST_BACKGROUND;
+
+            Assert::equal(packed(canvas.at(x, y)), packed(expected));
+        }
+    }
+}
@@ -0,0 +1,376 @@
+#include <libgraphic/Spans.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tests/Driver.h"
+
+static constexpr size_t SPAN_TEST_LENGTH = 77;
+
+static const Graphic::SpanIsa SPAN_TEST_ISAS[] = {
+    Graphic::SpanIsa::SCALAR,
+    Graphic::SpanIsa::SSE2,
+    Graphic::SpanIsa::AVX2,
+};
+
+static uint32_t packed(Graphic::Color color)
+{
+    uint32_t value;
+    memcpy(&value, &color, sizeof(value));
+    return value;
+}
+
+static uint32_t next_random(uint32_t &state)
+{
+    state = state * 1664525 + 1013904223;
+    return state >> 8;
+}
+
+// Runs of opaque, transparent and translucent pixels so every kernel goes
+// through its fast paths as well as the general one.
+static void fill_test_pixels(Graphic::Color *pixels, uint32_t seed, bool opaque)
+{
+    uint32_t state = seed;
+
+    for (size_t i = 0; i < SPAN_TEST_LENGTH; i++)
+    {
+        uint8_t alpha = next_random(state);
+
+        if (opaque || (i / 8) % 3 == 0)
+        {
+            alpha = 0xff;
+        }
+        else if ((i / 8) % 3 == 1)
+        {
+            alpha = 0;
+        }
+
+        pixels[i] = Graphic::Color::from_rgba_byte(next_random(state), next_random(state), next_random(state), alpha);
+    }
+}
+
+static void premultiply(Graphic::Color *pixels)
+{
+    for (size_t i = 0; i < SPAN_TEST_LENGTH; i++)
+    {
+        auto color = pixels[i];
+
+        pixels[i] = Graphic::Color::from_rgba_byte(
+            color.red() * color.alpha() / 255,
+            color.green() * color.alpha() / 255,
+            color.blue() * color.alpha() / 255,
+            color.alpha());
+    }
+}
+
+TEST(spans_blend_matches_color_blend)
+{
+    for (auto isa : SPAN_TEST_ISAS)
+    {
+        auto *kernels = Graphic::span_kernels(isa);
+
+        if (kernels == nullptr)
+        {
+            continue;
+        }
+
+        for (bool opaque : {true, false})
+        {
+            Graphic::Color source[SPAN_TEST_LENGTH];
+            Graphic::Color destination[SPAN_TEST_LENGTH];
+
+            fill_test_pixels(source, 1, false);
+            fill_test_pixels(destination, 2, opaque);
+
+            Graphic::Color expected[SPAN_TEST_LENGTH];
+
+            for (size_t i = 0; i < SPAN_TEST_LENGTH; i++)
+            {
+                expected[i] = Graphic::Color::blend(source[i], destination[i]);
+            }
+
+            kernels->blend(destination, source, SPAN_TEST_LENGTH);
+
+            for (size_t i = 0; i < SPAN_TEST_LENGTH; i++)
+            {
+                Assert::equal(packed(destination[i]), packed(expected[i]));
+            }
+        }
+    }
+}
+
+TEST(spans_blend_color_matches_color_blend)
+{
+    for (auto isa : SPAN_TEST_ISAS)
+    {
+        auto *kernels = Graphic::span_kernels(isa);
+
+        if (kernels == nullptr)
+        {
+            continue;
+        }
+
+        for (uint8_t alpha : {0, 1, 127, 200, 254, 255})
+        {
+            auto color = Graphic::Color::from_rgba_byte(200, 100, 50, alpha);
+
+            Graphic::Color destination[SPAN_TEST_LENGTH];
+            fill_test_pixels(destination, 3, false);
+
+            Graphic::Color expected[SPAN_TEST_LENGTH];
+
+            for (size_t i = 0; i < SPAN_TEST_LENGTH; i++)
+            {
+                expected[i] = Graphic::Color::blend(color, destination[i]);
+            }
+
+            kernels->blend_color(destination, color, SPAN_TEST_LENGTH);
+
+            for (size_t i = 0; i < SPAN_TEST_LENGTH; i++)
+            {
+                Assert::equal(packed(destination[i]), packed(expected[i]));
+            }
+        }
+    }
+}
+
+TEST(spans_blend_premultiplied_agree)
+{
+    auto *scalar = Graphic::span_kernels(Graphic::SpanIsa::SCALAR);
+
+    Graphic::Color source[SPAN_TEST_LENGTH];
+    fill_test_pixels(source, 4, false);
+    premultiply(source);
+
+    Graphic::Color background[SPAN_TEST_LENGTH];
+    fill_test_pixels(background, 5, false);
+    premultiply(background);
+
+    Graphic::Color expected[SPAN_TEST_LENGTH];
+    memcpy(expected, background, sizeof(expected));
+    scalar->blend_premultiplied(expected, source, SPAN_TEST_LENGTH);
+
+    for (auto isa : SPAN_TEST_ISAS)
+    {
+        auto *kernels = Graphic::span_kernels(isa);
+
+        if (kernels == nullptr)
+        {
+            continue;
+        }
+
+        Graphic::Color destination[SPAN_TEST_LENGTH];
+        memcpy(destination, background, sizeof(destination));
+
+        kernels->blend_premultiplied(destination, source, SPAN_TEST_LENGTH);
+
+        for (size_t i = 0; i < SPAN_TEST_LENGTH; i++)
+        {
+            Assert::equal(packed(destination[i]), packed(expected[i]));
+        }
+    }
+}
+
+TEST(spans_copy_and_fill_stay_within_the_span)
+{
+    auto sentinel = Graphic::Color::from_rgba_byte(1, 2, 3, 4);
+    auto color = Graphic::Color::from_rgba_byte(5, 6, 7, 8);
+
+    for (auto isa : SPAN_TEST_ISAS)
+    {
+        auto *kernels = Graphic::span_kernels(isa);
+
+        if (kernels == nullptr)
+        {
+            continue;
+        }
+
+        for (size_t count = 0; count < SPAN_TEST_LENGTH; count++)
+        {
+            Graphic::Color source[SPAN_TEST_LENGTH];
+            fill_test_pixels(source, count, false);
+
+            Graphic::Color destination[SPAN_TEST_LENGTH + 1];
+            destination[count] = sentinel;
+
+            kernels->copy(destination, source, count);
+
+            Assert::equal(memcmp(destination, source, count * sizeof(Graphic::Color)), 0);
+            Assert::equal(packed(destination[count]), packed(sentinel));
+
+            kernels->fill(destination, color, count);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Assert::equal(packed(destination[i]), packed(color));
+            }
+
+            Assert::equal(packed(destination[count]), packed(sentinel));
+        }
+    }
+}
+
+TEST(spans_blend_color_premultiplied_matches_color_blend_premultiplied)
+{
+    for (auto isa : SPAN_TEST_ISAS)
+    {
+        auto *kernels = Graphic::span_kernels(isa);
+
+        if (kernels == nullptr)
+        {
+            continue;
+        }
+
+        for (uint8_t alpha : {0, 1, 127, 200, 254, 255})
+        {
+            auto color = Graphic::Color::from_rgba_byte(200, 100, 50, alpha).premultiplied();
+
+            Graphic::Color destination[SPAN_TEST_LENGTH];
+            fill_test_pixels(destination, 6, false);
+            premultiply(destination);
+
+            Graphic::Color expected[SPAN_TEST_LENGTH];
+
+            for (size_t i = 0; i < SPAN_TEST_LENGTH; i++)
+            {
+                expected[i] = Graphic::Color::blend_premultiplied(color, destination[i]);
+            }
+
+            kernels->blend_color_premultiplied(destination, color, SPAN_TEST_LENGTH);
+
+            for (size_t i = 0; i < SPAN_TEST_LENGTH; i++)
+            {
+                Assert::equal(packed(destination[i]), packed(expected[i]));
+            }
+        }
+    }
+}
+
+TEST(spans_blend_mask_premultiplied_agree)
+{
+    auto *scalar = Graphic::span_kernels(Graphic::SpanIsa::SCALAR);
+
+    Graphic::Color background[SPAN_TEST_LENGTH];
+    fill_test_pixels(background, 7, false);
+    premultiply(background);
+
+    // Runs of empty and full coverage next to partial ones.
+    uint8_t mask[SPAN_TEST_LENGTH];
+    uint32_t state = 8;
+
+    for (size_t i = 0; i < SPAN_TEST_LENGTH; i++)
+    {
+        mask[i] = (i / 8) % 3 == 0 ? 0 : (i / 8) % 3 == 1 ? 255 : next_random(state);
+    }
+
+    for (uint8_t alpha : {0, 1, 127, 255})
+    {
+        auto color = Graphic::Color::from_rgba_byte(200, 100, 50, alpha).premultiplied();
+
+        Graphic::Color expected[SPAN_TEST_LENGTH];
+        memcpy(expected, background, sizeof(expected));
+        scalar->blend_mask_premultiplied(expected, color, mask, SPAN_TEST_LENGTH);
+
+        for (size_t i = 0; i < SPAN_TEST_LENGTH; i++)
+        {
+            if (mask[i] == 255)
+            {
+                Assert::equal(packed(expected[i]), packed(Graphic::Color::blend_premultiplied(color, background[i])));
+            }
+            else if (mask[i] == 0)
+            {
+                Assert::equal(packed(expected[i]), packed(background[i]));
+            }
+        }
+
+        for (auto isa : SPAN_TEST_ISAS)
+        {
+            auto *kernels = Graphic::span_kernels(isa);
+
+            if (kernels == nullptr)
+            {
+                continue;
+            }
+
+            Graphic::Color destination[SPAN_TEST_LENGTH];
+            memcpy(destination, background, sizeof(destination));
+
+            kernels->blend_mask_premultiplied(destination, color, mask, SPAN_TEST_LENGTH);
+
+            for (size_t i = 0; i < SPAN_TEST_LENGTH; i++)
+            {
+                Assert::equal(packed(destination[i]), packed(expected[i]));
+            }
+        }
+    }
+}
+
+TEST(spans_premultiplied_blending_matches_straight_blending)
+{
+    auto background = Graphic::Color::from_rgba_byte(10, 200, 30, 255);
+
+    for (unsigned alpha = 0; alpha <= 255; alpha += 15)
+    {
+        auto color = Graphic::Color::from_rgba_byte(250, 128, 3, alpha);
+
+        auto straight = Graphic::Color::blend(color, background);
+        auto premultiplied = Graphic::Color::blend_premultiplied(color.premultiplied(), background);
+
+        // Both round differently, but not by much.
+        Assert::lower_equal(abs(straight.red() - premultiplied.red()), 2);
+        Assert::lower_equal(abs(straight.green() - premultiplied.green()), 2);
+        Assert::lower_equal(abs(straight.blue() - premultiplied.blue()), 2);
+        Assert::equal(premultiplied.alpha(), 255);
+    }
+}
+
+TEST(spans_premultiply_round_trips)
+{
+    for (unsigned alpha = 1; alpha <= 255; alpha += 2)
+    {
+        auto color = Graphic::Color::from_rgba_byte(255, 128, 0, alpha);
+        auto round_trip = color.premultiplied().unpremultiplied();
+
+        Assert::equal(round_trip.alpha(), alpha);
+        Assert::equal(round_trip.blue(), 0);
+        Assert::equal(round_trip.red(), 255);
+
+        // Precision goes away as alpha gets small.
+        Assert::lower_equal(abs(round_trip.green() - 128), 255 / alpha + 1);
+    }
+
+    Assert::equal(packed(Graphic::Color::from_rgba_byte(1, 2, 3, 0).premultiplied()), 0u);
+}
+
+TEST(spans_swizzle_swaps_red_and_blue)
+{
+    for (auto isa : SPAN_TEST_ISAS)
+    {
+        auto *kernels = Graphic::span_kernels(isa);
+
+        if (kernels == nullptr)
+        {
+            continue;
+        }
+
+        for (size_t count = 0; count < SPAN_TEST_LENGTH; count++)
+        {
+            Graphic::Color source[SPAN_TEST_LENGTH];
+            fill_test_pixels(source, count, false);
+
+            uint32_t destination[SPAN_TEST_LENGTH + 1];
+            destination[count] = 0xdeadbeef;
+
+            kernels->swizzle(destination, source, count);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                auto color = source[i];
+                uint32_t expected = color.blue() | (color.green() << 8) | (color.red() << 16) | (color.alpha() << 24);
+
+                Assert::equal(destination[i], expected);
+            }
+
+            Assert::equal(destination[count], 0xdeadbeefu);
+        }
+    }
+}
@@ -0,0 +1,166 @@
+#include <libgraphic/EffectCache.h>
+#include <libgraphic/StackBlur.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tests/Driver.h"
+
+static constexpr int BLUR_TEST_WIDTH = 37;
+static constexpr int BLUR_TEST_HEIGHT = 29;
+static constexpr int BLUR_TEST_PIXELS = BLUR_TEST_WIDTH * BLUR_TEST_HEIGHT;
+
+static const Graphic::SpanIsa BLUR_TEST_ISAS[] = {
+    Graphic::SpanIsa::SSE2,
+    Graphic::SpanIsa::AVX2,
+};
+
+static uint32_t next_random(uint32_t &state)
+{
+    state = state * 1664525 + 1013904223;
+    return state >> 8;
+}
+
+static void fill_blur_pixels(Graphic::Color *pixels, uint32_t seed)
+{
+    uint32_t state = seed;
+
+    for (int i = 0; i < BLUR_TEST_PIXELS; i++)
+    {
+        pixels[i] = Graphic::Color::from_rgba_byte(
+                        next_random(state),
+                        next_random(state),
+                        next_random(state),
+                        next_random(state))
+                        .premultiplied();
+    }
+}
+
+static void blur(Graphic::Color *pixels, unsigned radius, Math::Recti region, Graphic::SpanIsa isa)
+{
+    Graphic::stackblur(
+        (unsigned char *)pixels,
+        BLUR_TEST_WIDTH, BLUR_TEST_HEIGHT,
+        radius,
+        region.left(), region.right(),
+        region.top(), region.bottom(),
+        isa);
+}
+
+TEST(stackblur_vectorized_matches_scalar)
+{
+    uint32_t state = 7;
+
+    for (int round = 0; round < 64; round++)
+    {
+        unsigned radius = next_random(state) % 48;
+
+        // Odd sizes so some lines don't make a group of four.
+        int x = next_random(state) % BLUR_TEST_WIDTH;
+        int y = next_random(state) % BLUR_TEST_HEIGHT;
+        int width = next_random(state) % (BLUR_TEST_WIDTH - x) + 1;
+        int height = next_random(state) % (BLUR_TEST_HEIGHT - y) + 1;
+        Math::Recti region{x, y, width, height};
+
+        Graphic::Color expected[BLUR_TEST_PIXELS];
+        fill_blur_pixels(expected, round);
+        blur(expected, radius, region, Graphic::SpanIsa::SCALAR);
+
+        for (auto isa : BLUR_TEST_ISAS)
+        {
+            Graphic::Color pixels[BLUR_TEST_PIXELS];
+            fill_blur_pixels(pixels, round);
+            blur(pixels, radius, region, isa);
+
+            Assert::equal(memcmp(pixels, expected, sizeof(pixels)), 0);
+        }
+    }
+}
+
+TEST(stackblur_keeps_alpha_and_stays_premultiplied)
+{
+    Graphic::Color original[BLUR_TEST_PIXELS];
+    fill_blur_pixels(original, 1);
+
+    Graphic::Color pixels[BLUR_TEST_PIXELS];
+    memcpy(pixels, original, sizeof(pixels));
+    blur(pixels, 16, {BLUR_TEST_WIDTH, BLUR_TEST_HEIGHT}, Graphic::SpanIsa::AVX2);
+
+    for (int i = 0; i < BLUR_TEST_PIXELS; i++)
+    {
+        Assert::equal(pixels[i].alpha(), original[i].alpha());
+        Assert::lower_equal(pixels[i].red(), pixels[i].alpha());
+        Assert::lower_equal(pixels[i].green(), pixels[i].alpha());
+        Assert::lower_equal(pixels[i].blue(), pixels[i].alpha());
+    }
+}
+
+TEST(stackblur_leaves_flat_colors_alone)
+{
+    auto color = Graphic::Color::from_rgb_byte(12, 34, 56);
+
+    for (unsigned radius : {0u, 1u, 16u, 254u, 1000u})
+    {
+        Graphic::Color pixels[BLUR_TEST_PIXELS];
+
+        for (int i = 0; i < BLUR_TEST_PIXELS; i++)
+        {
+            pixels[i] = color;
+        }
+
+        blur(pixels, radius, {BLUR_TEST_WIDTH, BLUR_TEST_HEIGHT}, Graphic::SpanIsa::AVX2);
+
+        for (int i = 0; i < BLUR_TEST_PIXELS; i++)
+        {
+            Assert::lower_equal(abs(pixels[i].red() - color.red()), 1);
+            Assert::lower_equal(abs(pixels[i].green() - color.green()), 1);
+            Assert::lower_equal(abs(pixels[i].blue() - color.blue()), 1);
+        }
+    }
+}
+
+TEST(effect_cache_restores_only_the_same_key)
+{
+    Graphic::Color pixels[BLUR_TEST_PIXELS];
+    fill_blur_pixels(pixels, 2);
+
+    auto bitmap = Graphic::Bitmap::create_static(BLUR_TEST_WIDTH, BLUR_TEST_HEIGHT, pixels);
+
+    Math::Recti bound{3, 4, 20, 10};
+    Graphic::Acrylic acrylic;
+    Graphic::EffectCache cache;
+
+    uint32_t source = Graphic::EffectCache::fingerprint(*bitmap, bound);
+
+    Assert::is_false(cache.restore(*bitmap, source, bound, acrylic));
+
+    cache.store(*bitmap, source, bound, acrylic);
+
+    Graphic::Color expected[BLUR_TEST_PIXELS];
+    memcpy(expected, pixels, sizeof(pixels));
+
+    // Anything drawn under the effect changes the key.
+    pixels[(bound.y() + 3) * BLUR_TEST_WIDTH + bound.x() + 5] = Graphic::Colors::RED;
+    Assert::not_equal(Graphic::EffectCache::fingerprint(*bitmap, bound), source);
+
+    fill_blur_pixels(pixels, 3);
+
+    Assert::is_false(cache.restore(*bitmap, source + 1, bound, acrylic));
+    Assert::is_false(cache.restore(*bitmap, source, bound.offset({1, 0}), acrylic));
+    Assert::is_false(cache.restore(*bitmap, source, bound, {0.25, 8, 0.05}));
+
+    Assert::is_true(cache.restore(*bitmap, source, bound, acrylic));
+
+    for (int y = bound.top(); y < bound.bottom(); y++)
+    {
+        for (int x = bound.left(); x < bound.right(); x++)
+        {
+            auto pixel = pixels[y * BLUR_TEST_WIDTH + x];
+            auto expected_pixel = expected[y * BLUR_TEST_WIDTH + x];
+
+            Assert::equal(memcmp(&pixel, &expected_pixel, sizeof(pixel)), 0);
+        }
+    }
+
+    cache.invalidate();
+    Assert::is_false(cache.restore(*bitmap, source, bound, acrylic));
+}
@@ -0,0 +1,43 @@
+#include <libio/Directory.h>
+#include <libio/File.h>
+#include <libio/Format.h>
+#include <libsystem/io/Filesystem.h>
+
+#include "tests/Driver.h"
+
+// IO::format has no zero padding, and the entries come back sorted by name.
+static String directory_test_name(size_t i)
+{
+    return IO::format("{}{}{}", i / 100 % 10, i / 10 % 10, i % 10);
+}
+
+TEST(directory_list_more_entries_than_a_single_batch)
+{
+    static constexpr auto DIRECTORY_PATH = "/User/test-directory-list";
+    static constexpr size_t ENTRY_COUNT = 100;
+
+    filesystem_mkdir(DIRECTORY_PATH);
+
+    for (size_t i = 0; i < ENTRY_COUNT; i++)
+    {
+        auto path = IO::format("{}/{}", DIRECTORY_PATH, directory_test_name(i));
+        IO::File file{path, OPEN_WRITE | OPEN_CREATE};
+    }
+
+    IO::Directory directory{DIRECTORY_PATH};
+
+    Assert::equal(directory.entries().count(), ENTRY_COUNT);
+
+    for (size_t i = 0; i < ENTRY_COUNT; i++)
+    {
+        Assert::equal(directory.entries()[i].name, directory_test_name(i));
+        Assert::equal(directory.entries()[i].stat.type, FILE_TYPE_REGULAR);
+    }
+
+    for (size_t i = 0; i < ENTRY_COUNT; i++)
+    {
+        filesystem_unlink(IO::format("{}/{}", DIRECTORY_PATH, directory_test_name(i)).cstring());
+    }
+
+    filesystem_unlink(DIRECTORY_PATH);
+}
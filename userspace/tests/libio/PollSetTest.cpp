@@ -0,0 +1,27 @@
+#include <abi/Syscalls.h>
+#include <libio/Pipe.h>
+
+#include "tests/Driver.h"
+
+TEST(closing_a_polled_pipe_end_hangs_up_the_other_end)
+{
+    auto pipe = IO::Pipe::create().unwrap();
+
+    int pollset = HANDLE_INVALID_ID;
+    Assert::equal(hj_create_pollset(&pollset), SUCCESS);
+    Assert::equal(hj_pollset_control(pollset, POLLSET_ADD, pipe.writer->id(), POLL_WRITE), SUCCESS);
+
+    // The set must not keep the writer alive once it is closed.
+    pipe.writer = nullptr;
+
+    HandlePoll poll{pipe.reader->id(), POLL_READ, 0};
+    Assert::equal(hj_handle_poll(&poll, 1, 0), SUCCESS);
+    Assert::equal(poll.result, POLL_READ);
+
+    // Nothing will ever come, the read ends instead of blocking.
+    uint8_t byte = 0;
+    auto read = pipe.reader->read(&byte, sizeof(byte));
+    Assert::is_true(!read.success() || read.unwrap() == 0);
+
+    hj_handle_close(pollset);
+}
@@ -0,0 +1,73 @@
+#include <libio/Copy.h>
+#include <libio/File.h>
+#include <libsystem/io/Filesystem.h>
+
+#include "tests/Driver.h"
+
+static constexpr auto SPLICE_SOURCE_PATH = "/User/test-splice-source";
+static constexpr auto SPLICE_DESTINATION_PATH = "/User/test-splice-destination";
+
+static void fill_source(size_t size)
+{
+    IO::File source{SPLICE_SOURCE_PATH, OPEN_WRITE | OPEN_CREATE};
+
+    for (size_t i = 0; i < size; i++)
+    {
+        uint8_t byte = i * 7;
+        source.write(&byte, sizeof(byte));
+    }
+}
+
+static void check_destination(size_t size)
+{
+    IO::File destination{SPLICE_DESTINATION_PATH, OPEN_READ};
+
+    Assert::equal(destination.length().unwrap(), size);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        uint8_t byte = 0;
+        destination.read(&byte, sizeof(byte));
+        Assert::equal(byte, (uint8_t)(i * 7));
+    }
+}
+
+TEST(copy_between_files_is_spliced_by_the_kernel)
+{
+    static constexpr size_t SIZE = 70000;
+
+    fill_source(SIZE);
+
+    {
+        IO::File source{SPLICE_SOURCE_PATH, OPEN_READ};
+        IO::File destination{SPLICE_DESTINATION_PATH, OPEN_WRITE | OPEN_CREATE};
+
+        Assert::equal(IO::copy(source, destination), SUCCESS);
+    }
+
+    check_destination(SIZE);
+
+    filesystem_unlink(SPLICE_SOURCE_PATH);
+    filesystem_unlink(SPLICE_DESTINATION_PATH);
+}
+
+TEST(copy_between_files_stops_after_n_bytes)
+{
+    static constexpr size_t SIZE = 20000;
+    static constexpr size_t COPIED = 12345;
+
+    fill_source(SIZE);
+
+    {
+        IO::File source{SPLICE_SOURCE_PATH, OPEN_READ};
+        IO::File destination{SPLICE_DESTINATION_PATH, OPEN_WRITE | OPEN_CREATE};
+
+        Assert::equal(IO::copy(source, destination, COPIED), SUCCESS);
+        Assert::equal(source.tell().unwrap(), COPIED);
+    }
+
+    check_destination(COPIED);
+
+    filesystem_unlink(SPLICE_SOURCE_PATH);
+    filesystem_unlink(SPLICE_DESTINATION_PATH);
+}
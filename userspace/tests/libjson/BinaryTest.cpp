@@ -0,0 +1,126 @@
+#include <libjson/Binary.h>
+#include <libjson/Json.h>
+
+#include "tests/Driver.h"
+
+static Json::Value sample_theme()
+{
+    Json::Value::Object color;
+    color["red"] = (int64_t)12;
+    color["green"] = (int64_t)-34;
+    color["blue"] = (int64_t)255;
+
+    Json::Value::Array colors;
+    colors.push_back(color);
+    colors.push_back(color);
+
+    Json::Value::Object theme;
+    theme["name"] = "Skift Dark";
+    theme["opacity"] = 0.75;
+    theme["enabled"] = true;
+    theme["wallpaper"] = nullptr;
+    theme["colors"] = move(colors);
+
+    return move(theme);
+}
+
+TEST(json_binary_round_trips_every_type)
+{
+    auto value = sample_theme();
+
+    Json::BinaryWriter writer;
+    writer.write(value);
+
+    auto decoded = Json::decode_binary(writer.data(), writer.size()).unwrap();
+
+    Assert::is_true(decoded.is(Json::OBJECT));
+    Assert::equal(decoded.get("name").as_string(), String{"Skift Dark"});
+    Assert::is_true(decoded.get("opacity").as_double() == 0.75);
+    Assert::is_true(decoded.get("enabled").is(Json::TRUE));
+    Assert::is_true(decoded.get("wallpaper").is(Json::NIL));
+
+    auto &colors = decoded.get("colors");
+    Assert::equal(colors.length(), 2);
+    Assert::equal(colors.get(1).get("green").as_integer(), -34);
+    Assert::equal(colors.get(1).get("blue").as_integer(), 255);
+}
+
+TEST(json_binary_interns_repeated_keys)
+{
+    Json::Value::Array array;
+
+    for (int i = 0; i < 16; i++)
+    {
+        Json::Value::Object object;
+        object["a_rather_long_key"] = (int64_t)i;
+        array.push_back(move(object));
+    }
+
+    Json::BinaryWriter writer;
+    writer.write(Json::Value{move(array)});
+
+    // The key is only written once, every other object refers to it with a
+    // single byte.
+    Assert::lower_than(writer.size(), 16 * 6 + 20);
+
+    auto decoded = Json::decode_binary(writer.data(), writer.size()).unwrap();
+    Assert::equal(decoded.get(15).get("a_rather_long_key").as_integer(), 15);
+}
+
+TEST(json_binary_is_smaller_than_text)
+{
+    auto value = sample_theme();
+
+    Prettifier pretty;
+    Json::prettify(pretty, value);
+    auto text = pretty.finalize();
+
+    Json::BinaryWriter writer;
+    writer.write(value);
+
+    Assert::lower_than(writer.size(), text.length());
+}
+
+TEST(json_binary_rejects_malformed_input)
+{
+    auto value = sample_theme();
+
+    Json::BinaryWriter writer;
+    writer.write(value);
+
+    // Every truncation must fail cleanly instead of reading past the end.
+    for (size_t size = 0; size < writer.size(); size++)
+    {
+        Assert::is_false(Json::decode_binary(writer.data(), size).success());
+    }
+
+    const uint8_t unknown_tag[] = {0xff};
+    Assert::is_false(Json::decode_binary(unknown_tag, sizeof(unknown_tag)).success());
+
+    // An object referring to a key that was never written.
+    const uint8_t unknown_key[] = {Json::BINARY_OBJECT, 1, 5, Json::BINARY_NIL};
+    Assert::is_false(Json::decode_binary(unknown_key, sizeof(unknown_key)).success());
+
+    // Claims more elements than there are bytes left.
+    const uint8_t huge_array[] = {Json::BINARY_ARRAY, 0xff, 0xff, 0xff, 0xff, 0x0f};
+    Assert::is_false(Json::decode_binary(huge_array, sizeof(huge_array)).success());
+}
+
+TEST(json_binary_encode_decode_many_messages)
+{
+    auto value = sample_theme();
+
+    Json::BinaryWriter writer;
+
+    // Same shape as the settings service answering a burst of reads, the
+    // writer is reused between messages.
+    for (int i = 0; i < 1000; i++)
+    {
+        writer.clear();
+        writer.write(value);
+
+        auto decoded = Json::decode_binary(writer.data(), writer.size());
+        Assert::is_true(decoded.success());
+        Assert::equal(decoded.unwrap().length(), value.length());
+    }
+}
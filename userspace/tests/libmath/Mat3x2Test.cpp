@@ -0,0 +1,18 @@
+#include <libmath/Mat3x2.h>
+
+#include "tests/Driver.h"
+
+TEST(math_mat3x2_multiply_applies_left_then_right)
+{
+    auto scale_then_move = Math::Mat3x2f::scale(2) * Math::Mat3x2f::translation({3, 5});
+    auto point = scale_then_move.apply(Math::Vec2f{1, 1});
+
+    Assert::equal(point.x(), 5.0f);
+    Assert::equal(point.y(), 7.0f);
+
+    auto move_then_scale = Math::Mat3x2f::translation({3, 5}) * Math::Mat3x2f::scale(2);
+    point = move_then_scale.apply(Math::Vec2f{1, 1});
+
+    Assert::equal(point.x(), 8.0f);
+    Assert::equal(point.y(), 12.0f);
+}
@@ -0,0 +1,142 @@
+#include <libmath/Region.h>
+
+#include "tests/Driver.h"
+
+static constexpr int REGION_TEST_SIZE = 32;
+
+using RegionTestMask = bool[REGION_TEST_SIZE][REGION_TEST_SIZE];
+
+static void rasterize(const Math::Regioni &region, RegionTestMask &mask)
+{
+    for (int y = 0; y < REGION_TEST_SIZE; y++)
+    {
+        for (int x = 0; x < REGION_TEST_SIZE; x++)
+        {
+            mask[y][x] = region.contains({x, y});
+        }
+    }
+}
+
+// Checks the invariants of the banded representation.
+static void assert_banded(const Math::Regioni &region)
+{
+    auto &rects = region.rects();
+
+    for (size_t i = 0; i < rects.count(); i++)
+    {
+        Assert::is_false(rects[i].is_empty());
+
+        if (i == 0)
+        {
+            continue;
+        }
+
+        auto &previous = rects[i - 1];
+        auto &current = rects[i];
+
+        if (previous.top() == current.top())
+        {
+            Assert::equal(previous.bottom(), current.bottom());
+            Assert::lower_than(previous.right(), current.left());
+        }
+        else
+        {
+            Assert::lower_equal(previous.bottom(), current.top());
+        }
+    }
+}
+
+static uint32_t next_random(uint32_t &state)
+{
+    state = state * 1664525 + 1013904223;
+    return state >> 8;
+}
+
+static Math::Recti random_rect(uint32_t &state)
+{
+    int x = next_random(state) % REGION_TEST_SIZE;
+    int y = next_random(state) % REGION_TEST_SIZE;
+    int width = next_random(state) % (REGION_TEST_SIZE - x) + 1;
+    int height = next_random(state) % (REGION_TEST_SIZE - y) + 1;
+
+    return {x, y, width, height};
+}
+
+TEST(math_region_operations_match_pixels)
+{
+    uint32_t state = 42;
+
+    for (int round = 0; round < 200; round++)
+    {
+        Math::Regioni a;
+        Math::Regioni b;
+
+        for (int i = 0; i < 4; i++)
+        {
+            a.add(random_rect(state));
+            b.add(random_rect(state));
+        }
+
+        RegionTestMask a_mask;
+        RegionTestMask b_mask;
+        rasterize(a, a_mask);
+        rasterize(b, b_mask);
+
+        auto merged = a.merged_with(b);
+        auto clipped = a.clipped_with(b);
+        auto removed = a.without(b);
+
+        assert_banded(merged);
+        assert_banded(clipped);
+        assert_banded(removed);
+
+        RegionTestMask merged_mask;
+        RegionTestMask clipped_mask;
+        RegionTestMask removed_mask;
+        rasterize(merged, merged_mask);
+        rasterize(clipped, clipped_mask);
+        rasterize(removed, removed_mask);
+
+        for (int y = 0; y < REGION_TEST_SIZE; y++)
+        {
+            for (int x = 0; x < REGION_TEST_SIZE; x++)
+            {
+                Assert::equal(merged_mask[y][x], a_mask[y][x] || b_mask[y][x]);
+                Assert::equal(clipped_mask[y][x], a_mask[y][x] && b_mask[y][x]);
+                Assert::equal(removed_mask[y][x], a_mask[y][x] && !b_mask[y][x]);
+            }
+        }
+    }
+}
+
+TEST(math_region_coalesces_bands)
+{
+    Math::Regioni region;
+
+    region.add(Math::Recti{0, 0, 10, 5});
+    region.add(Math::Recti{0, 5, 10, 5});
+
+    Assert::equal(region.count(), 1);
+    Assert::equal(region.bound().height(), 10);
+
+    // Punching a hole and filling it again gives back a single rectangle.
+    region.remove(Math::Recti{2, 2, 4, 4});
+    Assert::equal(region.count(), 4);
+
+    region.add(Math::Recti{2, 2, 4, 4});
+    Assert::equal(region.count(), 1);
+}
+
+TEST(math_region_stays_small_when_overlapping)
+{
+    Math::Regioni region;
+
+    // The same damage reported again and again shouldn't split anything.
+    for (int i = 0; i < 100; i++)
+    {
+        region.add(Math::Recti{10, 10, 100, 100});
+        region.add(Math::Recti{50, 50, 100, 100});
+    }
+
+    Assert::equal(region.count(), 3);
+}
@@ -0,0 +1,41 @@
+#include <libutils/RingBuffer.h>
+
+#include "tests/Driver.h"
+
+TEST(ring_buffer_read_and_write_across_the_end)
+{
+    RingBuffer<char> ring{8};
+
+    Assert::equal(ring.write("abcdef", 6), 6);
+
+    char buffer[8] = {};
+    Assert::equal(ring.read(buffer, 4), 4);
+    Assert::equal(memcmp(buffer, "abcd", 4), 0);
+
+    // The head wraps around the end of the storage.
+    Assert::equal(ring.write("ghijklmn", 8), 6);
+    Assert::is_true(ring.full());
+
+    Assert::equal(ring.read(buffer, 8), 8);
+    Assert::equal(memcmp(buffer, "efghijkl", 8), 0);
+    Assert::is_true(ring.empty());
+}
+
+TEST(ring_buffer_resize_keeps_the_content)
+{
+    RingBuffer<char> ring{4};
+
+    ring.write("abcd", 4);
+
+    char buffer[8] = {};
+    ring.read(buffer, 2);
+    ring.write("ef", 2);
+
+    Assert::is_false(ring.resize(2));
+    Assert::is_true(ring.resize(8));
+    Assert::equal(ring.capacity(), 8);
+
+    Assert::equal(ring.write("ghij", 4), 4);
+    Assert::equal(ring.read(buffer, 8), 8);
+    Assert::equal(memcmp(buffer, "cdefghij", 8), 0);
+}
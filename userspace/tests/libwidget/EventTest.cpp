@@ -0,0 +1,50 @@
+#include <libwidget/Event.h>
+
+#include "tests/Driver.h"
+
+static Widget::Event mouse_event(Widget::EventType type, Math::Vec2i old_position, Math::Vec2i position, int scroll = 0)
+{
+    Widget::Event event = {};
+    event.type = type;
+    event.mouse.scroll = scroll;
+    event.mouse.old_position = old_position;
+    event.mouse.position = position;
+    event.mouse.old_position_on_screen = old_position;
+    event.mouse.position_on_screen = position;
+    return event;
+}
+
+TEST(event_coalesce_merges_consecutive_mouse_moves)
+{
+    auto first = mouse_event(Widget::Event::MOUSE_MOVE, {0, 0}, {4, 2});
+    auto second = mouse_event(Widget::Event::MOUSE_MOVE, {4, 2}, {9, 7});
+
+    Assert::is_true(Widget::event_coalesce(first, second));
+    Assert::equal(first.mouse.old_position, Math::Vec2i{0, 0});
+    Assert::equal(first.mouse.position, Math::Vec2i{9, 7});
+    Assert::equal(first.mouse.position_on_screen, Math::Vec2i{9, 7});
+}
+
+TEST(event_coalesce_sums_scrolls_at_the_same_position)
+{
+    auto first = mouse_event(Widget::Event::MOUSE_SCROLL, {3, 3}, {3, 3}, 1);
+    auto second = mouse_event(Widget::Event::MOUSE_SCROLL, {3, 3}, {3, 3}, 2);
+    auto elsewhere = mouse_event(Widget::Event::MOUSE_SCROLL, {5, 3}, {5, 3}, 1);
+
+    Assert::is_true(Widget::event_coalesce(first, second));
+    Assert::equal(first.mouse.scroll, 3);
+    Assert::is_false(Widget::event_coalesce(first, elsewhere));
+}
+
+TEST(event_coalesce_keeps_moves_with_different_buttons)
+{
+    auto move = mouse_event(Widget::Event::MOUSE_MOVE, {0, 0}, {1, 1});
+    auto drag = mouse_event(Widget::Event::MOUSE_MOVE, {1, 1}, {2, 2});
+    drag.mouse.buttons = MOUSE_BUTTON_LEFT;
+
+    auto press = mouse_event(Widget::Event::MOUSE_BUTTON_PRESS, {1, 1}, {1, 1});
+
+    Assert::is_false(Widget::event_coalesce(move, drag));
+    Assert::is_false(Widget::event_coalesce(move, press));
+    Assert::equal(move.mouse.position, Math::Vec2i{1, 1});
+}
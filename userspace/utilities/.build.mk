@@ -143,7 +143,7 @@ PWD_NAME = pwd
 PIANO_LIBS = system io
 PIANO_NAME = piano
 
-DISPLAYCTL_LIBS = system io
+DISPLAYCTL_LIBS = async system io
 DISPLAYCTL_NAME = displayctl
 
 KEYBOARDCTL_LIBS = system io
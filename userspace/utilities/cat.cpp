@@ -8,7 +8,7 @@
 
 static bool option_linenumbers = false;
 
-Result cat(IO::Reader &reader)
+Result cat(IO::RawReader auto &reader)
 {
     if (option_linenumbers)
     {
@@ -5,6 +5,7 @@
 #include <libio/Format.h>
 #include <libio/Socket.h>
 #include <libio/Streams.h>
+#include <libipc/Channel.h>
 
 #include "compositor/Protocol.h"
 
@@ -69,6 +70,9 @@ Result gfxmode_set_compositor(IOCallDisplayModeArgs mode)
 {
     auto connection = TRY(IO::Socket::connect("/Session/compositor.ipc"));
 
+    // The compositor expects the handshake of a channel before any message.
+    IPC::Channel channel{connection, false};
+
     CompositorMessage message{
         .type = COMPOSITOR_MESSAGE_SET_RESOLUTION,
         .set_resolution = {
@@ -77,7 +81,7 @@ Result gfxmode_set_compositor(IOCallDisplayModeArgs mode)
         },
     };
 
-    TRY(connection.write(&message, sizeof(message)));
+    TRY(CompositorSchema::write(channel, message));
 
     process_sleep(1000);
 
@@ -86,7 +90,7 @@ Result gfxmode_set_compositor(IOCallDisplayModeArgs mode)
         .greetings = {},
     };
 
-    TRY(connection.write(&goodbye_message, sizeof(goodbye_message)));
+    TRY(CompositorSchema::write(channel, goodbye_message));
 
     return Result::SUCCESS;
 }